@@ -17,6 +17,7 @@
  */
 #include <QApplication>
 #include <QTranslator>
+#include <QCommandLineParser>
 
 #ifdef __APPLE__
 #include <libgen.h>
@@ -51,7 +52,41 @@ int main(int argc, char *argv[])
         MSG_INFO("Using translation for language " << translator.language().toStdString());
     }
 
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Editor for touch panel surfaces");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption exportOption("export-pages", QCoreApplication::translate("main", "Export all pages of <file> as PNG images into <directory> and exit."), "directory");
+    parser.addOption(exportOption);
+    QCommandLineOption checkOption("check-rendering", QCoreApplication::translate("main", "Draw all objects of <file> and compare them with the reference images in <directory>."), "directory");
+    parser.addOption(checkOption);
+    QCommandLineOption outputOption("output", QCoreApplication::translate("main", "The directory the report and the diff images of --check-rendering are written to."), "directory", "render-check");
+    parser.addOption(outputOption);
+    QCommandLineOption toleranceOption("tolerance", QCoreApplication::translate("main", "The maximum difference of a color channel for --check-rendering."), "value", "0");
+    parser.addOption(toleranceOption);
+    QCommandLineOption updateOption("update-references", QCoreApplication::translate("main", "Write the reference images for --check-rendering new. Without it a missing reference fails the check."));
+    parser.addOption(updateOption);
+    parser.addPositionalArgument("file", QCoreApplication::translate("main", "The project file."));
+    parser.process(app);
+
     TSurface w;
+
+    if (parser.isSet(exportOption) || parser.isSet(checkOption))
+    {
+        if (parser.positionalArguments().isEmpty())
+        {
+            MSG_ERROR("Missing the project file!");
+            return 1;
+        }
+
+        QString file = parser.positionalArguments().at(0);
+
+        if (parser.isSet(checkOption))
+            return w.checkRendering(file, parser.value(checkOption), parser.value(outputOption), parser.value(toleranceOption).toInt(), parser.isSet(updateOption)) ? 0 : 1;
+
+        return w.exportPageImages(file, parser.value(exportOption)) ? 0 : 1;
+    }
+
     w.show();
 
     return app.exec();
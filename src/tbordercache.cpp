@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include "tbordercache.h"
+#include "tconfig.h"
+#include "terror.h"
+
+TBorderCache::TBorderCache()
+    : TCostCache("Border cache", "frames", TConfig::Current().getBorderCacheSize())
+{
+    DECL_TRACER("TBorderCache::TBorderCache()");
+}
+
+TBorderCache& TBorderCache::Current()
+{
+//    DECL_TRACER("TBorderCache::Current()");
+
+    // The frames are pixmaps, which must not be destroyed after the
+    // application. Therefore the cache is never deleted.
+    static TBorderCache *cache = new TBorderCache;
+    return *cache;
+}
+
+/**
+ * @brief TBorderCache::makeKey
+ * Creates the key of a frame. A frame is unique by the border name, the
+ * line type, the border color and the size of the button.
+ *
+ * @param name      The name of the border. This must be the name of the
+ * family member, because the members have different graphics.
+ * @param lt        The line type.
+ * @param color     The border color.
+ * @param size      The size of the button.
+ * @return The key.
+ */
+QString TBorderCache::makeKey(const QString& name, Graphics::LINE_TYPE_t lt, const QColor& color, const QSize& size)
+{
+    DECL_TRACER("TBorderCache::makeKey(const QString& name, Graphics::LINE_TYPE_t lt, const QColor& color, const QSize& size)");
+
+    return QString("%1|%2|%3|%4x%5").arg(name).arg(lt).arg(color.rgba(), 8, 16, QChar('0')).arg(size.width()).arg(size.height());
+}
+
+void TBorderCache::insert(const QString& key, const BORDER_FRAME_t& frame)
+{
+    DECL_TRACER("TBorderCache::insert(const QString& key, const BORDER_FRAME_t& frame)");
+
+    qint64 bytes = static_cast<qint64>(frame.frame.width()) * frame.frame.height() * frame.frame.depth() / 8 +
+                   static_cast<qint64>(frame.erase.width()) * frame.erase.height() * frame.erase.depth() / 8;
+    TCostCache::insert(key, frame, bytes);
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TBORDERCACHE_H
+#define TBORDERCACHE_H
+
+#include <QPixmap>
+#include <QString>
+#include <QColor>
+#include <QSize>
+
+#include "tcostcache.h"
+#include "tgraphics.h"
+
+namespace Border
+{
+    typedef struct BORDER_FRAME_t
+    {
+        QPixmap frame;          // The colorized and stretched frame
+        QPixmap erase;          // Opaque pixels are erased on the target
+        int borderWidth{0};     // The width of the border
+    }BORDER_FRAME_t;
+}
+
+/**
+ * @brief The TBorderCache class
+ * A process wide cache of finished border frames. Creating a frame means
+ * to load up to 16 images from disk, to colorize and to stretch them.
+ * Most buttons of a page share the same border, color and size. Therefore
+ * the finished frame is stored together with the mask of pixels to erase
+ * outside of the frame. A repeated draw is then only a blit of two
+ * pixmaps.
+ *
+ * The cache removes the least recently used frames if the memory budget
+ * is exceeded. The budget is read from the configuration.
+ */
+class TBorderCache : public TCostCache<Border::BORDER_FRAME_t>
+{
+    public:
+        typedef Border::BORDER_FRAME_t BORDER_FRAME_t;
+
+        static TBorderCache& Current();
+
+        static QString makeKey(const QString& name, Graphics::LINE_TYPE_t lt, const QColor& color, const QSize& size);
+        void insert(const QString& key, const BORDER_FRAME_t& frame);
+
+    private:
+        TBorderCache();
+};
+
+#endif // TBORDERCACHE_H
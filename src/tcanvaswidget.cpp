@@ -18,10 +18,14 @@
 #include <QPainter>
 #include <QPen>
 #include <QMouseEvent>
+#include <QPaintEvent>
+#include <QRubberBand>
 #include <algorithm>
 
 #include "tcanvaswidget.h"
 #include "tresizablewidget.h"
+#include "tpagehandler.h"
+#include "tobjecttable.h"
 #include "tconfig.h"
 #include "terror.h"
 
@@ -36,6 +40,7 @@ TCanvasWidget::TCanvasWidget(QWidget* parent)
     setMouseTracking(true);
     setMinimumSize(400, 300);
     mGrid = QSize(TConfig::Current().getGridSize(), TConfig::Current().getGridSize());
+    mRetained = TConfig::Current().getRetainedRendering();
 }
 
 void TCanvasWidget::setGridSize(const QSize& s)
@@ -48,6 +53,7 @@ void TCanvasWidget::setGridSize(const QSize& s)
         return;
 
     mGrid = newSize;
+    mBackgroundValid = false;
     update();
     emit gridChanged(mGrid);
 }
@@ -60,7 +66,6 @@ void TCanvasWidget::setSnapEnabled(bool on)
         return;
 
     mSnapEnabled = on;
-    update();
     emit snapChanged(mSnapEnabled);
 }
 
@@ -72,6 +77,7 @@ void TCanvasWidget::setShowGrid(bool on)
         return;
 
     mShowGrid = on;
+    mBackgroundValid = false;
     update();
 }
 
@@ -81,6 +87,7 @@ void TCanvasWidget::setLinearGradient(const QLinearGradient& grad)
 
     mGradientLinear = grad;
     mGradient = GRAD_LINEAR;
+    mBackgroundValid = false;
     update();
 }
 
@@ -90,6 +97,7 @@ void TCanvasWidget::setRadialGradient(const QRadialGradient& grad)
 
     mGradientRadial = grad;
     mGradient = GRAD_RADIAL;
+    mBackgroundValid = false;
     update();
 }
 
@@ -99,6 +107,7 @@ void TCanvasWidget::setConicGradient(const QConicalGradient& grad)
 
     mGradientConic = grad;
     mGradient = GRAD_CONIC;
+    mBackgroundValid = false;
     update();
 }
 
@@ -108,14 +117,99 @@ void TCanvasWidget::setSolidColor(const QColor& color)
 
     mSolidColor = color;
     mGradient = GRAD_NONE;
+    mBackgroundValid = false;
     update();
 }
 
-void TCanvasWidget::paintEvent(QPaintEvent*)
+/**
+ * @brief TCanvasWidget::paintEvent
+ * Paints the background and the grid. Both are drawn once into a pixmap,
+ * which is only drawn again if the size, the grid or the colors changed.
+ * In retained mode the images of all objects are painted here too, in
+ * their z-order. Only objects intersecting the damaged region are painted.
+ * They are taken from the spatial index of the page.
+ *
+ * @param e The paint event containing the region to paint.
+ */
+void TCanvasWidget::paintEvent(QPaintEvent* e)
 {
-//    DECL_TRACER("TCanvasWidget::paintEvent(QPaintEvent*)");
+//    DECL_TRACER("TCanvasWidget::paintEvent(QPaintEvent* e)");
+
+    const qreal dpr = devicePixelRatioF();
 
+    if (!mBackgroundValid || mBackground.size() != size() * dpr || mBackground.devicePixelRatio() != dpr ||
+        (mShowGrid && mBackgroundGridStyle != TConfig::Current().getGridStyle()))
+        drawBackground();
+
+    // The painter is clipped to the damaged region, so only this part of
+    // the pixmap is copied.
     QPainter p(this);
+    p.drawPixmap(0, 0, mBackground);
+
+    if (!mRetained || mScene.isEmpty())
+        return;
+
+    TObjectTable *table = mPageID > 0 ? TPageHandler::Current().getObjectTable(mPageID) : nullptr;
+
+    if (table)
+    {
+        const QList<int> objects = table->getObjectsIn(e->rect());
+
+        for (int bi : objects)
+        {
+            QHash<int, QPixmap>::ConstIterator iter = mScene.constFind(bi);
+
+            if (iter == mScene.constEnd())
+                continue;
+
+            const QRect geom = table->getRect(table->getRow(bi));
+
+            if (!e->region().intersects(geom))
+                continue;
+
+            p.save();
+            p.setClipRect(geom, Qt::IntersectClip);
+            p.drawPixmap(geom.topLeft(), iter.value());
+            p.restore();
+        }
+
+        return;
+    }
+
+    const QObjectList& list = children();
+
+    for (QObject *obj : list)
+    {
+        TResizableWidget *w = qobject_cast<TResizableWidget *>(obj);
+
+        if (!w || w->isHidden())
+            continue;
+
+        QHash<int, QPixmap>::ConstIterator iter = mScene.constFind(w->getId());
+
+        if (iter == mScene.constEnd())
+            continue;
+
+        const QRect geom = w->geometry();
+
+        if (!e->region().intersects(geom))
+            continue;
+
+        p.save();
+        p.setClipRect(geom, Qt::IntersectClip);
+        p.drawPixmap(geom.topLeft(), iter.value());
+        p.restore();
+    }
+}
+
+void TCanvasWidget::drawBackground()
+{
+    DECL_TRACER("TCanvasWidget::drawBackground()");
+
+    const qreal dpr = devicePixelRatioF();
+    mBackground = QPixmap(size() * dpr);
+    mBackground.setDevicePixelRatio(dpr);
+    QPainter p(&mBackground);
     QPalette pal = palette();
 
     switch(mGradient)
@@ -127,9 +221,18 @@ void TCanvasWidget::paintEvent(QPaintEvent*)
     }
 
     p.fillRect(rect(), pal.brush(QPalette::Base));
+    mBackgroundGridStyle = TConfig::Current().getGridStyle();
 
-    if (!mShowGrid)
-        return;
+    if (mShowGrid)
+        drawGrid(&p);
+
+    p.end();
+    mBackgroundValid = true;
+}
+
+void TCanvasWidget::drawGrid(QPainter *p)
+{
+//    DECL_TRACER("TCanvasWidget::drawGrid(QPainter *p)");
 
     QPen pen(QColor(180, 180, 180));
 
@@ -144,16 +247,16 @@ void TCanvasWidget::paintEvent(QPaintEvent*)
     }
 
     pen.setWidth(1);
-    p.setPen(pen);
+    p->setPen(pen);
 
     const int gx = qMax(1, mGrid.width());
     const int gy = qMax(1, mGrid.height());
 
     for (int x = 0; x <= width(); x += gx)
-        p.drawLine(x, 0, x, height());
+        p->drawLine(x, 0, x, height());
 
     for (int y = 0; y <= height(); y += gy)
-        p.drawLine(0, y, width(), y);
+        p->drawLine(0, y, width(), y);
 }
 
 void TCanvasWidget::mousePressEvent(QMouseEvent* e)
@@ -162,10 +265,20 @@ void TCanvasWidget::mousePressEvent(QMouseEvent* e)
 
     if (e->button() == Qt::LeftButton)
     {
-        QWidget *w = childAt(e->pos());
+        bool background = false;
+
+        // If the page is known, the spatial index of the page is asked
+        // instead of walking through all child widgets.
+        if (mPageID > 0)
+            background = TPageHandler::Current().getObjectAt(mPageID, e->pos()) <= 0;
+        else
+        {
+            QWidget *w = childAt(e->pos());
+            background = !w || !qobject_cast<TResizableWidget*>(w->parentWidget() ? w->parentWidget() : w);
+        }
+
         // Clicked background (or non-resizable): clear selection unless Ctrl is held
-        if ((!w || !qobject_cast<TResizableWidget*>(w->parentWidget() ? w->parentWidget() : w)) &&
-            !(e->modifiers() & Qt::ControlModifier))
+        if (background && !(e->modifiers() & Qt::ControlModifier))
         {
             clearSelection();
             // In this case we're calling a method to inform the owner about this event.
@@ -173,11 +286,76 @@ void TCanvasWidget::mousePressEvent(QMouseEvent* e)
             if (mSelectedTool == TOOL_DRAW)
                 emit failedClickAt(e->pos());
         }
+
+        // On the background a rubber-band selection starts
+        if (background && mSelectedTool != TOOL_DRAW && mPageID > 0)
+        {
+            if (!mRubberBand)
+                mRubberBand = new QRubberBand(QRubberBand::Rectangle, this);
+
+            mRubberOrigin = e->pos();
+            mRubberBand->setGeometry(QRect(mRubberOrigin, QSize()));
+            mRubberBand->show();
+        }
     }
 
     QWidget::mousePressEvent(e);
 }
 
+void TCanvasWidget::mouseMoveEvent(QMouseEvent* e)
+{
+//    DECL_TRACER("TCanvasWidget::mouseMoveEvent(QMouseEvent* e)");
+
+    if (mRubberBand && mRubberBand->isVisible())
+        mRubberBand->setGeometry(QRect(mRubberOrigin, e->pos()).normalized());
+
+    QWidget::mouseMoveEvent(e);
+}
+
+/**
+ * @brief TCanvasWidget::mouseReleaseEvent
+ * Finishes a rubber-band selection. All objects intersecting the frame
+ * are selected. The objects are taken from the spatial index of the page.
+ * If Ctrl is held, they are added to the current selection.
+ *
+ * @param e The mouse event.
+ */
+void TCanvasWidget::mouseReleaseEvent(QMouseEvent* e)
+{
+    DECL_TRACER("TCanvasWidget::mouseReleaseEvent(QMouseEvent* e)");
+
+    if (e->button() != Qt::LeftButton || !mRubberBand || !mRubberBand->isVisible())
+    {
+        QWidget::mouseReleaseEvent(e);
+        return;
+    }
+
+    const QRect rect = mRubberBand->geometry();
+    mRubberBand->hide();
+
+    // A simple click is no selection
+    if (rect.width() < 3 && rect.height() < 3)
+        return;
+
+    const QList<int> objects = TPageHandler::Current().getObjectsIn(mPageID, rect);
+
+    if (objects.empty())
+        return;
+
+    const QSet<int> hits(objects.constBegin(), objects.constEnd());
+
+    for (TResizableWidget *w : mResizableChildren())
+    {
+        if (hits.contains(w->getId()) && !mSelection.contains(w))
+        {
+            mSelection.insert(w);
+            w->setSelected(true);
+        }
+    }
+
+    emit selectChanged(this, true);
+}
+
 QList<TResizableWidget*> TCanvasWidget::mResizableChildren() const
 {
     DECL_TRACER("TCanvasWidget::mResizableChildren() const");
@@ -445,6 +623,7 @@ void TCanvasWidget::removeSelected()
             if (iter != mSelection.end())
                 mSelection.erase(iter);
 
+            removeObjectPixmap(w->getId());
             w->close();
         }
     }
@@ -462,5 +641,64 @@ void TCanvasWidget::removeObject(TResizableWidget *w)
     if (iter != mSelection.end())
         mSelection.erase(iter);
 
+    removeObjectPixmap(w->getId());
     w->close();
 }
+
+/**
+ * @brief TCanvasWidget::setObjectPixmap
+ * Sets the image of an object in retained mode. Only the area of the
+ * object is repainted.
+ *
+ * @param w     The widget of the object.
+ * @param pm    The image of the object.
+ */
+void TCanvasWidget::setObjectPixmap(TResizableWidget *w, const QPixmap& pm)
+{
+    DECL_TRACER("TCanvasWidget::setObjectPixmap(TResizableWidget *w, const QPixmap& pm)");
+
+    if (!w)
+        return;
+
+    mScene.insert(w->getId(), pm);
+    update(w->geometry());
+}
+
+/**
+ * @brief TCanvasWidget::objectGeometryChanged
+ * Called by an object whenever it was moved or resized. The spatial index
+ * of the page is updated at once, so hit tests and repaints see the
+ * object at its new place even while it is dragged. In retained mode
+ * only the old and the new area of the object are repainted.
+ *
+ * @param w         The widget of the object.
+ * @param oldGeom   The geometry before the change.
+ * @param newGeom   The geometry after the change.
+ */
+void TCanvasWidget::objectGeometryChanged(TResizableWidget *w, const QRect& oldGeom, const QRect& newGeom)
+{
+    DECL_TRACER("TCanvasWidget::objectGeometryChanged(TResizableWidget *w, const QRect& oldGeom, const QRect& newGeom)");
+
+    if (w && mPageID > 0)
+        TPageHandler::Current().setObjectGeometry(mPageID, w->getId(), newGeom);
+
+    if (!mRetained)
+        return;
+
+    QRegion dirty(oldGeom);
+    dirty += newGeom;
+    update(dirty);
+}
+
+void TCanvasWidget::removeObjectPixmap(int bi)
+{
+    DECL_TRACER("TCanvasWidget::removeObjectPixmap(int bi)");
+
+    if (!mScene.remove(bi))
+        return;
+
+    TResizableWidget *w = getWidget(bi);
+
+    if (w)
+        update(w->geometry());
+}
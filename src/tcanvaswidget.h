@@ -21,10 +21,14 @@
 #include <QWidget>
 #include <QSet>
 #include <QVector>
+#include <QHash>
+#include <QPixmap>
 
 #include "tmisc.h"
 
 class TResizableWidget;
+class QPainter;
+class QRubberBand;
 
 class TCanvasWidget : public QWidget
 {
@@ -73,6 +77,12 @@ class TCanvasWidget : public QWidget
         void removeSelected();
         void removeObject(TResizableWidget *w);
 
+        // Retained rendering
+        bool retained() const { return mRetained; }
+        void setObjectPixmap(TResizableWidget *w, const QPixmap& pm);
+        void removeObjectPixmap(int bi);
+        void objectGeometryChanged(TResizableWidget *w, const QRect& oldGeom, const QRect& newGeom);
+
         // Miscellaneous
         void setPageID(int id) { mPageID = id; }
         int getPageID() { return mPageID; }
@@ -86,6 +96,8 @@ class TCanvasWidget : public QWidget
     protected:
         void paintEvent(QPaintEvent*) override;
         void mousePressEvent(QMouseEvent*) override;
+        void mouseMoveEvent(QMouseEvent*) override;
+        void mouseReleaseEvent(QMouseEvent*) override;
 
     private:
         typedef enum
@@ -119,7 +131,16 @@ class TCanvasWidget : public QWidget
         QVector<MoveItem> mMoveItems;
         TResizableWidget* mMoveLead{nullptr};
         int mPageID{0};
-
+        bool mRetained{false};              // TRUE = The canvas paints the objects
+        QHash<int, QPixmap> mScene;         // The image of each object; Key is the button index
+        QPixmap mBackground;                // The background with the grid
+        bool mBackgroundValid{false};       // FALSE = mBackground must be drawn again
+        int mBackgroundGridStyle{-1};       // The grid style mBackground was drawn with
+        QRubberBand *mRubberBand{nullptr};  // The frame of a rubber-band selection
+        QPoint mRubberOrigin;               // The position the rubber-band selection started
+
+        void drawBackground();
+        void drawGrid(QPainter *p);
         QList<TResizableWidget*> mResizableChildren() const;
         static inline int mSnapCoord(int v, int step);
 };
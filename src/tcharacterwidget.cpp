@@ -20,6 +20,7 @@
 #include <QToolTip>
 
 #include "tcharacterwidget.h"
+#include "tglyphatlas.h"
 #include "terror.h"
 
 TCharacterWidget::TCharacterWidget(QWidget *parent)
@@ -29,7 +30,12 @@ TCharacterWidget::TCharacterWidget(QWidget *parent)
 
     mColumns = 16;
     mLastKey = -1;
+    mSquareSize = 24;
     setMouseTracking(true);
+
+    mAtlas = new TGlyphAtlas(this);
+    mAtlas->setFont(mDisplayFont, mSquareSize, mColumns);
+    connect(mAtlas, &TGlyphAtlas::tileReady, this, &TCharacterWidget::onTileReady);
 }
 
 void TCharacterWidget::updateFont(const QFont &font)
@@ -38,6 +44,7 @@ void TCharacterWidget::updateFont(const QFont &font)
 
     mDisplayFont = font;
     mSquareSize = qMax(24, QFontMetrics(mDisplayFont).xHeight() * 3);
+    mAtlas->setFont(mDisplayFont, mSquareSize, mColumns);
     adjustSize();
     update();
 }
@@ -49,6 +56,7 @@ void TCharacterWidget::updateSize(const QString &fontSize)
     int fsize = fontSize.toInt();
     mDisplayFont.setPointSize(fsize > 0 ? fsize : 10);
     mSquareSize = qMax(24, QFontMetrics(mDisplayFont).xHeight() * 3);
+    mAtlas->setFont(mDisplayFont, mSquareSize, mColumns);
     adjustSize();
     update();
 }
@@ -60,45 +68,70 @@ QSize TCharacterWidget::sizeHint() const
     return QSize(mColumns * mSquareSize, (65536 / mColumns) * mSquareSize);
 }
 
+/**
+ * @brief TCharacterWidget::paintEvent
+ * Copies the tiles of the glyph atlas covering the area to repaint. Tiles
+ * not rasterized yet show only the grid until the atlas delivers them.
+ * The selected character is the only one drawn directly.
+ */
 void TCharacterWidget::paintEvent(QPaintEvent *event)
 {
     QPainter painter(this);
     painter.fillRect(event->rect(), QBrush(Qt::white));
-    painter.setFont(mDisplayFont);
+    mAtlas->setDevicePixelRatio(devicePixelRatioF());
 
     QRect redrawRect = event->rect();
-    int beginRow = redrawRect.top() / mSquareSize;
-    int endRow = redrawRect.bottom() / mSquareSize;
-    int beginColumn = redrawRect.left() / mSquareSize;
-    int endColumn = redrawRect.right() / mSquareSize;
+    int tileHeight = ATLAS_TILE_ROWS * mSquareSize;
+    int beginTile = redrawRect.top() / tileHeight;
+    int endTile = redrawRect.bottom() / tileHeight;
 
-    painter.setPen(QPen(Qt::gray));
-
-    for (int row = beginRow; row <= endRow; ++row)
+    for (int tile = beginTile; tile <= endTile; ++tile)
     {
-        for (int column = beginColumn; column <= endColumn; ++column)
+        QImage img = mAtlas->getTile(tile);
+
+        if (!img.isNull())
         {
-            painter.drawRect(column*mSquareSize, row*mSquareSize, mSquareSize, mSquareSize);
+            painter.drawImage(0, tile * tileHeight, img);
+            continue;
+        }
+
+        QRect tileRect = QRect(0, tile * tileHeight, mColumns * mSquareSize, tileHeight).intersected(redrawRect);
+        int beginRow = tileRect.top() / mSquareSize;
+        int endRow = tileRect.bottom() / mSquareSize;
+        painter.setPen(QPen(Qt::gray));
+
+        for (int row = beginRow; row <= endRow; ++row)
+        {
+            for (int column = 0; column < mColumns; ++column)
+                painter.drawRect(column*mSquareSize, row*mSquareSize, mSquareSize, mSquareSize);
         }
     }
 
+    if (mLastKey < 0)
+        return;
+
+    int row = mLastKey / mColumns;
+    int column = mLastKey % mColumns;
+    QRect cell(column*mSquareSize, row*mSquareSize, mSquareSize, mSquareSize);
+
+    if (!cell.intersects(redrawRect))
+        return;
+
     QFontMetrics fontMetrics(mDisplayFont);
+    painter.setClipRect(cell);
+    painter.fillRect(column*mSquareSize + 1, row*mSquareSize + 1, mSquareSize, mSquareSize, QBrush(Qt::red));
+    painter.setFont(mDisplayFont);
     painter.setPen(QPen(Qt::black));
+    painter.drawText(column * mSquareSize + (mSquareSize / 2) - fontMetrics.boundingRect(QChar(mLastKey)).width() / 2,
+                     row * mSquareSize + 4 + fontMetrics.ascent(), QString(QChar(mLastKey)));
+}
 
-    for (int row = beginRow; row <= endRow; ++row)
-    {
-        for (int column = beginColumn; column <= endColumn; ++column)
-        {
-            int key = row*mColumns + column;
-            painter.setClipRect(column*mSquareSize, row*mSquareSize, mSquareSize, mSquareSize);
-
-            if (key == mLastKey)
-                painter.fillRect(column*mSquareSize + 1, row*mSquareSize + 1, mSquareSize, mSquareSize, QBrush(Qt::red));
+void TCharacterWidget::onTileReady(int tile)
+{
+    DECL_TRACER("TCharacterWidget::onTileReady(int tile)");
 
-            painter.drawText(column * mSquareSize + (mSquareSize / 2) - fontMetrics.boundingRect(QChar(key)).width() / 2,
-                             row * mSquareSize + 4 + fontMetrics.ascent(), QString(QChar(key)));
-        }
-    }
+    int tileHeight = ATLAS_TILE_ROWS * mSquareSize;
+    update(0, tile * tileHeight, mColumns * mSquareSize, tileHeight);
 }
 
 void TCharacterWidget::mousePressEvent(QMouseEvent *event)
@@ -106,12 +139,17 @@ void TCharacterWidget::mousePressEvent(QMouseEvent *event)
     if (event->button() == Qt::LeftButton)
     {
         QPoint pos = event->position().toPoint();
+        int lastKey = mLastKey;
         mLastKey = (pos.y() / mSquareSize) * mColumns + pos.x() / mSquareSize;
 
         if (QChar(mLastKey).category() != QChar::Mark_NonSpacing)
             emit characterSelected(QString(QChar(mLastKey)));
 
-        update();
+        // Only the cells of the old and the new selection change.
+        if (lastKey >= 0)
+            update((lastKey % mColumns) * mSquareSize, (lastKey / mColumns) * mSquareSize, mSquareSize + 1, mSquareSize + 1);
+
+        update((mLastKey % mColumns) * mSquareSize, (mLastKey / mColumns) * mSquareSize, mSquareSize + 1, mSquareSize + 1);
     }
     else
         QWidget::mousePressEvent(event);
@@ -20,6 +20,8 @@
 
 #include <QWidget>
 
+class TGlyphAtlas;
+
 class TCharacterWidget : public QWidget
 {
     Q_OBJECT
@@ -41,10 +43,13 @@ class TCharacterWidget : public QWidget
         void paintEvent(QPaintEvent *event);
 
     private:
+        void onTileReady(int tile);
+
         QFont mDisplayFont;
         int mColumns;
         int mLastKey;
         int mSquareSize;
+        TGlyphAtlas *mAtlas{nullptr};       // The rasterized cells of the font
 };
 
 #endif // TCHARACTERWIDGET_H
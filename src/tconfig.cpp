@@ -194,7 +194,18 @@ void TConfig::saveConfig()
     mSettings->setValue("CreateBackup", mCreateBackup);
     mSettings->setValue("UsePostfix", mUsePostfix);
     mSettings->setValue("RetainSelectedTool", mRetainSelectedTool);
+    mSettings->setValue("BinaryPages", mBinaryPages);
     mSettings->setValue("ImageCacheSize", mImageCacheSize);
+    mSettings->setValue("BorderCacheSize", mBorderCacheSize);
+    mSettings->setValue("GradientCacheSize", mGradientCacheSize);
+    mSettings->setValue("RenderedCacheSize", mRenderedCacheSize);
+    mSettings->setValue("TextCacheSize", mTextCacheSize);
+    mSettings->setValue("MockCacheSize", mMockCacheSize);
+    mSettings->setValue("GlyphCacheSize", mGlyphCacheSize);
+    mSettings->setValue("IconCacheSize", mIconCacheSize);
+    mSettings->setValue("DeferredRendering", mDeferredRendering);
+    mSettings->setValue("RetainedRendering", mRetainedRendering);
+    mSettings->setValue("PrivateFonts", mPrivateFonts);
     mSettings->setValue("InitialZoom", mInitialZoom);
     mSettings->setValue("VisibleSize", mVisibleSize);
     mSettings->setValue("GutterColor", mGutterColor.name(QColor::HexArgb));
@@ -259,7 +270,18 @@ bool TConfig::readConfig()
     mCreateBackup = mSettings->value("CreateBackup", true).toBool();
     mUsePostfix = mSettings->value("UsePostfix", true).toBool();
     mRetainSelectedTool = mSettings->value("RetainSelectedTool", true).toBool();
-    mImageCacheSize = mSettings->value("ImageCacheSize", 8).toInt();
+    mBinaryPages = mSettings->value("BinaryPages", false).toBool();
+    mImageCacheSize = mSettings->value("ImageCacheSize", 64).toInt();
+    mBorderCacheSize = mSettings->value("BorderCacheSize", 4).toInt();
+    mGradientCacheSize = mSettings->value("GradientCacheSize", 16).toInt();
+    mRenderedCacheSize = mSettings->value("RenderedCacheSize", 32).toInt();
+    mTextCacheSize = mSettings->value("TextCacheSize", 2).toInt();
+    mMockCacheSize = mSettings->value("MockCacheSize", 8).toInt();
+    mGlyphCacheSize = mSettings->value("GlyphCacheSize", 64).toInt();
+    mIconCacheSize = mSettings->value("IconCacheSize", 32).toInt();
+    mDeferredRendering = mSettings->value("DeferredRendering", false).toBool();
+    mRetainedRendering = mSettings->value("RetainedRendering", false).toBool();
+    mPrivateFonts = mSettings->value("PrivateFonts", true).toBool();
     mInitialZoom = mSettings->value("InitialZoom", 100).toInt();
     mVisibleSize = mSettings->value("VisibleSize", 0.0).toReal();
     mGutterColor = mSettings->value("GutterColor", QColor(qRgb(0, 0, 0)).name(QColor::HexArgb)).toString();
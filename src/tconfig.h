@@ -75,8 +75,30 @@ class TConfig
         void setUsePostfix(bool p) { mUsePostfix = p; }
         bool getRetainSelectedTool() { return mRetainSelectedTool; }
         void setRetainSelectedTool(bool t) { mRetainSelectedTool = t; }
+        bool getBinaryPages() { return mBinaryPages; }
+        void setBinaryPages(bool b) { mBinaryPages = b; }
         int getImageCacheSize() { return mImageCacheSize; }
         void setImageCacheSize(int i) { mImageCacheSize = i; }
+        int getBorderCacheSize() { return mBorderCacheSize; }
+        void setBorderCacheSize(int s) { mBorderCacheSize = s; }
+        int getGradientCacheSize() { return mGradientCacheSize; }
+        void setGradientCacheSize(int s) { mGradientCacheSize = s; }
+        int getRenderedCacheSize() { return mRenderedCacheSize; }
+        void setRenderedCacheSize(int s) { mRenderedCacheSize = s; }
+        int getTextCacheSize() { return mTextCacheSize; }
+        void setTextCacheSize(int s) { mTextCacheSize = s; }
+        int getMockCacheSize() { return mMockCacheSize; }
+        void setMockCacheSize(int s) { mMockCacheSize = s; }
+        int getGlyphCacheSize() { return mGlyphCacheSize; }
+        void setGlyphCacheSize(int s) { mGlyphCacheSize = s; }
+        int getIconCacheSize() { return mIconCacheSize; }
+        void setIconCacheSize(int s) { mIconCacheSize = s; }
+        bool getDeferredRendering() { return mDeferredRendering; }
+        void setDeferredRendering(bool d) { mDeferredRendering = d; }
+        bool getRetainedRendering() { return mRetainedRendering; }
+        void setRetainedRendering(bool r) { mRetainedRendering = r; }
+        bool getPrivateFonts() { return mPrivateFonts; }
+        void setPrivateFonts(bool p) { mPrivateFonts = p; }
 
         int getInitialZoom() { return mInitialZoom; }
         void setInitialZoom(int zoom) { mInitialZoom = zoom; }
@@ -176,7 +198,18 @@ class TConfig
         bool mCreateBackup{true};
         bool mUsePostfix{true};
         bool mRetainSelectedTool{true};
-        qsizetype mImageCacheSize{8};       // Mib
+        bool mBinaryPages{false};           // TRUE = Pages are stored as CBOR instead of JSON
+        qsizetype mImageCacheSize{64};      // Mib
+        qsizetype mBorderCacheSize{4};      // Mib; Cache of colorized border frames
+        qsizetype mGradientCacheSize{16};   // Mib; Cache of gradient fills; must hold at least one page background
+        qsizetype mRenderedCacheSize{32};   // Mib; Cache of the finished images of the objects
+        qsizetype mTextCacheSize{2};        // Mib; Cache of texts drawn with their effect
+        qsizetype mMockCacheSize{8};        // Mib; Cache of the layers of list view and sub-page mockups
+        qsizetype mGlyphCacheSize{64};      // Mib; Cache of the tiles of the character map
+        qsizetype mIconCacheSize{32};       // Mib; Cache of the icons in the resource manager
+        bool mDeferredRendering{false};     // TRUE = Objects of a page are drawn by the render queue
+        bool mRetainedRendering{false};     // TRUE = The canvas paints all objects of a page itself
+        bool mPrivateFonts{true};           // TRUE = Project fonts are loaded into the application only
         // Preferences: Appearance
         int mInitialZoom{100};              // Percent
         qreal mVisibleSize{0.0};            // Inches
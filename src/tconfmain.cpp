@@ -35,6 +35,8 @@
 #include "tmaps.h"
 #include "tconverticons.h"
 #include "tmisc.h"
+#include "tconfig.h"
+#include "tthumbnailcache.h"
 #include "terror.h"
 
 using namespace ConfigMain;
@@ -95,7 +97,7 @@ void TConfMain::createNew(const QString& file, const QString& pname, const QStri
     PAGEENTRY_t page;
     page.name = pname;
     page.pageID = 1;
-    page.file = QString("%1.json").arg(pname);
+    page.file = getPageFileName(pname);
     page.popupType = PN_PAGE;
     mConfMain->pageList.append(page);
 }
@@ -131,7 +133,7 @@ void TConfMain::addPage(const QString& name, int num)
     PAGEENTRY_t page;
     page.name = name;
     page.pageID = num;
-    page.file = QString("%1.json").arg(name);
+    page.file = getPageFileName(name);
     page.popupType = PN_PAGE;
     mConfMain->pageList.append(page);
 }
@@ -167,7 +169,7 @@ void TConfMain::addPopup(const QString& name, int num)
     PAGEENTRY_t page;
     page.name = name;
     page.pageID = num;
-    page.file = QString("%1.json").arg(name);
+    page.file = getPageFileName(name);
     page.popupType = PN_POPUP;
     mConfMain->popupList.append(page);
 }
@@ -182,15 +184,12 @@ void TConfMain::renamePage(int num, const QString& name)
     {
         if (iter->pageID == num)
         {
-            string fname = QString("%1/%2").arg(mPathTemporary).arg(iter->file).toStdString();
-            MSG_DEBUG("Renaming file \"" << iter->file.toStdString() << "\" to \"" << name.toStdString() << ".json\"");
-            MSG_DEBUG("Source: " << fname);
+            MSG_DEBUG("Renaming file \"" << iter->file.toStdString() << "\" to \"" << getPageFileName(name).toStdString() << "\"");
 
-            if (fs::exists(fname))
-                fs::remove(fname);
+            removePageFiles(iter->file);
 
             iter->name = name;
-            iter->file = QString("%1.json").arg(name);
+            iter->file = getPageFileName(name);
             break;
         }
     }
@@ -206,15 +205,12 @@ void TConfMain::renamePopup(int num, const QString& name)
     {
         if (iter->pageID == num)
         {
-            string fname = QString("%1/%2").arg(mPathTemporary).arg(iter->file).toStdString();
-            MSG_DEBUG("Renaming file \"" << iter->file.toStdString() << "\" to \"" << name.toStdString() << ".json\"");
-            MSG_DEBUG("Source: " << fname);
+            MSG_DEBUG("Renaming file \"" << iter->file.toStdString() << "\" to \"" << getPageFileName(name).toStdString() << "\"");
 
-            if (fs::exists(fname))
-                fs::remove(fname);
+            removePageFiles(iter->file);
 
             iter->name = name;
-            iter->file = QString("%1.json").arg(name);
+            iter->file = getPageFileName(name);
             break;
         }
     }
@@ -230,10 +226,8 @@ void TConfMain::deletePage(const QString& name)
     {
         if (iter->popupType == PN_PAGE && iter->name == name)
         {
-            string fname = QString("%1/%2").arg(mPathTemporary).arg(iter->file).toStdString();
-
-            if (fs::exists(fname))
-                fs::remove(fname);
+            removePageFiles(iter->file);
+            TThumbnailCache::Current().remove(iter->pageID);
 
             mConfMain->pageList.erase(iter);
             break;
@@ -251,10 +245,8 @@ void TConfMain::deletePopup(const QString& name)
     {
         if (iter->popupType == PN_POPUP && iter->name == name)
         {
-            string fname = QString("%1/%2").arg(mPathTemporary).arg(iter->file).toStdString();
-
-            if (fs::exists(fname))
-                fs::remove(fname);
+            removePageFiles(iter->file);
+            TThumbnailCache::Current().remove(iter->pageID);
 
             mConfMain->pageList.erase(iter);
             break;
@@ -262,6 +254,83 @@ void TConfMain::deletePopup(const QString& name)
     }
 }
 
+/**
+ * @brief TConfMain::setPageFile
+ * Sets the file name of a page or popup in the page list. The page
+ * handler calls this whenever it reads or writes a page, so the list
+ * always names the file actually stored in the project.
+ *
+ * @param name  The name of the page or popup.
+ * @param file  The file name without path.
+ */
+void TConfMain::setPageFile(const QString& name, const QString& file)
+{
+    DECL_TRACER("TConfMain::setPageFile(const QString& name, const QString& file)");
+
+    if (!mConfMain)
+        return;
+
+    QList<PAGEENTRY_t>::Iterator iter;
+
+    for (iter = mConfMain->pageList.begin(); iter != mConfMain->pageList.end(); ++iter)
+    {
+        if (iter->name == name)
+            iter->file = file;
+    }
+
+    for (iter = mConfMain->popupList.begin(); iter != mConfMain->popupList.end(); ++iter)
+    {
+        if (iter->name == name)
+            iter->file = file;
+    }
+}
+
+/**
+ * @brief TConfMain::getPageFileName
+ * Returns the file name a page gets when it is written with the current
+ * settings: <name>.cbor for binary pages, <name>.json otherwise.
+ *
+ * @param name  The name of the page or popup.
+ * @return The file name without path.
+ */
+QString TConfMain::getPageFileName(const QString& name)
+{
+    DECL_TRACER("TConfMain::getPageFileName(const QString& name)");
+
+    return name + (TConfig::Current().getBinaryPages() ? ".cbor" : ".json");
+}
+
+/**
+ * @brief TConfMain::removePageFiles
+ * Removes the file of a page or popup from the temporary directory. A page
+ * may be stored as JSON (<name>.json) or as binary CBOR (<name>.cbor).
+ * Both are removed, because the binary file is preferred on reading. A
+ * file left behind would be read instead of the page which gets this name
+ * later.
+ *
+ * @param file  The file name of the page as in the page list.
+ */
+void TConfMain::removePageFiles(const QString& file)
+{
+    DECL_TRACER("TConfMain::removePageFiles(const QString& file)");
+
+    QString base = file;
+
+    if (base.endsWith(".json") || base.endsWith(".cbor"))
+        base.chop(5);
+
+    const QStringList files = { base + ".json", base + ".cbor" };
+
+    for (const QString& f : files)
+    {
+        string fname = QString("%1/%2").arg(mPathTemporary, f).toStdString();
+        MSG_DEBUG("Removing page file: " << fname);
+
+        if (fs::exists(fname))
+            fs::remove(fname);
+    }
+}
+
 void TConfMain::setProjectInfo(const PROJECTINFO_t& pi)
 {
     DECL_TRACER("TConfMain::setProjectInfo(const PROJECTINFO_t& pi)");
@@ -231,6 +231,8 @@ class TConfMain
         void renamePopup(int num, const QString& name);
         void deletePage(const QString& name);
         void deletePopup(const QString& name);
+        void setPageFile(const QString& name, const QString& file);
+        static QString getPageFileName(const QString& name);
         bool readProject(const QString& path);
         void saveProject();
         void reset();
@@ -307,6 +309,7 @@ class TConfMain
         void parsePaletteList(const QDomElement &paletteList);
         void parseSubPageSet(const QDomElement& subPageSet);
         void parseDropGroups(const QDomElement& subPageSet);
+        void removePageFiles(const QString& file);
 
         static TConfMain *mCurrent;
 
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include "tcostcache.h"
+#include "terror.h"
+
+TCostCacheBase::TCostCacheBase(const QString& name)
+    : mName(name)
+{
+    DECL_TRACER("TCostCacheBase::TCostCacheBase(const QString& name)");
+
+    QMutexLocker locker(&registryMutex());
+    registry().append(this);
+}
+
+TCostCacheBase::~TCostCacheBase()
+{
+    DECL_TRACER("TCostCacheBase::~TCostCacheBase()");
+
+    QMutexLocker locker(&registryMutex());
+    registry().removeAll(this);
+}
+
+QList<TCostCacheBase *>& TCostCacheBase::registry()
+{
+    static QList<TCostCacheBase *> caches;
+    return caches;
+}
+
+QMutex& TCostCacheBase::registryMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+/**
+ * @brief TCostCacheBase::resetAll
+ * Logs the statistics of all caches and clears them. This is called when
+ * a project is closed, because the entries of the next project differ.
+ */
+void TCostCacheBase::resetAll()
+{
+    DECL_TRACER("TCostCacheBase::resetAll()");
+
+    QList<TCostCacheBase *> caches;
+
+    {
+        QMutexLocker locker(&registryMutex());
+        caches = registry();
+    }
+
+    for (TCostCacheBase *cache : caches)
+    {
+        cache->logStatistics();
+        cache->clear();
+    }
+}
+
+void TCostCacheBase::writeStatistics(qsizetype count, const QString& items, const QString& extra, qsizetype used, qsizetype budget, qsizetype hits, qsizetype misses)
+{
+    DECL_TRACER("TCostCacheBase::writeStatistics(qsizetype count, const QString& items, const QString& extra, qsizetype used, qsizetype budget, qsizetype hits, qsizetype misses)");
+
+    qsizetype total = hits + misses;
+    int rate = total ? qRound(static_cast<qreal>(hits) * 100.0 / static_cast<qreal>(total)) : 0;
+    MSG_INFO(mName.toStdString() << ": " << count << " " << items.toStdString() << ", " << (extra.isEmpty() ? "" : extra.toStdString() + ", ")
+             << used << " of " << budget << " KiB used, " << hits << " hits, " << misses << " misses (" << rate << "%)");
+}
@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TCOSTCACHE_H
+#define TCOSTCACHE_H
+
+#include <QCache>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QMutex>
+#include <QMutexLocker>
+
+/**
+ * @brief The TCostCacheBase class
+ * The part of a cost cache which doesn't depend on the type of the
+ * entries. Every cache registers itself at construction. This way all
+ * caches can be cleared at once when a project is closed, without
+ * knowing which of them were created.
+ */
+class TCostCacheBase
+{
+    public:
+        TCostCacheBase(const QString& name);
+        virtual ~TCostCacheBase();
+
+        const QString& getName() const { return mName; }
+        virtual void setBudget(qsizetype mib) = 0;
+        virtual void clear() = 0;
+        virtual void logStatistics() = 0;
+
+        static void resetAll();
+
+    protected:
+        void writeStatistics(qsizetype count, const QString& items, const QString& extra, qsizetype used, qsizetype budget, qsizetype hits, qsizetype misses);
+
+    private:
+        static QList<TCostCacheBase *>& registry();
+        static QMutex& registryMutex();
+
+        QString mName;
+};
+
+/**
+ * @brief The TCostCache class
+ * A thread safe cache of entries of type T with a memory budget. The cost
+ * of an entry is its size in KiB. If the budget is exceeded, the least
+ * recently used entries are removed. An entry larger than the whole
+ * budget is not stored.
+ *
+ * The caches of the program derive from this class and add the methods
+ * to create their keys and entries.
+ */
+template<typename T>
+class TCostCache : public TCostCacheBase
+{
+    public:
+        /**
+         * @brief TCostCache
+         * @param name  The name of the cache used in the statistics.
+         * @param items The name of the entries used in the statistics.
+         * @param mib   The budget in MiB.
+         */
+        TCostCache(const QString& name, const QString& items, qsizetype mib)
+            : TCostCacheBase(name),
+              mItems(items)
+        {
+            setBudget(mib);
+        }
+
+        /**
+         * @brief get
+         * Searches for an entry. If it was found it becomes the most
+         * recently used one.
+         *
+         * @param key   The key of the entry.
+         * @param value A pointer receiving the entry. May be nullptr.
+         * @return TRUE if the entry was found.
+         */
+        bool get(const QString& key, T *value)
+        {
+            QMutexLocker locker(&mMutex);
+            T *entry = mCache.object(key);
+
+            if (!entry)
+            {
+                mMisses++;
+                return false;
+            }
+
+            mHits++;
+
+            if (value)
+                *value = *entry;
+
+            return true;
+        }
+
+        /**
+         * @brief insert
+         * Stores an entry. An entry with the same key is replaced.
+         *
+         * @param key   The key of the entry.
+         * @param value The entry.
+         * @param bytes The memory used by the entry in bytes.
+         */
+        void insert(const QString& key, const T& value, qint64 bytes)
+        {
+            QMutexLocker locker(&mMutex);
+            // QCache takes the ownership. If the entry is larger than the
+            // whole budget, it is deleted immediately.
+            mCache.insert(key, new T(value), static_cast<qsizetype>(qMax<qint64>(1, bytes / 1024)));
+        }
+
+        /**
+         * @brief contains
+         * Tests whether an entry exists without counting a hit or a miss
+         * and without changing the order of the entries.
+         */
+        bool contains(const QString& key) const
+        {
+            QMutexLocker locker(&mMutex);
+            return mCache.contains(key);
+        }
+
+        void remove(const QString& key)
+        {
+            QMutexLocker locker(&mMutex);
+            mCache.remove(key);
+        }
+
+        /**
+         * @brief removeIf
+         * Removes all entries whose key starts with @b prefix.
+         */
+        void removeIf(const QString& prefix)
+        {
+            QMutexLocker locker(&mMutex);
+            const QList<QString> keys = mCache.keys();
+
+            for (const QString& key : keys)
+            {
+                if (key.startsWith(prefix))
+                    mCache.remove(key);
+            }
+        }
+
+        /**
+         * @brief setBudget
+         * Sets the maximum memory the cache may use. If the cache currently
+         * uses more, the least recently used entries are removed.
+         *
+         * @param mib   The budget in MiB.
+         */
+        void setBudget(qsizetype mib) override
+        {
+            QMutexLocker locker(&mMutex);
+            mBudget = qMax<qsizetype>(0, mib) * 1024;
+            mCache.setMaxCost(qMax<qsizetype>(0, mBudget - mReserved / 1024));
+        }
+
+        void clear() override
+        {
+            QMutexLocker locker(&mMutex);
+            mCache.clear();
+            mHits = 0;
+            mMisses = 0;
+        }
+
+        void logStatistics() override { logStatistics(QString()); }
+
+        /**
+         * @brief logStatistics
+         * Logs the usage of the cache.
+         *
+         * @param extra Additional information of a derived class, e.g.
+         * "3 pinned". May be empty.
+         */
+        void logStatistics(const QString& extra)
+        {
+            QMutexLocker locker(&mMutex);
+            writeStatistics(mCache.count(), mItems, extra, mCache.totalCost() + mReserved / 1024, mBudget, mHits, mMisses);
+        }
+
+        qsizetype getHits() const { QMutexLocker locker(&mMutex); return mHits; }
+        qsizetype getMisses() const { QMutexLocker locker(&mMutex); return mMisses; }
+
+        qreal getHitRate() const
+        {
+            QMutexLocker locker(&mMutex);
+            qsizetype total = mHits + mMisses;
+            return total ? static_cast<qreal>(mHits) / static_cast<qreal>(total) : 0.0;
+        }
+
+    protected:
+        /**
+         * @brief addHit
+         * Counts a hit of an entry the derived class found somewhere else.
+         */
+        void addHit() { QMutexLocker locker(&mMutex); mHits++; }
+
+        /**
+         * @brief reserve
+         * Takes memory from the budget for entries the derived class keeps
+         * outside of the cache. The cache shrinks by the same amount.
+         *
+         * @param bytes The memory in bytes.
+         * @return FALSE if the reserved memory would exceed the budget. In
+         * this case nothing is reserved.
+         */
+        bool reserve(qint64 bytes)
+        {
+            QMutexLocker locker(&mMutex);
+
+            if ((mReserved + bytes) / 1024 > mBudget)
+                return false;
+
+            mReserved += bytes;
+            mCache.setMaxCost(qMax<qsizetype>(0, mBudget - mReserved / 1024));
+            return true;
+        }
+
+        /**
+         * @brief release
+         * Gives memory taken with reserve() back to the cache.
+         *
+         * @param bytes The memory in bytes.
+         */
+        void release(qint64 bytes)
+        {
+            QMutexLocker locker(&mMutex);
+            mReserved = qMax<qint64>(0, mReserved - bytes);
+            mCache.setMaxCost(qMax<qsizetype>(0, mBudget - mReserved / 1024));
+        }
+
+    private:
+        QCache<QString, T> mCache;      // Cost is in KiB
+        QString mItems;
+        qsizetype mBudget{0};           // The whole budget in KiB
+        qint64 mReserved{0};            // Bytes reserved by the derived class
+        mutable QMutex mMutex;
+        qsizetype mHits{0};
+        qsizetype mMisses{0};
+};
+
+#endif // TCOSTCACHE_H
@@ -5,6 +5,8 @@
 #include "tconfmain.h"
 #include "tgraphics.h"
 #include "tdrawborder.h"
+#include "tpixelkernels.h"
+#include "tbordercache.h"
 #include "terror.h"
 
 using namespace Graphics;
@@ -68,13 +70,32 @@ bool TDrawBorder::draw(const ObjHandler::TOBJECT_t& object, int instance)
             numBorders++;
     }
     else if (lnType == LT_OFF && TGraphics::Current().getBorder(bname, LT_ON, &bd))
+    {
+        lnType = LT_ON;
         numBorders++;
+    }
     else if (TGraphics::Current().getBorder(bname, lnType, &bd))
         numBorders++;
 
     if (numBorders > 0)
     {
         QColor color = object.sr[instance].cb;      // border color
+        // If the same frame was drawn already, we take it from the cache.
+        // The members of a family have different graphics. Therefore the
+        // name of the member is the key and not the name of the family.
+        QString key = TBorderCache::makeKey(bname, lnType, color, QSize(object.wt, object.ht));
+        TBorderCache::BORDER_FRAME_t cached;
+
+        if (mPixmap->size() == QSize(object.wt, object.ht) && TBorderCache::Current().get(key, &cached))
+        {
+            mBorderWidth = cached.borderWidth;
+            erasePart(mPixmap, cached.erase);
+            QPainter target(mPixmap);
+            target.drawPixmap(0, 0, cached.frame);
+            target.end();
+            return true;
+        }
+
         // Load images
         QPixmap imgB, imgBR, imgR, imgTR, imgT, imgTL, imgL, imgBL;
 
@@ -134,7 +155,12 @@ bool TDrawBorder::draw(const ObjHandler::TOBJECT_t& object, int instance)
                    object.ht - imgTL.height() - imgTR.height());
         MSG_DEBUG("Inner clipping region: " << clip.x() << ", " << clip.y() << ", " << clip.width() << ", " << clip.height());
         // Erase everything outside of clip region
-        erasePart(mPixmap, frame, clip);
+        QPixmap erase = getEraseMask(frame, clip);
+        erasePart(mPixmap, erase);
+
+        if (mPixmap->size() == QSize(object.wt, object.ht))
+            TBorderCache::Current().insert(key, { frame, erase, mBorderWidth });
+
         // Make final pixmap
         QPainter target(mPixmap);
         target.drawPixmap(0, 0, frame);
@@ -189,25 +215,8 @@ bool TDrawBorder::getBorderFragment(const QString& path, const QString& pathAlph
 
             if (pathAlpha.isEmpty() || path == pathAlpha)
             {
-                QImage b(image->width(), image->height(), QImage::Format_ARGB32);
-                b.fill(Qt::transparent);
-
-                for (int x = 0; x < image->width(); ++x)
-                {
-                    for (int y = 0; y < image->height(); ++y)
-                    {
-                        int alpha = img.pixelColor(x, y).alpha();
-                        QColor pix(Qt::transparent);
-
-                        if (alpha == 0)
-                            pix = swCol;
-
-                        b.setPixelColor(x, y, pix);
-                    }
-                }
-
                 QPainter painter(image);
-                painter.drawImage(QPoint(0, 0), b);
+                painter.drawImage(QPoint(0, 0), TPixelKernels::underlay(img, swCol.rgba()));
                 painter.end();
             }
         }
@@ -233,30 +242,10 @@ bool TDrawBorder::getBorderFragment(const QString& path, const QString& pathAlph
     // should be the case, then the visible pixels of the mask image are
     // colored by the border color.
     if (image->size() == bm.size())
-    {
+        img = TPixelKernels::colorize(bm.toImage(), swCol.rgba());
+    else
         img = bm.toImage();
 
-        for (int y = 0; y < image->height(); ++y)
-        {
-            for (int x = 0; x < image->width(); ++x)
-            {
-                QColor col = img.pixelColor(x, y);
-                uint alpha = col.alpha();
-                QColor pix = img.pixel(x, y);
-
-                if (alpha == 0)
-                    pix = Qt::transparent;
-                else
-                {
-                    swCol.setAlpha(alpha);
-                    pix = swCol;
-                }
-
-                img.setPixelColor(x, y, pix);
-            }
-        }
-    }
-
     // Here we draw the border fragment over the base image.
     QPainter painter(image);
     painter.drawImage(0, 0, img);
@@ -330,90 +319,52 @@ bool TDrawBorder::stretchImageWH(QPixmap *bm, int width, int height)
 }
 
 /**
- * @brief TDrawBorder::erasePart
- * The method erases all pixels outside of the clip region defined by
+ * @brief TDrawBorder::getEraseMask
+ * The method finds all pixels outside of the clip region defined by
  * @b clip. To not erase any pixel outside of the clip region but already inside
- * the the frame, it erases first from left, then from right, then from top and
+ * the the frame, it scans first from left, then from right, then from top and
  * finally from bottom. At the moment it finds a pixel which is not transparent
  * it stops. This guaranties that the content inside the frame remains
  * untouched.
+ * The result is a pixmap where every pixel to erase is opaque and all other
+ * pixels are transparent. It depends only on the frame and the clip region,
+ * so it can be cached together with the frame.
+ *
+ * @param mask      The frame and only the frame.
+ * @param clip      The region which is forbidden.
+ * @return The mask of pixels to erase.
+ */
+QPixmap TDrawBorder::getEraseMask(const QPixmap& mask, const QRect& clip)
+{
+    DECL_TRACER("TDrawBorder::getEraseMask(const QPixmap& mask, const QRect& clip)");
+
+    return QPixmap::fromImage(TPixelKernels::eraseMask(mask.toImage(), clip));
+}
+
+/**
+ * @brief TDrawBorder::erasePart
+ * The method erases all pixels of @b bm which are opaque in @b erase.
  * The pixmap in @b bm is manipulated and will be used later to put the frame on
  * top of it.
  *
  * @param bm        A pointer to a pixmap not containing the frame.
- * @param mask      The frame and only the frame.
- * @param clip      The region which is forbidden.
+ * @param erase     The mask created by getEraseMask().
  */
-void TDrawBorder::erasePart(QPixmap *bm, const QPixmap& mask, const QRect& clip)
+void TDrawBorder::erasePart(QPixmap *bm, const QPixmap& erase)
 {
-    DECL_TRACER("TDrawBorder::erasePart(QPixmap *bm, const QPixmap& mask, const QRect& clip)");
+    DECL_TRACER("TDrawBorder::erasePart(QPixmap *bm, const QPixmap& erase)");
 
     if (!bm || bm->isNull())
         return;
 
-    if (bm->size() != mask.size())
+    if (bm->size() != erase.size())
     {
         MSG_WARNING("Sizes of pixmap and mask don't match!");
         return;
     }
 
-    QImage img = bm->toImage();
-    QImage msk = mask.toImage();
-    int width = bm->width();
-    int height = bm->height();
-
-    for (int y = 0; y < height; ++y)        // from left
-    {
-        for (int x = 0; x < width; ++x)
-        {
-            if (clip.contains(x, y))
-                break;
-
-            if (setPixel(&img, msk.pixelColor(x, y), x, y))
-                break;
-        }
-
-        for (int x = width - 1; x > 0; --x) // from right
-        {
-            if (clip.contains(x, y))
-                break;
-
-            if (setPixel(&img, msk.pixelColor(x, y), x, y))
-                break;
-        }
-    }
-
-    for (int x = 0; x < width; ++x)
-    {
-        for (int y = 0; y < height; ++y)    // from top
-        {
-            if (clip.contains(x, y))
-                break;;
-
-            if (setPixel(&img, msk.pixelColor(x, y), x, y))
-                break;
-        }
-
-        for (int y = height - 1; y > 0; --y) // from bottom
-        {
-            if (clip.contains(x, y))
-                break;;
-
-            if (setPixel(&img, msk.pixelColor(x, y), x, y))
-                break;
-        }
-    }
-
-    *bm = QPixmap::fromImage(img);
-}
-
-bool TDrawBorder::setPixel(QImage *img, QColor col, int x, int y)
-{
-    if (col.alpha() <= 0)
-    {
-        img->setPixelColor(x, y, Qt::transparent);
-        return false;
-    }
-
-    return true;
+    QPainter painter(bm);
+    painter.setCompositionMode(QPainter::CompositionMode_DestinationOut);
+    painter.drawPixmap(0, 0, erase);
+    painter.end();
 }
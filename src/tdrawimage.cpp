@@ -18,10 +18,14 @@
 #include <QPainter>
 #include <QLabel>
 
+#include <cstring>
+
 #include "tdrawimage.h"
 #include "tcanvaswidget.h"
 #include "tconfmain.h"
 #include "tgraphics.h"
+#include "tpixelkernels.h"
+#include "timagecache.h"
 #include "terror.h"
 
 using namespace ObjHandler;
@@ -188,20 +192,27 @@ void TDrawImage::drawBitmapStack()
         }
 
         MSG_DEBUG("Drawing bitmap: " << bm.fileName.toStdString());
-        QPixmap pix;
-        // Load the image
-        if (!pix.load(pathTemp + "/images/" + bm.fileName))
+        // Scale image to fit into widget, if necessary
+        QSize size;
+        Qt::AspectRatioMode mode = Qt::IgnoreAspectRatio;
+
+        if (bm.justification == ORI_SCALE_FIT)
+            size = QSize(mWidth, mHeight);
+        else if (bm.justification == ORI_SCALE_ASPECT)
+        {
+            size = QSize(mWidth, mHeight);
+            mode = Qt::KeepAspectRatio;
+        }
+
+        // Load the image. The cache decodes and scales it only once.
+        QPixmap pix = TImageCache::Current().getPixmap(pathTemp + "/images/" + bm.fileName, size, mode);
+
+        if (pix.isNull())
         {
             MSG_ERROR("Couldn't load image " << bm.fileName.toStdString());
             continue;
         }
 
-        // Scale image to fit into widget, if necessary
-        if (bm.justification == ORI_SCALE_FIT)
-            pix = pix.scaled(QSize(mWidth, mHeight), Qt::IgnoreAspectRatio);
-        else if (bm.justification == ORI_SCALE_ASPECT)
-            pix = pix.scaled(QSize(mWidth, mHeight), Qt::KeepAspectRatio);
-
         // Find the wanted position of the pixmap
         int x, y;
         bm.width = pix.width();
@@ -266,10 +277,10 @@ void TDrawImage::drawChameleon()
     DECL_TRACER("TDrawImage::drawChameleon()");
 
     QString pathTemp = TConfMain::Current().getPathTemporary();
-    QPixmap imgRed;     // source: object.sr[instance].mi
+    QPixmap imgRed = TImageCache::Current().getPixmap(pathTemp + "/images/" + mChameleon);     // source: object.sr[instance].mi
     BITMAPS_t bitmapEntry;
-    // Load the image
-    if (!imgRed.load(pathTemp + "/images/" + mChameleon))
+
+    if (imgRed.isNull())
     {
         MSG_ERROR("Couldn't load image " << mChameleon.toStdString());
         return;
@@ -282,7 +293,9 @@ void TDrawImage::drawChameleon()
     {
         bitmapEntry = mBitmaps[0];
 
-        if (!imgMask.load(pathTemp + "/images/" + bitmapEntry.fileName))
+        imgMask = TImageCache::Current().getPixmap(pathTemp + "/images/" + bitmapEntry.fileName);
+
+        if (imgMask.isNull())
         {
             MSG_ERROR("Couldn't load mask image " << bitmapEntry.fileName.toStdString());
             imgMask = QPixmap();
@@ -306,40 +319,18 @@ void TDrawImage::drawChameleon()
     bitmapEntry.width = imgRed.width();
     bitmapEntry.height = imgRed.height();
 
-    QImage pixmapRed = imgRed.toImage();
+    QImage pixmapRed = imgRed.toImage().convertToFormat(QImage::Format_ARGB32);
     QImage pixmapMask;
     QImage maskbitmapEntry(mWidth, mHeight, QImage::Format_ARGB32);
-    maskbitmapEntry.fill(Qt::transparent);
     MSG_DEBUG("Size of pixmapRed: " << pixmapRed.width() << " x " << pixmapRed.height());
 
     if (!imgMask.isNull())
     {
-        pixmapMask = imgMask.toImage();
+        pixmapMask = imgMask.toImage().convertToFormat(QImage::Format_ARGB32);
         MSG_DEBUG("Size of pixmapMask: " << pixmapMask.width() << " x " << pixmapMask.height());
     }
 
-    for (int ix = 0; ix < mWidth; ix++)
-    {
-        for (int iy = 0; iy < mHeight; iy++)
-        {
-            QColor pixelRed;
-            QColor pixelMask;
-
-            if (ix < pixmapRed.width() && iy < pixmapRed.height())
-                pixelRed = pixmapRed.pixelColor(ix, iy);
-            else
-                pixelRed = Qt::transparent;
-
-            if (haveBothImages && !imgMask.isNull() &&
-                    ix < pixmapMask.width() && iy < pixmapMask.height())
-                pixelMask = pixmapMask.pixelColor(ix, iy);
-            else
-                pixelMask = Qt::transparent;
-
-            QColor pixel = baseColor(pixelRed, pixelMask);
-            maskbitmapEntry.setPixelColor(ix, iy, pixel);
-        }
-    }
+    TPixelKernels::chameleon(pixmapRed, haveBothImages ? pixmapMask : QImage(), &maskbitmapEntry, mColor1.rgba(), mColor2.rgba());
 
     int x = 0, y = 0;
     // A button with a chameleon image can't have a border. Therefore we set the
@@ -387,9 +378,9 @@ void TDrawImage::drawBargraph(const TOBJECT_t& object)
     {
         MSG_DEBUG("Detected a chameleon image...");
 
-        QPixmap bmMi, bmBm;
+        QPixmap bmMi = TImageCache::Current().getPixmap(path + "/images/" + object.sr[0].mi);
 
-        if (!bmMi.load(path + "/images/" + object.sr[0].mi))
+        if (bmMi.isNull())
         {
             MSG_ERROR("Couldn't load image " << object.sr[0].mi.toStdString() << "!");
             return;
@@ -397,14 +388,16 @@ void TDrawImage::drawBargraph(const TOBJECT_t& object)
 
         QString sBitmap = object.sr[1].bitmaps[0].fileName;
 
-        if (!bmBm.load(path + "/images/" + sBitmap))
+        QPixmap bmBm = TImageCache::Current().getPixmap(path + "/images/" + sBitmap);
+
+        if (bmBm.isNull())
         {
             MSG_ERROR("Couldn't load image " << sBitmap.toStdString() << "!");
             return;
         }
 
-        QImage pixmapRed = bmMi.toImage();
-        QImage pixmapMask = bmBm.toImage();
+        QImage pixmapRed = bmMi.toImage().convertToFormat(QImage::Format_ARGB32);
+        QImage pixmapMask = bmBm.toImage().convertToFormat(QImage::Format_ARGB32);
 
         int width = bmMi.width();
         int height = bmMi.height();
@@ -426,32 +419,35 @@ void TDrawImage::drawBargraph(const TOBJECT_t& object)
         mColor1 = object.sr[1].cf;
         mColor2 = object.sr[1].cb;
 
-        for (int ix = 0; ix < bmMi.width(); ++ix)
+        const QRgb col1 = mColor1.rgba();
+        const QRgb col2 = mColor2.rgba();
+        const int endX = qBound(startX, width, img.width());
+
+        for (int iy = 0; iy < img.height(); ++iy)
         {
-            for (int iy = 0; iy < bmMi.height(); ++iy)
+            QRgb *lineMask = iy < pixmapMask.height() ? reinterpret_cast<QRgb *>(pixmapMask.scanLine(iy)) : nullptr;
+            const int maskWidth = lineMask ? qMin(pixmapMask.width(), img.width()) : 0;
+
+            if (iy < startY || iy >= height)
             {
-                QColor pixel;
+                // Outside of the level the mask is removed
+                if (lineMask)
+                    memset(lineMask, 0, static_cast<size_t>(maskWidth) * sizeof(QRgb));
 
-                if (ix >= startX && ix < width && iy >= startY && iy < height)
-                {
-                    QColor pixelRed = pixmapRed.pixelColor(ix, iy);
-                    QColor pixelMask;
+                continue;
+            }
 
-                    if (!bmBm.isNull())
-                        pixelMask = pixmapMask.pixelColor(ix, iy);
-                    else
-                        pixelMask = Qt::white;
+            const QRgb *lineRed = reinterpret_cast<const QRgb *>(pixmapRed.constScanLine(iy));
+            QRgb *out = reinterpret_cast<QRgb *>(img.scanLine(iy));
+            const int withMask = qBound(startX, maskWidth, endX);
+            TPixelKernels::chameleonRow(lineRed + startX, lineMask ? lineMask + startX : nullptr, out + startX, withMask - startX, col1, col2);
+            TPixelKernels::chameleonRow(lineRed + withMask, nullptr, out + withMask, endX - withMask, col1, col2);
 
-                    pixel = baseColor(pixelRed, pixelMask);
-                }
-                else
-                {
-                    pixel = Qt::transparent;
-                    pixmapMask.setPixelColor(ix, iy, pixel);
-                }
+            if (lineMask && startX > 0)
+                memset(lineMask, 0, static_cast<size_t>(qMin(startX, maskWidth)) * sizeof(QRgb));
 
-                img.setPixelColor(ix, iy, pixel);
-            }
+            if (lineMask && endX < maskWidth)
+                memset(lineMask + endX, 0, static_cast<size_t>(maskWidth - endX) * sizeof(QRgb));
         }
 
         QPainter painter(mPixmap);
@@ -467,15 +463,16 @@ void TDrawImage::drawBargraph(const TOBJECT_t& object)
     {
         MSG_DEBUG("Drawing normal bargraph...");
 
-        QImage image1, image2;
+        QImage image1 = TImageCache::Current().getImage(path + "/images/" + object.sr[0].bitmaps[0].fileName);
+        QImage image2 = TImageCache::Current().getImage(path + "/images/" + object.sr[1].bitmaps[0].fileName);
 
-        if (!image1.load(path + "/images/" + object.sr[0].bitmaps[0].fileName))
+        if (image1.isNull())
         {
             MSG_ERROR("Couldn't load image " << object.sr[0].bitmaps[0].fileName.toStdString() << "!");
             return;
         }
 
-        if (!image2.load(path + "/images/" + object.sr[1].bitmaps[0].fileName))
+        if (image2.isNull())
         {
             MSG_ERROR("Couldn't load image " << object.sr[1].bitmaps[0].fileName.toStdString() << "!");
             return;
@@ -525,9 +522,9 @@ void TDrawImage::drawBargraph(const TOBJECT_t& object)
     {
         MSG_DEBUG("Drawing second image...");
 
-        QImage image;
+        QImage image = TImageCache::Current().getImage(path + "/images/" + object.sr[1].bitmaps[0].fileName);
 
-        if (!image.load(path + "/images/" + object.sr[1].bitmaps[0].fileName))
+        if (image.isNull())
         {
             MSG_ERROR("Couldn't load image " << object.sr[1].bitmaps[0].fileName.toStdString() << "!");
             return;
@@ -597,32 +594,6 @@ void TDrawImage::drawBargraph(const TOBJECT_t& object)
     }
 }
 
-QColor TDrawImage::baseColor(QColor basePix, QColor maskPix)
-{
-    int alpha = basePix.alpha();
-    int green = basePix.green();
-    int red = basePix.red();
-
-    if (alpha == 0)
-        return maskPix;
-
-    if (red && green)
-    {
-        if (red < green)
-            return mColor2;
-
-        return mColor1;
-    }
-
-    if (red)
-        return mColor1;
-
-    if (green)
-        return mColor2;
-
-    return Qt::transparent;
-}
-
 void TDrawImage::setChameleonColors(const QColor& col1, const QColor& col2)
 {
     DECL_TRACER("TDrawImage::setChameleonColors(const QColor& col1, const QColor& col2)");
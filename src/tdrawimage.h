@@ -144,11 +144,48 @@ class TDrawImage
          * @param object    The whole object
          */
         void drawBargraph(const ObjHandler::TOBJECT_t& object);
+        /**
+         * @brief baseColor
+         * Calculates one pixel of a chameleon image the way it was done
+         * before TPixelKernels::chameleon() existed. It is no longer used
+         * for drawing but kept as the reference the kernels are tested
+         * against.
+         *
+         * @param basePix   The pixel of the chameleon image.
+         * @param maskPix   The pixel of the mask image.
+         * @param col1      The first chameleon color.
+         * @param col2      The second chameleon color.
+         * @return The color of the pixel.
+         */
+        static QColor baseColor(const QColor& basePix, const QColor& maskPix, const QColor& col1, const QColor& col2)
+        {
+            int alpha = basePix.alpha();
+            int green = basePix.green();
+            int red = basePix.red();
+
+            if (alpha == 0)
+                return maskPix;
+
+            if (red && green)
+            {
+                if (red < green)
+                    return col2;
+
+                return col1;
+            }
+
+            if (red)
+                return col1;
+
+            if (green)
+                return col2;
+
+            return Qt::transparent;
+        }
 
     protected:
         void drawBitmapStack();
         void drawChameleon();
-        QColor baseColor(QColor basePix, QColor maskPix);
         void getLeftUpper(int *x, int *y, ObjHandler::BITMAPS_t bm, bool noFrame=false);
 
     private:
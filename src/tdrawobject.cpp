@@ -16,6 +16,7 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
  */
 #include <QPainter>
+#include <QHash>
 #include <QScrollArea>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
@@ -25,6 +26,7 @@
 #include "tdrawimage.h"
 #include "tdrawtext.h"
 #include "tdrawborder.h"
+#include "tgradientcache.h"
 #include "tsubviewarea.h"
 #include "tlistviewmock.h"
 #include "tfonts.h"
@@ -65,7 +67,9 @@ TDrawObject::TDrawObject(TObjectHandler *object, TResizableWidget *widget)
  * a state. Internally this states are called @bold instances.
  *
  * All parameters the method needs should have been set by calling the
- * constructor of the class.
+ * constructor of the class. The widget is optional. Without a widget the
+ * object is drawn offscreen in its own size. The result is available with
+ * getPixmap().
  */
 void TDrawObject::draw(int instance)
 {
@@ -73,9 +77,9 @@ void TDrawObject::draw(int instance)
 
     mHaveError = false;
 
-    if (!mObject || !mWidget)
+    if (!mObject)
     {
-        MSG_ERROR("Can't draw an object because missing the object or widget!");
+        MSG_ERROR("Can't draw an object because missing the object!");
         mHaveError = true;
         return;
     }
@@ -175,23 +179,22 @@ void TDrawObject::draw(int instance)
             default:
                 if (object.type == SUBPAGE_VIEW)
                 {
-                    if (mWidget)
+                    TSubViewArea area(&button);
+                    area.setScrollbarVisible(object.ba);
+                    area.setScrollbarOffset(object.bo);
+                    area.setAnchor(object.we);
+                    area.setLayoutColor(object.sr[0].lc);
+                    area.setSpace(object.sa);
+                    area.setVertical(object.on == "vert" ? true : false);
+
+                    QList<ConfigMain::SUBPAGESET_t> list = TConfMain::Current().getSubPageSetList(object.st);
+
+                    if (list.size() > 0)
                     {
-                        TSubViewArea area(&button);
-                        area.setScrollbarVisible(object.ba);
-                        area.setScrollbarOffset(object.bo);
-                        area.setAnchor(object.we);
-                        area.setLayoutColor(object.sr[0].lc);
-                        area.setSpace(object.sa);
-                        area.setVertical(object.on == "vert" ? true : false);
-
-                        QList<ConfigMain::SUBPAGESET_t> list = TConfMain::Current().getSubPageSetList(object.st);
-
-                        if (list.size() > 0)
-                        {
-                            area.setItemSize(list[0].pgWidth, list[0].pgHeight);
-                            area.drawSubViewMock(mWidget->width(), mWidget->height(), list[0].items.size());
-                        }
+                        area.setItemSize(list[0].pgWidth, list[0].pgHeight);
+                        int width = mWidget ? mWidget->width() : object.wt;
+                        int height = mWidget ? mWidget->height() : object.ht;
+                        area.drawSubViewMock(width, height, list[0].items.size());
                     }
                 }
                 else if (object.type == LISTVIEW)
@@ -216,7 +219,7 @@ void TDrawObject::draw(int instance)
         }
     }
 
-    mWidget->setPixmap(button);
+    mButton = button;
 }
 
 /**
@@ -334,18 +337,8 @@ bool TDrawObject::drawBackgroundColor(QPixmap* bm, SR_T& sr, QList<QColor>& grad
 {
     DECL_TRACER("TDrawObject::drawBackgroundColor(QPixmap* bm, SR_T& sr, QList<QColor>& grads)");
 
-    QList<QColor> gradients;
     GRAD_TYPE_t grad = getGradientType(sr.ft);
 
-    for (QColor col : grads)
-        gradients.append(col);
-
-    if (gradients.empty() || gradients.size() < 2)
-    {
-        MSG_WARNING("No gradient colors! Will use default colors!");
-        gradients = { Qt::gray, Qt::white };
-    }
-
     if (grad == GRAD_SOLID)
     {
         QPixmap bitmap(bm->size());
@@ -355,100 +348,15 @@ bool TDrawObject::drawBackgroundColor(QPixmap* bm, SR_T& sr, QList<QColor>& grad
         return true;
     }
 
-    int width = bm->width();
-    int height = bm->height();
-
-    int entity = qMax(width, height);
-    qreal stop = static_cast<qreal>(entity) / static_cast<qreal>(gradients.size()) / static_cast<qreal>(entity);
-    QGradientStops gstops;
-    qreal point = 0.0;
-
-    if (gradients.size() == 2)
-        stop = 1.0;
-
-    QList<QColor>::Iterator iter;
-
-    for (iter = gradients.begin(); iter != gradients.end(); ++iter)
-    {
-        gstops.append(std::pair<qreal, QColor>(point, *iter));
-        point += stop;
-    }
-
-    gstops.last() = std::pair<qreal, QColor>(1.0, gradients.last());
-    QPainter painter(bm);
-    QRect rect(0, 0, width, height);
-
-    if (grad == GRAD_RADIAL)    // Colors in circles
-    {
-        QRadialGradient radial;
-        // Calculate center point;
-        qreal rx = static_cast<qreal>(width) / 100.0 * static_cast<qreal>(sr.gx);
-        qreal ry = static_cast<qreal>(height) / 100.0 * static_cast<qreal>(sr.gy);
-        radial.setCenter(rx, ry);
-        radial.setFocalPoint(rx, ry);
-        radial.setRadius(static_cast<qreal>(sr.gr));
-        radial.setStops(gstops);
-        QBrush brush(radial);
-        painter.fillRect(rect, brush);
-        return true;
-    }
-    else if (grad == GRAD_SWEEP)
-    {
-        QConicalGradient grad;
-        grad.setAngle(0.0);
-        grad.setCenter(rect.center());
-        grad.setStops(gstops);
-        QBrush brush(grad);
-        painter.fillRect(rect, brush);
-        return true;
-    }
-
-    QLinearGradient linear;
-    linear.setStops(gstops);
+    // The rasterized gradient is kept, so the same fill is only a blit.
+    QImage gradient = TGradientCache::Current().getImage(grad, grads, bm->size(), sr.gx, sr.gy, sr.gr);
 
-    if (grad == GRAD_CLCR)
-    {
-        linear.setStart(0.0, static_cast<qreal>(height / 2));
-        linear.setFinalStop(static_cast<qreal>(width), static_cast<qreal>(height / 2));
-    }
-    else if (grad == GRAD_TLBR)
-    {
-        linear.setStart(0.0, 0.0);
-        linear.setFinalStop(static_cast<qreal>(width), static_cast<qreal>(height));
-    }
-    else if (grad == GRAD_CTCB)
-    {
-        linear.setStart(static_cast<qreal>(width / 2), 0.0);
-        linear.setFinalStop(static_cast<qreal>(width / 2), static_cast<qreal>(height));
-    }
-    else if (grad == GRAD_TRBL)
-    {
-        linear.setStart(static_cast<qreal>(width), 0.0);
-        linear.setFinalStop(0.0, static_cast<qreal>(height));
-    }
-    else if (grad == GRAD_CRCL)
+    if (!gradient.isNull())
     {
-        linear.setStart(static_cast<qreal>(width), static_cast<qreal>(height / 2));
-        linear.setFinalStop(0.0, static_cast<qreal>(height / 2));
-    }
-    else if (grad == GRAD_BRTL)
-    {
-        linear.setStart(static_cast<qreal>(width), static_cast<qreal>(height));
-        linear.setFinalStop(0.0, 0.0);
-    }
-    else if (grad == GRAD_CBCT)
-    {
-        linear.setStart(static_cast<qreal>(width / 2), static_cast<qreal>(height));
-        linear.setFinalStop(static_cast<qreal>(width / 2), 0.0);
-    }
-    else if (grad == GRAD_BLTR)
-    {
-        linear.setStart(0.0, static_cast<qreal>(height));
-        linear.setFinalStop(static_cast<qreal>(width), 0.0);
+        QPainter painter(bm);
+        painter.drawImage(0, 0, gradient);
     }
 
-    QBrush brush(linear);
-    painter.fillRect(rect, brush);
     return true;
 }
 
@@ -466,16 +374,16 @@ GRAD_TYPE_t TDrawObject::getGradientType(const QString& grad)
 {
     DECL_TRACER("TDrawObject::getGradientType(const QString& grad)");
 
-    int idx = 0;
-    QList<QString>::Iterator iter;
-
-    for (iter = grTypes.begin(); iter != grTypes.end(); ++iter)
+    // The table is built only once.
+    static const QHash<QString, GRAD_TYPE_t> types = []()
     {
-        if (grad == *iter)
-            return static_cast<GRAD_TYPE_t>(idx + 1);
+        QHash<QString, GRAD_TYPE_t> t;
 
-        idx++;
-    }
+        for (qsizetype i = 0; i < grTypes.size(); ++i)
+            t.insert(grTypes[i], static_cast<GRAD_TYPE_t>(i + 1));
+
+        return t;
+    }();
 
-    return GRAD_SOLID;
+    return types.value(grad, GRAD_SOLID);
 }
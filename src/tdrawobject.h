@@ -56,6 +56,7 @@ class TDrawObject
 
         void draw(int instance);
         bool haveError() { return mHaveError; }
+        QPixmap getPixmap() { return mButton; }
         static ObjHandler::GRAD_TYPE_t getGradientType(const QString& grad);
 
     private:
@@ -68,6 +69,7 @@ class TDrawObject
         TObjectHandler *mObject{nullptr};       // A pointer to the object
         TResizableWidget *mWidget{nullptr};     // The widget to place the pixmap representing the object
         QList<QPixmap> mPixButtons;             // The object as a pixmap; A pixmap for each instance
+        QPixmap mButton;                        // The last drawn instance
         bool mHaveError{false};                 // In case of an error this is TRUE
 
         DRAW_ORDER_t mDOrder[ORD_ELEM_COUNT];   // The order to draw the elements of an object
@@ -16,11 +16,10 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
  */
 #include <QLabel>
-#include <QGraphicsScene>
-#include <QGraphicsDropShadowEffect>
-#include <QGraphicsView>
+#include <QPainter>
 
 #include "tdrawtext.h"
+#include "ttextrenderer.h"
 #include "tgraphics.h"
 #include "tcanvaswidget.h"
 #include "tfonts.h"
@@ -93,8 +92,7 @@ void ShadowLabel::setShadowType(int number)
         return;
 
     mTextEffect = number;
-    mStyle = TGraphics::Current().getEffectDetails(number);
-    updateEffect();
+    update();
 }
 
 /**
@@ -125,149 +123,29 @@ void ShadowLabel::setTextEffectColor(const QColor& color)
     mTextEffectColor = color;
 }
 
-// Outline: 1 - 4
-// Glow: 5 - 8
-// Soft Drop Shadow: 9 - 16
-// Medium Drop Shadow: 17 - 24
-// Hard Drop Shadow: 25 - 32
-// Soft Drop Shadow with outline: 33 - 40
-// Medium Drop Shadow with Outline: 41 - 48
-// Hard Drop Shadow with Outline: 49 - 56
 /**
  * @brief ShadowLabel::paintEvent
- * This is an overwritten callback to the class @class QLabel. It draw the
- * outline effect or a plain text in case of another effect.
+ * This is an overwritten callback to the class @class QLabel. It draws the
+ * text with its effect. The image is created by TTextRenderer, which keeps
+ * it as long as nothing changed.
  *
- * @param event     The event happened. This is not used to draw. It is used
- * only to be passed to the original method in case there was nothing to do.
+ * @param event     The event happened. This is only passed to the original
+ * method in case there is no text.
  */
 void ShadowLabel::paintEvent(QPaintEvent *event)
 {
     DECL_TRACER("ShadowLabel::paintEvent(QPaintEvent *event)");
 
-    if ((mTextEffect >= 1 && mTextEffect <= 4) ||   // Outline
-        (mTextEffect >= 33 && mTextEffect <= 56))
-    {
-        QPainter p(this);
-        p.setRenderHint(QPainter::Antialiasing);
-        p.setFont(font());
-        QPen pen(mTextEffectColor, mTextEffect);
-        p.setPen(pen);
-
-        for (int dx = ((mStyle.width / 2) * -1); dx <= (mStyle.width / 2); ++dx)
-        {
-            for (int dy = ((mStyle.height / 2) * -1); dy <= (mStyle.height / 2); ++dy)
-            {
-                if (dx == 0 && dy == 0)
-                    continue;
-
-                p.drawText(rect().translated(dx, dy), alignment(), text());
-            }
-        }
+    QImage img = TTextRenderer::Current().render(text(), font(), size(), alignment(), mTextColor, mTextEffectColor, mTextEffect);
 
-        p.setPen(mTextColor);
-        p.drawText(rect(), alignment(), text());
-    }
-    else
+    if (img.isNull())
     {
-        if (graphicsEffect())
-        {
-            // Shadow effect active, just draw text with textColor
-            QPainter p(this);
-            p.setRenderHint(QPainter::Antialiasing);
-            p.setPen(mTextColor);
-            p.setFont(font());
-            p.drawText(rect(), alignment(), text());
-        }
-        else
-            QLabel::paintEvent(event);
-    }
-}
-
-/**
- * @brief ShadowLabel::updateEffect
- * Internal class to draw glowing and shadow effects.
- */
-void ShadowLabel::updateEffect()
-{
-    DECL_TRACER("ShadowLabel::updateEffect()");
-
-    setGraphicsEffect(nullptr);
-
-    if (mStyle.number != mTextEffect)
-        return;
-    // Outline: 1 - 4
-    // Glow: 5 - 8
-    if (mTextEffect >= 5 && mTextEffect <= 8)   // Glow
-    {
-        QGraphicsDropShadowEffect *shadow = new QGraphicsDropShadowEffect(this);
-        shadow->setColor(mTextEffectColor);
-        qreal sigma = 0.0;
-
-        switch(mTextEffect)
-        {
-            case 5: sigma = 4.0; break;     // Glow-S
-            case 6: sigma = 8.0; break;     // Glow-M
-            case 7: sigma = 12.0; break;    // Glow-L
-            case 8: sigma = 16.0; break;    // Glow-X
-        }
-
-        shadow->setBlurRadius(sigma);
-        shadow->setOffset(0, 0);
-        setGraphicsEffect(shadow);
-        update();
-        return;
-    }
-
-    if (mTextEffect == 0 || (mTextEffect >= 1 && mTextEffect <= 8))
-    {
-        update();
+        QLabel::paintEvent(event);
         return;
     }
 
-    // Draw a shadow
-    // Calculate offset
-    if (mTextEffect >= 9 && mTextEffect <= 32)
-    {
-        QString stName = mStyle.name;
-        qsizetype pos = stName.lastIndexOf(" ");
-
-        if (pos > 0)
-            mOffset = stName.remove(0, pos+1).toInt();
-    }
-    else if (mTextEffect > 32)
-    {
-        if (mTextEffect > 48)
-            mOffset = mTextEffect - 48;
-        else if (mTextEffect > 40)
-            mOffset = mTextEffect - 40;
-        else
-            mOffset = mTextEffect - 32;
-    }
-
-    QGraphicsDropShadowEffect *shadow = new QGraphicsDropShadowEffect(this);
-    shadow->setColor(mTextEffectColor);
-    // Soft Drop Shadow: 9 - 16
-    // Medium Drop Shadow: 17 - 24
-    // Hard Drop Shadow: 25 - 32
-    // Soft Drop Shadow with outline: 33 - 40
-    // Medium Drop Shadow with Outline: 41 - 48
-    // Hard Drop Shadow with Outline: 49 - 56
-    if ((mTextEffect >= 25 && mTextEffect <= 32) ||
-        (mTextEffect >= 49 && mTextEffect <= 56))
-        shadow->setBlurRadius(0);
-    else if ((mTextEffect >= 17 && mTextEffect <= 24) ||
-             (mTextEffect >= 41 && mTextEffect <= 48))
-        shadow->setBlurRadius(8);
-    else if ((mTextEffect >= 9 && mTextEffect <= 16) ||
-             (mTextEffect >= 33 && mTextEffect <= 40))
-        shadow->setBlurRadius(15);
-    else
-        shadow->setBlurRadius(0);
-
-    shadow->setOffset(mOffset, mOffset);
-    setGraphicsEffect(shadow);
-    update();
+    QPainter p(this);
+    p.drawImage(0, 0, img);
 }
 
 //
@@ -459,16 +337,9 @@ bool TDrawText::drawObject(QPixmap *bm, int instance)
 
     if (mBtObject.sr[instance].et > 0)
     {
-        ShadowLabel label;
-        label.setGeometry(rect);
-        label.setFont(font);
-        label.setAlignment(aFlag);
-        label.setText(mBtObject.sr[instance].te);
-        label.setTextColor(mBtObject.sr[instance].ct);
-        label.setTextEffectColor(mBtObject.sr[instance].ec);
-        label.setShadowType(mBtObject.sr[instance].et);
-        QPixmap px = label.grab();
-        painter.drawPixmap(0, 0, px);
+        const SR_T& sr = mBtObject.sr[instance];
+        QImage img = TTextRenderer::Current().render(sr.te, font, rect.size(), aFlag, sr.ct, sr.ec, sr.et);
+        painter.drawImage(0, 0, img);
     }
     else
     {
@@ -33,9 +33,9 @@
  * available. The class supports 3 types of shadow: hard, medium and soft.
  * "Hard" is a sharp shadow of the text. "Medium" is with a little bit more
  * blure and "soft" is with even more blur.
- * The class is using the class @class QGraphicsDropShadowEffect to draw the
- * shadows. Where the outline effect is also a shadow but the text is zentered
- * in it. The outline effect and the shadow effect can be combined.
+ * The text and its effect are rasterized by the class @class TTextRenderer,
+ * which keeps the result. Repainting the label is therefore only a blit as
+ * long as the text, the font, the colors and the effect are unchanged.
  *
  * The methods @b setTextColor() and @b setTextEffectColor() are setting the
  * colors only to internal variables. To activate them the method @b exec()
@@ -64,10 +64,6 @@ class ShadowLabel : public QLabel
         int mTextEffect{0};
         QColor mTextColor{Qt::black};
         QColor mTextEffectColor{Qt::red};
-        int mOffset{1};
-        Graphics::EFFECT_STYLE_t mStyle;
-
-        void updateEffect();
 };
 
 /**
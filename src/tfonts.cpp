@@ -33,6 +33,7 @@
 
 #include "tfonts.h"
 #include "tconfmain.h"
+#include "tconfig.h"
 #include "terror.h"
 #include "tmisc.h"
 
@@ -40,6 +41,9 @@ namespace fs = std::filesystem;
 using std::string;
 
 QList<TFonts::PRIVFONTS_t> TFonts::mLocalFonts;
+QHash<QString, qsizetype> TFonts::mFontIndex;
+QHash<QString, QString> TFonts::mFontFiles;
+QStringList TFonts::mPrivateFontFiles;
 bool TFonts::mInitialized{false};
 bool TFonts::mFontReload{false};
 
@@ -53,6 +57,14 @@ void TFonts::init()
         return;
 
     gFontConfig = FcInitLoadConfigAndFonts();
+    mInitialized = true;
+
+    // A new configuration doesn't know the private fonts.
+    for (const QString& file : std::as_const(mPrivateFontFiles))
+    {
+        if (!FcConfigAppFontAddFile(gFontConfig, reinterpret_cast<const FcChar8 *>(file.toUtf8().constData())))
+            MSG_WARNING("Couldn't add font file \"" << file.toStdString() << "\" to the font configuration!");
+    }
 }
 
 /**
@@ -61,6 +73,9 @@ void TFonts::init()
  * name of a font from it's name. By name the family name is meant. If there
  * was a valid font passed, it returns the full file name of the font.
  *
+ * Matching a font with fontconfig is expensive. Therefore the result for
+ * each family, weight and style is remembered until the fonts change.
+ *
  * @param qfont     The class containing the wanted font
  *
  * @return On success the file name is returned which was used for the font.
@@ -71,12 +86,28 @@ QString TFonts::getFontFile(const QFont& qfont)
     DECL_TRACER("TFonts::getFontFile(const QFont& font)");
 
     QFontInfo info(qfont);
+    // Bold and italic faces of a family are usually different files.
+    QString key = QString("%1|%2|%3").arg(info.family()).arg(info.weight()).arg(info.style());
+    QHash<QString, QString>::ConstIterator cached = mFontFiles.constFind(key);
+
+    if (cached != mFontFiles.constEnd())
+        return cached.value();
 
     init();
     QString fontFile;
     // configure the search pattern,
     // assume "info.family()" is a string with the desired font name in it
     FcPattern* pat = FcNameParse((const FcChar8*)(info.family().toStdString().c_str()));
+    // Qt uses the weights of OpenType.
+    FcPatternAddInteger(pat, FC_WEIGHT, FcWeightFromOpenType(info.weight()));
+
+    if (info.style() == QFont::StyleItalic)
+        FcPatternAddInteger(pat, FC_SLANT, FC_SLANT_ITALIC);
+    else if (info.style() == QFont::StyleOblique)
+        FcPatternAddInteger(pat, FC_SLANT, FC_SLANT_OBLIQUE);
+    else
+        FcPatternAddInteger(pat, FC_SLANT, FC_SLANT_ROMAN);
+
     FcConfigSubstitute(gFontConfig, pat, FcMatchPattern);
     FcDefaultSubstitute(pat);
     // find the font
@@ -95,6 +126,7 @@ QString TFonts::getFontFile(const QFont& qfont)
 
     FcPatternDestroy(pat);
     MSG_DEBUG("Font file of font \"" << info.family().toStdString() << "\" is: " << fontFile.toStdString());
+    mFontFiles.insert(key, fontFile);
     return fontFile;
 }
 
@@ -152,18 +184,46 @@ void TFonts::releaseFontConfig()
 
     if (mInitialized)
     {
-        FcFini();
+        // Only the own configuration is released. FcFini() would also
+        // release the library used by Qt.
+        FcConfigDestroy(gFontConfig);
         gFontConfig = nullptr;
         mInitialized = false;
+        mFontFiles.clear();
     }
 }
 
+/**
+ * @brief TFonts::reset
+ * Removes all fonts of a project. This must be called when a project is
+ * closed, so the next project doesn't find them.
+ */
 void TFonts::reset()
 {
     DECL_TRACER("TFonts::reset()");
 
     freePrivateFonts();
-    mLocalFonts.clear();
+    clearLocalFonts();
+}
+
+/**
+ * @brief TFonts::clearFontList
+ * Removes the fonts from the list of used fonts before the pages register
+ * their fonts again. The fonts loaded from the project remain loaded and
+ * in the list, because the project still uses them.
+ */
+void TFonts::clearFontList()
+{
+    DECL_TRACER("TFonts::clearFontList()");
+
+    mLocalFonts.removeIf([](const PRIVFONTS_t& font) { return font.ID < 0; });
+    mFontIndex.clear();
+
+    for (qsizetype i = 0; i < mLocalFonts.size(); ++i)
+    {
+        if (!mFontIndex.contains(mLocalFonts[i].file))
+            mFontIndex.insert(mLocalFonts[i].file, i);
+    }
 }
 
 /**
@@ -193,17 +253,15 @@ QFont TFonts::getFont(const QString& ff)
 
     QString baseName = getFontBaseName(ff);
     // Look in the table if the string is not already in the list.
-    QList<PRIVFONTS_t>::Iterator iter;
+    qsizetype idx = findFont(baseName);
 
-    for (iter = mLocalFonts.begin(); iter != mLocalFonts.end(); ++iter)
+    if (idx >= 0)
     {
-        if (iter->file == baseName)
-        {
-            font.setFamilies(iter->family);
-            setFontAttributes(&font, ff);
-            font.setPointSize(iter->size > 0 ? iter->size : TConfMain::Current().getFontBaseSize());
-            return font;
-        }
+        const PRIVFONTS_t& pf = mLocalFonts[idx];
+        font.setFamilies(pf.family);
+        setFontAttributes(&font, ff);
+        font.setPointSize(pf.size > 0 ? pf.size : TConfMain::Current().getFontBaseSize());
+        return font;
     }
 
     font.setFamily(ff);
@@ -332,13 +390,8 @@ void TFonts::addFont(const QFont& font, const QString& file)
     DECL_TRACER("TFonts::addFont(const QFont& font, const QString& file)");
 
     // Look in the table if the string is not already in the list.
-    QList<PRIVFONTS_t>::Iterator iter;
-
-    for (iter = mLocalFonts.begin(); iter != mLocalFonts.end(); ++iter)
-    {
-        if (iter->file == file)
-            return;
-    }
+    if (findFont(file) >= 0)
+        return;
 
     if (fs::exists(file.toStdString()))
     {
@@ -351,7 +404,7 @@ void TFonts::addFont(const QFont& font, const QString& file)
         pf.underline = font.underline();
         pf.ID = -1;
         pf.family = font.families();
-        mLocalFonts.append(pf);
+        appendFont(pf);
     }
 }
 
@@ -373,13 +426,8 @@ void TFonts::addFontFile(const QString& file)
     DECL_TRACER("TFonts::addFontFile(const QString& file)");
 
     // Look in the table if the string is not already in the list.
-    QList<PRIVFONTS_t>::Iterator iter;
-
-    for (iter = mLocalFonts.begin(); iter != mLocalFonts.end(); ++iter)
-    {
-        if (iter->file == file)
-            return;
-    }
+    if (findFont(file) >= 0)
+        return;
 
     if (fs::exists(file.toStdString()))
     {
@@ -393,7 +441,9 @@ void TFonts::addFontFile(const QString& file)
         pf.intFile = file;
         pf.ID = id;
         pf.family = QFontDatabase::applicationFontFamilies(id);
-        mLocalFonts.append(pf);
+        appendFont(pf);
+        // The new font may change the result of a font match.
+        mFontFiles.clear();
     }
 }
 
@@ -432,19 +482,28 @@ void TFonts::addFontFamily(const QString& family)
     pv.intFile = getFontFile(font);
     pv.file = basename(pv.intFile);
     pv.family.append(family);
-    mLocalFonts.append(pv);
+    appendFont(pv);
 }
 
 /**
  * @brief TFonts::freePrivateFonts
  * This method removes all explitely added fonts from the font database. A font
  * can explicittely be added by calling addFontFile().
- * All standard fonts in the database remain there.
+ * All standard fonts in the database remain there. The private fonts are
+ * removed from the fontconfig configuration too.
  */
 void TFonts::freePrivateFonts()
 {
     DECL_TRACER("TFonts::freePrivateFonts()");
 
+    // The fonts added to the fontconfig configuration must not be found
+    // by the next project.
+    if (mInitialized && !mPrivateFontFiles.isEmpty())
+        FcConfigAppFontClear(gFontConfig);
+
+    mPrivateFontFiles.clear();
+    mFontFiles.clear();
+
     if (mLocalFonts.empty())
         return;
 
@@ -456,7 +515,7 @@ void TFonts::freePrivateFonts()
             QFontDatabase::removeApplicationFont(iter->ID);
     }
 
-    mLocalFonts.clear();
+    clearLocalFonts();
 }
 
 /**
@@ -507,7 +566,7 @@ bool TFonts::readFontFile(const QString& path, const QString& qfile)
             prvFont.family.append(families[j].toString());
 
         prvFont.ID = loadFont(path, prvFont.file, prvFont.family);
-        mLocalFonts.append(prvFont);
+        appendFont(prvFont);
     }
 
     readSystemFonts(path);
@@ -607,6 +666,9 @@ bool TFonts::readSystemFonts(const QString& path)
 
         int id = QFontDatabase::addApplicationFont(iter->absoluteFilePath());
         MSG_DEBUG("Added system font file \"" << iter->fileName().toStdString() << "\" to font database with ID " << id);
+
+        if (TConfig::Current().getPrivateFonts())
+            addPrivateFontFile(iter->absoluteFilePath());
     }
 
     return true;
@@ -709,7 +771,7 @@ void TFonts::parseFont(const QDomElement &font)
         fnt.size = font.firstChildElement("size").text().toInt();
 
     fnt.ID = loadFont(path, fnt.file, fnt.family);
-    mLocalFonts.append(fnt);
+    appendFont(fnt);
 }
 
 void TFonts::setFontAttributes(QFont *font, const QString& name)
@@ -748,8 +810,16 @@ int TFonts::loadFont(const QString& path, const QString& file, const QStringList
         QString srcFile = path + "/fonts/" + file;
         ID = QFontDatabase::addApplicationFont(srcFile);
         MSG_DEBUG("Added font file \"" << srcFile.toStdString() << "\" to font database.");
+
+        if (TConfig::Current().getPrivateFonts())
+            addPrivateFontFile(srcFile);
     }
 
+    // The font is known to this application now. Installing it for the
+    // user is only needed if other programs should see it too.
+    if (TConfig::Current().getPrivateFonts())
+        return ID;
+
     try
     {
         QString home = getHomeDir();
@@ -809,6 +879,17 @@ void TFonts::updateFontCache()
         }
 
         MSG_INFO("Font cache updated successfully.");
+        // The configuration still has the old list of fonts. It is
+        // loaded again with the next font match. All matches are done
+        // again.
+        releaseFontConfig();
+        mFontIndex.clear();
+
+        for (qsizetype i = 0; i < mLocalFonts.size(); ++i)
+        {
+            if (!mFontIndex.contains(mLocalFonts[i].file))
+                mFontIndex.insert(mLocalFonts[i].file, i);
+        }
     }
     catch (std::exception& e)
     {
@@ -817,3 +898,68 @@ void TFonts::updateFontCache()
 
     mFontReload = false;
 }
+
+/**
+ * @brief TFonts::findFont
+ * Searches for the first font loaded from the file @b file.
+ *
+ * @param file  The file name as stored in the internal structure.
+ * @return The index into the internal list or -1 if the file is unknown.
+ */
+qsizetype TFonts::findFont(const QString& file)
+{
+    DECL_TRACER("TFonts::findFont(const QString& file)");
+
+    return mFontIndex.value(file, -1);
+}
+
+void TFonts::appendFont(const PRIVFONTS_t& font)
+{
+    DECL_TRACER("TFonts::appendFont(const PRIVFONTS_t& font)");
+
+    mLocalFonts.append(font);
+
+    // Only the first entry of a file is found by a search.
+    if (!mFontIndex.contains(font.file))
+        mFontIndex.insert(font.file, mLocalFonts.size() - 1);
+}
+
+void TFonts::clearLocalFonts()
+{
+    DECL_TRACER("TFonts::clearLocalFonts()");
+
+    mLocalFonts.clear();
+    mFontIndex.clear();
+    mFontFiles.clear();
+}
+
+/**
+ * @brief TFonts::addPrivateFontFile
+ * Adds a font file to the fontconfig configuration of this application.
+ * This way getFontFile() finds the fonts of a project without installing
+ * them for the user and without rebuilding the font cache of the system.
+ * The file is remembered, so it is added again if the configuration is
+ * loaded again.
+ *
+ * @param file  The font file with full path.
+ */
+void TFonts::addPrivateFontFile(const QString& file)
+{
+    DECL_TRACER("TFonts::addPrivateFontFile(const QString& file)");
+
+    // The configuration has it already or gets it with init().
+    if (mPrivateFontFiles.contains(file))
+        return;
+
+    init();
+
+    if (!FcConfigAppFontAddFile(gFontConfig, reinterpret_cast<const FcChar8 *>(file.toUtf8().constData())))
+    {
+        MSG_WARNING("Couldn't add font file \"" << file.toStdString() << "\" to the font configuration!");
+        return;
+    }
+
+    mPrivateFontFiles.append(file);
+    // A font match may find the new font now.
+    mFontFiles.clear();
+}
@@ -20,6 +20,7 @@
 
 #include <QString>
 #include <QStringList>
+#include <QHash>
 #include <QFont>
 
 class QDomElement;
@@ -90,6 +91,7 @@ class TFonts
         static void freePrivateFonts();
         static void releaseFontConfig();
         static void reset();
+        static void clearFontList();
         static QFont getFont(const QString& ff);
         static QString getFontBaseName(const QString& ff);
         static QFont getFontFromIndex(int index);
@@ -105,11 +107,18 @@ class TFonts
         static void parseFont(const QDomElement &font);
         static void setFontAttributes(QFont *font, const QString& name);
         static void updateFontCache();
+        static void addPrivateFontFile(const QString& file);
+        static qsizetype findFont(const QString& file);
+        static void appendFont(const PRIVFONTS_t& font);
+        static void clearLocalFonts();
 
     private:
         TFonts() {};    // Must never be called
 
         static QList<PRIVFONTS_t> mLocalFonts;
+        static QHash<QString, qsizetype> mFontIndex;    // File name --> index of first entry in mLocalFonts
+        static QHash<QString, QString> mFontFiles;      // Family, weight and style --> font file found by fontconfig
+        static QStringList mPrivateFontFiles;           // Font files added to the fontconfig configuration
         static bool mInitialized;
         static bool mFontReload;
 };
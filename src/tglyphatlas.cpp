@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <QPainter>
+#include <QFontMetrics>
+#include <QFontDatabase>
+#include <QRunnable>
+#include <QThread>
+
+#include "tglyphatlas.h"
+#include "tconfig.h"
+#include "terror.h"
+
+#define ATLAS_CHARACTERS    65536   // The number of characters in the map
+
+TGlyphAtlas::TGlyphAtlas(QObject *parent)
+    : QObject(parent),
+      mTiles("Glyph atlas", "tiles", TConfig::Current().getGlyphCacheSize())
+{
+    DECL_TRACER("TGlyphAtlas::TGlyphAtlas(QObject *parent)");
+
+    mPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+}
+
+TGlyphAtlas::~TGlyphAtlas()
+{
+    DECL_TRACER("TGlyphAtlas::~TGlyphAtlas()");
+
+    // Results arriving later are discarded together with this object.
+    mPool.clear();
+    mPool.waitForDone();
+}
+
+/**
+ * @brief TGlyphAtlas::setFont
+ * Sets the font and the geometry of the map. Tiles of the previous font
+ * stay in the cache.
+ *
+ * @param font          The font to show.
+ * @param squareSize    The width and height of a cell in pixels.
+ * @param columns       The number of cells in a row.
+ */
+void TGlyphAtlas::setFont(const QFont& font, int squareSize, int columns)
+{
+    DECL_TRACER("TGlyphAtlas::setFont(const QFont& font, int squareSize, int columns)");
+
+    mFont = font;
+    mSquareSize = qMax(1, squareSize);
+    mColumns = qMax(1, columns);
+}
+
+void TGlyphAtlas::setDevicePixelRatio(qreal dpr)
+{
+    DECL_TRACER("TGlyphAtlas::setDevicePixelRatio(qreal dpr)");
+
+    if (dpr > 0.0)
+        mDpr = dpr;
+}
+
+/**
+ * @brief TGlyphAtlas::getTile
+ * Returns the image of a tile. If it was not rasterized yet, this is
+ * started on a worker thread and a null image is returned. The signal
+ * tileReady() is emitted as soon as the tile is available.
+ *
+ * @param tile  The index of the tile. The first row of the tile is
+ * tile * ATLAS_TILE_ROWS.
+ * @return The image of the tile or a null image.
+ */
+QImage TGlyphAtlas::getTile(int tile)
+{
+//    DECL_TRACER("TGlyphAtlas::getTile(int tile)");
+
+    QString key = getTileKey(tile);
+    QImage img;
+
+    if (mTiles.get(key, &img))
+        return img;
+
+    startTile(tile);
+    // Without threaded font rendering the tile is ready now.
+    if (mTiles.contains(key))
+        mTiles.get(key, &img);
+
+    return img;
+}
+
+void TGlyphAtlas::startTile(int tile)
+{
+    DECL_TRACER("TGlyphAtlas::startTile(int tile)");
+
+    QString key = getTileKey(tile);
+
+    if (mPending.contains(key) || mTiles.contains(key))
+        return;
+
+    if (!QFontDatabase::supportsThreadedFontRendering())
+    {
+        QImage img = rasterize(mFont, mSquareSize, mColumns, mDpr, tile);
+        mTiles.insert(key, img, img.sizeInBytes());
+        return;
+    }
+
+    mPending.insert(key);
+    QFont font = mFont;
+    int squareSize = mSquareSize;
+    int columns = mColumns;
+    qreal dpr = mDpr;
+
+    mPool.start(QRunnable::create([this, key, font, squareSize, columns, dpr, tile]()
+    {
+        QImage img = rasterize(font, squareSize, columns, dpr, tile);
+
+        QMetaObject::invokeMethod(this, [this, key, tile, img]()
+        {
+            mPending.remove(key);
+            mTiles.insert(key, img, img.sizeInBytes());
+
+            if (key == getTileKey(tile))
+                emit tileReady(tile);
+        }, Qt::QueuedConnection);
+    }));
+}
+
+QString TGlyphAtlas::getTileKey(int tile) const
+{
+    DECL_TRACER("TGlyphAtlas::getTileKey(int tile)");
+
+    return QString("%1|%2|%3|%4|%5").arg(mFont.key()).arg(mSquareSize).arg(mColumns).arg(mDpr).arg(tile);
+}
+
+/**
+ * @brief TGlyphAtlas::rasterize
+ * Draws the cells of a tile into an image. This runs on a worker thread,
+ * if the platform supports it, and uses nothing but the parameters.
+ *
+ * @param font          The font.
+ * @param squareSize    The width and height of a cell.
+ * @param columns       The number of cells in a row.
+ * @param dpr           The device pixel ratio of the screen.
+ * @param tile          The index of the tile.
+ * @return The image of the tile.
+ */
+QImage TGlyphAtlas::rasterize(const QFont& font, int squareSize, int columns, qreal dpr, int tile)
+{
+    DECL_TRACER("TGlyphAtlas::rasterize(const QFont& font, int squareSize, int columns, qreal dpr, int tile)");
+
+    QSize size(columns * squareSize, ATLAS_TILE_ROWS * squareSize);
+    QImage img(size * dpr, QImage::Format_ARGB32_Premultiplied);
+    img.setDevicePixelRatio(dpr);
+    img.fill(Qt::white);
+
+    QPainter painter(&img);
+    painter.setFont(font);
+    QFontMetrics fontMetrics(font);
+    int firstKey = tile * ATLAS_TILE_ROWS * columns;
+
+    for (int row = 0; row < ATLAS_TILE_ROWS; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+        {
+            int key = firstKey + row * columns + column;
+            QRect cell(column * squareSize, row * squareSize, squareSize, squareSize);
+
+            if (key >= ATLAS_CHARACTERS)
+                break;
+
+            painter.setClipRect(cell);
+            painter.setPen(QPen(Qt::black));
+            painter.drawText(cell.x() + (squareSize / 2) - fontMetrics.boundingRect(QChar(key)).width() / 2,
+                             cell.y() + 4 + fontMetrics.ascent(), QString(QChar(key)));
+            painter.setClipping(false);
+        }
+    }
+
+    painter.setPen(QPen(Qt::gray));
+
+    for (int row = 0; row < ATLAS_TILE_ROWS; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+            painter.drawRect(column * squareSize, row * squareSize, squareSize, squareSize);
+    }
+
+    painter.end();
+    return img;
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TGLYPHATLAS_H
+#define TGLYPHATLAS_H
+
+#include <QObject>
+#include <QSet>
+#include <QImage>
+#include <QFont>
+#include <QThreadPool>
+
+#include "tcostcache.h"
+
+#define ATLAS_TILE_ROWS     16      // The number of rows of characters in a tile
+
+/**
+ * @brief The TGlyphAtlas class
+ * Holds the character map of a font as images. The map is divided into
+ * tiles of ATLAS_TILE_ROWS rows. A tile is rasterized on a worker thread
+ * the first time it is needed. After that, painting the map or scrolling
+ * only copies the images of the tiles.
+ *
+ * The tiles are cached for each combination of font, size of a cell and
+ * device pixel ratio. Switching back to a font used before doesn't
+ * rasterize anything again. Characters not in the font are drawn with a
+ * fallback font, as QPainter does.
+ *
+ * If the platform can't render fonts outside of the GUI thread, the tiles
+ * are rasterized on the GUI thread when they are needed.
+ */
+class TGlyphAtlas : public QObject
+{
+    Q_OBJECT
+
+    public:
+        TGlyphAtlas(QObject *parent=nullptr);
+        ~TGlyphAtlas();
+
+        void setFont(const QFont& font, int squareSize, int columns);
+        void setDevicePixelRatio(qreal dpr);
+        QImage getTile(int tile);
+
+    signals:
+        void tileReady(int tile);
+
+    private:
+        void startTile(int tile);
+        QString getTileKey(int tile) const;
+        static QImage rasterize(const QFont& font, int squareSize, int columns, qreal dpr, int tile);
+
+        QFont mFont;
+        int mSquareSize{24};
+        int mColumns{16};
+        qreal mDpr{1.0};
+        TCostCache<QImage> mTiles;              // The rasterized tiles
+        QSet<QString> mPending;                 // The tiles being rasterized
+        QThreadPool mPool;                      // Rasterizes the tiles
+};
+
+#endif // TGLYPHATLAS_H
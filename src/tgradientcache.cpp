@@ -0,0 +1,319 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <QPainter>
+#include <QLinearGradient>
+#include <QRadialGradient>
+#include <QConicalGradient>
+#include <QMutexLocker>
+
+#include <cstring>
+
+#include "tgradientcache.h"
+#include "tconfig.h"
+#include "terror.h"
+
+using namespace ObjHandler;
+
+#define RAMP_CACHE_SIZE         256     // KiB
+
+// A gradient larger than the budget is drawn but not cached. Therefore
+// the budget must hold at least the background of a page.
+TGradientCache::TGradientCache()
+    : TCostCache("Gradient cache", "gradients", TConfig::Current().getGradientCacheSize())
+{
+    DECL_TRACER("TGradientCache::TGradientCache()");
+
+    mRamps.setMaxCost(RAMP_CACHE_SIZE);
+}
+
+TGradientCache& TGradientCache::Current()
+{
+//    DECL_TRACER("TGradientCache::Current()");
+
+    static TGradientCache *cache = new TGradientCache;
+    return *cache;
+}
+
+/**
+ * @brief TGradientCache::getImage
+ * Returns the gradient fill of an area. If it is not in the cache, it is
+ * rasterized and stored.
+ *
+ * @param type      The type of the gradient. This must not be GRAD_SOLID.
+ * @param colors    The gradient colors. At least 2 colors are needed.
+ * @param size      The size of the area.
+ * @param gx        Radial only: Horizontal center in percent of the width.
+ * @param gy        Radial only: Vertical center in percent of the height.
+ * @param gr        Radial only: The radius in pixels.
+ * @return The image. If the size is empty, a null image is returned.
+ */
+QImage TGradientCache::getImage(GRAD_TYPE_t type, const QList<QColor>& colors, const QSize& size, int gx, int gy, int gr)
+{
+    DECL_TRACER("TGradientCache::getImage(GRAD_TYPE_t type, const QList<QColor>& colors, const QSize& size, int gx, int gy, int gr)");
+
+    if (size.isEmpty())
+        return QImage();
+
+    QString key = QString("%1|%2x%3").arg(makeKey(type, colors)).arg(size.width()).arg(size.height());
+
+    if (type == GRAD_RADIAL)
+        key += QString("|%1|%2|%3").arg(gx).arg(gy).arg(gr);
+
+    QImage image;
+
+    if (get(key, &image))
+        return image;
+
+    image = QImage(size, QImage::Format_ARGB32_Premultiplied);
+
+    if (type == GRAD_CLCR || type == GRAD_CRCL)
+    {
+        QImage ramp = getRamp(type, colors, size.width());
+        const uchar *src = ramp.constScanLine(0);
+
+        for (int y = 0; y < size.height(); ++y)
+            std::memcpy(image.scanLine(y), src, static_cast<size_t>(size.width()) * 4);
+    }
+    else if (type == GRAD_CTCB || type == GRAD_CBCT)
+    {
+        QImage ramp = getRamp(type, colors, size.height());
+
+        for (int y = 0; y < size.height(); ++y)
+        {
+            QRgb pixel = reinterpret_cast<const QRgb *>(ramp.constScanLine(y))[0];
+            QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+            std::fill(line, line + size.width(), pixel);
+        }
+    }
+    else
+    {
+        image.fill(Qt::transparent);
+        QPainter painter(&image);
+        painter.fillRect(image.rect(), getBrush(type, colors, size, gx, gy, gr));
+        painter.end();
+    }
+
+    insert(key, image, image.sizeInBytes());
+    return image;
+}
+
+void TGradientCache::clear()
+{
+    DECL_TRACER("TGradientCache::clear()");
+
+    TCostCache::clear();
+    QMutexLocker locker(&mMutex);
+    mRamps.clear();
+}
+
+void TGradientCache::logStatistics()
+{
+    DECL_TRACER("TGradientCache::logStatistics()");
+
+    qsizetype ramps = 0;
+
+    {
+        QMutexLocker locker(&mMutex);
+        ramps = mRamps.count();
+    }
+
+    TCostCache::logStatistics(QString("%1 ramps").arg(ramps));
+}
+
+/**
+ * @brief TGradientCache::getStops
+ * Distributes the gradient colors evenly. The last color is always at the
+ * end of the gradient.
+ *
+ * @param colors    The gradient colors. If there are less than 2 colors,
+ * gray and white are used.
+ * @return The stops of the gradient.
+ */
+QGradientStops TGradientCache::getStops(const QList<QColor>& colors)
+{
+    DECL_TRACER("TGradientCache::getStops(const QList<QColor>& colors)");
+
+    QList<QColor> gradients = colors;
+
+    if (gradients.size() < 2)
+    {
+        MSG_WARNING("No gradient colors! Will use default colors!");
+        gradients = { Qt::gray, Qt::white };
+    }
+
+    qreal stop = 1.0 / static_cast<qreal>(gradients.size());
+    QGradientStops gstops;
+    qreal point = 0.0;
+
+    if (gradients.size() == 2)
+        stop = 1.0;
+
+    for (const QColor& col : gradients)
+    {
+        gstops.append(std::pair<qreal, QColor>(point, col));
+        point += stop;
+    }
+
+    gstops.last() = std::pair<qreal, QColor>(1.0, gradients.last());
+    return gstops;
+}
+
+/**
+ * @brief TGradientCache::getBrush
+ * Creates the brush for a gradient covering an area starting at 0, 0.
+ *
+ * @param type      The type of the gradient.
+ * @param colors    The gradient colors.
+ * @param size      The size of the area.
+ * @param gx        Radial only: Horizontal center in percent of the width.
+ * @param gy        Radial only: Vertical center in percent of the height.
+ * @param gr        Radial only: The radius in pixels.
+ * @return The brush.
+ */
+QBrush TGradientCache::getBrush(GRAD_TYPE_t type, const QList<QColor>& colors, const QSize& size, int gx, int gy, int gr)
+{
+    DECL_TRACER("TGradientCache::getBrush(GRAD_TYPE_t type, const QList<QColor>& colors, const QSize& size, int gx, int gy, int gr)");
+
+    QGradientStops gstops = getStops(colors);
+    int width = size.width();
+    int height = size.height();
+
+    if (type == GRAD_RADIAL)    // Colors in circles
+    {
+        QRadialGradient radial;
+        // Calculate center point;
+        qreal rx = static_cast<qreal>(width) / 100.0 * static_cast<qreal>(gx);
+        qreal ry = static_cast<qreal>(height) / 100.0 * static_cast<qreal>(gy);
+        radial.setCenter(rx, ry);
+        radial.setFocalPoint(rx, ry);
+        radial.setRadius(static_cast<qreal>(gr));
+        radial.setStops(gstops);
+        return QBrush(radial);
+    }
+    else if (type == GRAD_SWEEP)
+    {
+        QConicalGradient grad;
+        grad.setAngle(0.0);
+        grad.setCenter(QRectF(0.0, 0.0, width, height).center());
+        grad.setStops(gstops);
+        return QBrush(grad);
+    }
+
+    QLinearGradient linear;
+    linear.setStops(gstops);
+
+    switch(type)
+    {
+        case GRAD_CLCR:
+            linear.setStart(0.0, static_cast<qreal>(height / 2));
+            linear.setFinalStop(static_cast<qreal>(width), static_cast<qreal>(height / 2));
+        break;
+
+        case GRAD_TLBR:
+            linear.setStart(0.0, 0.0);
+            linear.setFinalStop(static_cast<qreal>(width), static_cast<qreal>(height));
+        break;
+
+        case GRAD_CTCB:
+            linear.setStart(static_cast<qreal>(width / 2), 0.0);
+            linear.setFinalStop(static_cast<qreal>(width / 2), static_cast<qreal>(height));
+        break;
+
+        case GRAD_TRBL:
+            linear.setStart(static_cast<qreal>(width), 0.0);
+            linear.setFinalStop(0.0, static_cast<qreal>(height));
+        break;
+
+        case GRAD_CRCL:
+            linear.setStart(static_cast<qreal>(width), static_cast<qreal>(height / 2));
+            linear.setFinalStop(0.0, static_cast<qreal>(height / 2));
+        break;
+
+        case GRAD_BRTL:
+            linear.setStart(static_cast<qreal>(width), static_cast<qreal>(height));
+            linear.setFinalStop(0.0, 0.0);
+        break;
+
+        case GRAD_CBCT:
+            linear.setStart(static_cast<qreal>(width / 2), static_cast<qreal>(height));
+            linear.setFinalStop(static_cast<qreal>(width / 2), 0.0);
+        break;
+
+        case GRAD_BLTR:
+            linear.setStart(0.0, static_cast<qreal>(height));
+            linear.setFinalStop(static_cast<qreal>(width), 0.0);
+        break;
+
+        default:
+            break;
+    }
+
+    return QBrush(linear);
+}
+
+/**
+ * @brief TGradientCache::getRamp
+ * Returns the colors of a gradient parallel to an edge. For horizontal
+ * gradients this is an image of one line, for vertical gradients an image
+ * of one column.
+ *
+ * @param type      The type of the gradient.
+ * @param colors    The gradient colors.
+ * @param length    The length of the gradient in pixels.
+ * @return The ramp.
+ */
+QImage TGradientCache::getRamp(GRAD_TYPE_t type, const QList<QColor>& colors, int length)
+{
+    DECL_TRACER("TGradientCache::getRamp(GRAD_TYPE_t type, const QList<QColor>& colors, int length)");
+
+    QString key = QString("%1|%2").arg(makeKey(type, colors)).arg(length);
+
+    {
+        QMutexLocker locker(&mMutex);
+        QImage *entry = mRamps.object(key);
+
+        if (entry)
+            return *entry;
+    }
+
+    bool horizontal = (type == GRAD_CLCR || type == GRAD_CRCL);
+    QSize size = horizontal ? QSize(length, 1) : QSize(1, length);
+    // The same brush as for the whole area. The gradient doesn't change
+    // across the ramp, so the result is identical.
+    QImage ramp(size, QImage::Format_ARGB32_Premultiplied);
+    ramp.fill(Qt::transparent);
+    QPainter painter(&ramp);
+    painter.fillRect(ramp.rect(), getBrush(type, colors, horizontal ? QSize(length, 2) : QSize(2, length)));
+    painter.end();
+
+    QMutexLocker locker(&mMutex);
+    mRamps.insert(key, new QImage(ramp), qMax<qsizetype>(1, ramp.sizeInBytes() / 1024));
+    return ramp;
+}
+
+QString TGradientCache::makeKey(GRAD_TYPE_t type, const QList<QColor>& colors)
+{
+    DECL_TRACER("TGradientCache::makeKey(GRAD_TYPE_t type, const QList<QColor>& colors)");
+
+    QString key = QString::number(type);
+
+    for (const QColor& col : colors)
+        key += "|" + QString::number(col.rgba(), 16);
+
+    return key;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TGRADIENTCACHE_H
+#define TGRADIENTCACHE_H
+
+#include <QCache>
+#include <QImage>
+#include <QBrush>
+#include <QString>
+#include <QColor>
+#include <QList>
+#include <QSize>
+#include <QMutex>
+
+#include "tcostcache.h"
+#include "tobjecthandler.h"
+
+/**
+ * @brief The TGradientCache class
+ * Keeps rasterized gradient fills of buttons and pages. The key consists
+ * of the type of the gradient, the colors, the size, the center and the
+ * radius. As long as none of them changes, a gradient fill is only a
+ * blit.
+ *
+ * Gradients running parallel to an edge (left to right, top to bottom and
+ * their reverse) change only in one direction. For them a ramp of one
+ * pixel width is rasterized and copied into every line. The ramp depends
+ * only on the length of the gradient. So all buttons of the same height
+ * share a vertical ramp, no matter how wide they are.
+ */
+class TGradientCache : public TCostCache<QImage>
+{
+    public:
+        static TGradientCache& Current();
+
+        QImage getImage(ObjHandler::GRAD_TYPE_t type, const QList<QColor>& colors, const QSize& size, int gx=0, int gy=0, int gr=0);
+        void clear() override;
+        void logStatistics() override;
+
+        static QGradientStops getStops(const QList<QColor>& colors);
+        static QBrush getBrush(ObjHandler::GRAD_TYPE_t type, const QList<QColor>& colors, const QSize& size, int gx=0, int gy=0, int gr=0);
+
+    private:
+        TGradientCache();
+
+        QImage getRamp(ObjHandler::GRAD_TYPE_t type, const QList<QColor>& colors, int length);
+        static QString makeKey(ObjHandler::GRAD_TYPE_t type, const QList<QColor>& colors);
+
+        QCache<QString, QImage> mRamps;     // Cost is in KiB
+        QMutex mMutex;                      // Protects the ramps
+};
+
+#endif // TGRADIENTCACHE_H
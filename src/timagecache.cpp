@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <QMutexLocker>
+
+#include "timagecache.h"
+#include "tconfig.h"
+#include "terror.h"
+
+TImageCache::TImageCache()
+    : TCostCache("Image cache", "images", TConfig::Current().getImageCacheSize())
+{
+    DECL_TRACER("TImageCache::TImageCache()");
+}
+
+/**
+ * @brief TImageCache::Current
+ * Returns the only instance of the cache. The first call may come from a
+ * worker thread. Therefore the instance is a local static, whose
+ * initialization is thread safe.
+ */
+TImageCache& TImageCache::Current()
+{
+//    DECL_TRACER("TImageCache::Current()");
+
+    static TImageCache cache;
+    return cache;
+}
+
+/**
+ * @brief TImageCache::getImage
+ * Returns the decoded image of a file. If the image is not in the cache,
+ * it is loaded from disk, scaled and stored in the cache.
+ *
+ * @param file  The path and name of the image file.
+ * @param size  The wanted size. If this is not valid, the image is
+ * returned in its original size.
+ * @param mode  Defines how the image is scaled.
+ * @param ori   Optional: A pointer receiving the original size of the
+ * image.
+ * @return The image. If the file couldn't be loaded, a null image is
+ * returned.
+ */
+QImage TImageCache::getImage(const QString& file, const QSize& size, Qt::AspectRatioMode mode, QSize *ori)
+{
+    DECL_TRACER("TImageCache::getImage(const QString& file, const QSize& size, Qt::AspectRatioMode mode, QSize *ori)");
+
+    if (ori)
+        *ori = QSize(0, 0);
+
+    if (file.isEmpty())
+        return QImage();
+
+    QString key = getKey(file, size, mode);
+
+    {
+        QMutexLocker locker(&mMutex);
+        QHash<QString, PINNED_t>::ConstIterator pin = mPinned.constFind(key);
+
+        if (pin != mPinned.constEnd())
+        {
+            addHit();
+
+            if (ori)
+                *ori = pin->entry.original;
+
+            return pin->entry.image;
+        }
+    }
+
+    IMAGE_ENTRY_t entry;
+
+    if (get(key, &entry))
+    {
+        if (ori)
+            *ori = entry.original;
+
+        return entry.image;
+    }
+
+    // Decoding is done without the lock, so other threads are not blocked.
+    if (!entry.image.load(file))
+    {
+        MSG_ERROR("Couldn't load image " << file.toStdString());
+        return QImage();
+    }
+
+    entry.original = entry.image.size();
+
+    if (size.isValid())
+        entry.image = entry.image.scaled(size, mode);
+
+    if (ori)
+        *ori = entry.original;
+
+    insert(key, entry, entry.image.sizeInBytes());
+    return entry.image;
+}
+
+/**
+ * @brief TImageCache::pin
+ * Loads an image and keeps it until unpin() is called as often as pin()
+ * was called. A pinned image is not removed by the least recently used
+ * strategy. This is used to keep the images prefetched for an object
+ * until the object is drawn.
+ * The pinned images count to the budget and the cache shrinks by their
+ * size. If they would exceed the budget, the image is not pinned and
+ * stays in the cache like any other image.
+ *
+ * @param file  The path and name of the image file.
+ * @param size  The wanted size.
+ * @param mode  Defines how the image is scaled.
+ * @return TRUE if the image was pinned. Only then unpin() must be called.
+ */
+bool TImageCache::pin(const QString& file, const QSize& size, Qt::AspectRatioMode mode)
+{
+    DECL_TRACER("TImageCache::pin(const QString& file, const QSize& size, Qt::AspectRatioMode mode)");
+
+    QString key = getKey(file, size, mode);
+
+    {
+        QMutexLocker locker(&mMutex);
+        QHash<QString, PINNED_t>::Iterator iter = mPinned.find(key);
+
+        if (iter != mPinned.end())
+        {
+            iter->count++;
+            return true;
+        }
+    }
+
+    PINNED_t pinned;
+    pinned.entry.image = getImage(file, size, mode, &pinned.entry.original);
+
+    if (pinned.entry.image.isNull())
+        return false;
+
+    QMutexLocker locker(&mMutex);
+    // Another thread may have pinned the image in the meantime.
+    QHash<QString, PINNED_t>::Iterator iter = mPinned.find(key);
+
+    if (iter != mPinned.end())
+    {
+        iter->count++;
+        return true;
+    }
+
+    if (!reserve(pinned.entry.image.sizeInBytes()))
+    {
+        MSG_DEBUG("The pinned images exceed the budget. Image " << file.toStdString() << " is not pinned.");
+        return false;
+    }
+
+    // The image is counted as pinned now and not twice.
+    remove(key);
+    pinned.count = 1;
+    mPinned.insert(key, pinned);
+    return true;
+}
+
+/**
+ * @brief TImageCache::unpin
+ * Releases an image pinned with pin(). If it isn't pinned any more, it
+ * goes back into the cache.
+ */
+void TImageCache::unpin(const QString& file, const QSize& size, Qt::AspectRatioMode mode)
+{
+    DECL_TRACER("TImageCache::unpin(const QString& file, const QSize& size, Qt::AspectRatioMode mode)");
+
+    QString key = getKey(file, size, mode);
+    QMutexLocker locker(&mMutex);
+    QHash<QString, PINNED_t>::Iterator iter = mPinned.find(key);
+
+    if (iter == mPinned.end())
+        return;
+
+    iter->count--;
+
+    if (iter->count > 0)
+        return;
+
+    qint64 bytes = iter->entry.image.sizeInBytes();
+    release(bytes);
+    insert(key, iter->entry, bytes);
+    mPinned.erase(iter);
+}
+
+/**
+ * @brief TImageCache::getKey
+ * Makes the key of an image. The file isn't looked at, so a lookup
+ * doesn't touch the disk. A changed file must be removed with
+ * invalidate().
+ */
+QString TImageCache::getKey(const QString& file, const QSize& size, Qt::AspectRatioMode mode)
+{
+    DECL_TRACER("TImageCache::getKey(const QString& file, const QSize& size, Qt::AspectRatioMode mode)");
+
+    return QString("%1|%2x%3|%4").arg(file).arg(size.width()).arg(size.height()).arg(size.isValid() ? mode : -1);
+}
+
+/**
+ * @brief TImageCache::getPixmap
+ * Same as getImage() but returns a pixmap. This must only be called from
+ * the GUI thread.
+ */
+QPixmap TImageCache::getPixmap(const QString& file, const QSize& size, Qt::AspectRatioMode mode, QSize *ori)
+{
+    DECL_TRACER("TImageCache::getPixmap(const QString& file, const QSize& size, Qt::AspectRatioMode mode, QSize *ori)");
+
+    QImage image = getImage(file, size, mode, ori);
+
+    if (image.isNull())
+        return QPixmap();
+
+    return QPixmap::fromImage(image);
+}
+
+/**
+ * @brief TImageCache::invalidate
+ * Removes all images of a file from the cache. This must be called if a
+ * file was imported, replaced, renamed or deleted. The file gets a new
+ * generation.
+ *
+ * @param file  The path and name of the image file.
+ */
+void TImageCache::invalidate(const QString& file)
+{
+    DECL_TRACER("TImageCache::invalidate(const QString& file)");
+
+    // All keys of a file start with its name. This is only called if a
+    // file was changed, so searching all keys is fast enough.
+    QString prefix = file + "|";
+    removeIf(prefix);
+    QMutexLocker locker(&mMutex);
+    mGenerations.insert(file, ++mGeneration);
+    mPinned.removeIf([this, &prefix](const QHash<QString, PINNED_t>::iterator& iter)
+    {
+        if (!iter.key().startsWith(prefix))
+            return false;
+
+        release(iter->entry.image.sizeInBytes());
+        return true;
+    });
+}
+
+/**
+ * @brief TImageCache::getGeneration
+ * Returns a number which changes every time invalidate() is called for a
+ * file. Images made from the file, like the rendered objects, use it in
+ * their key instead of looking at the file. The generations are kept
+ * when the cache is cleared, so they never repeat.
+ *
+ * @param file  The path and name of the image file.
+ * @return The generation or 0 if the file was never changed.
+ */
+quint64 TImageCache::getGeneration(const QString& file)
+{
+//    DECL_TRACER("TImageCache::getGeneration(const QString& file)");
+
+    QMutexLocker locker(&mMutex);
+    return mGenerations.value(file, 0);
+}
+
+void TImageCache::clear()
+{
+    DECL_TRACER("TImageCache::clear()");
+
+    TCostCache::clear();
+    QMutexLocker locker(&mMutex);
+
+    for (const PINNED_t& pinned : std::as_const(mPinned))
+        release(pinned.entry.image.sizeInBytes());
+
+    mPinned.clear();
+}
+
+void TImageCache::logStatistics()
+{
+    DECL_TRACER("TImageCache::logStatistics()");
+
+    qsizetype pinned = 0;
+
+    {
+        QMutexLocker locker(&mMutex);
+        pinned = mPinned.size();
+    }
+
+    TCostCache::logStatistics(QString("%1 pinned").arg(pinned));
+}
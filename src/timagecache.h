@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TIMAGECACHE_H
+#define TIMAGECACHE_H
+
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QString>
+#include <QSize>
+#include <QMutex>
+
+#include "tcostcache.h"
+
+namespace ImageCache
+{
+    typedef struct IMAGE_ENTRY_t
+    {
+        QImage image;           // The decoded and scaled image
+        QSize original;         // The size of the image in the file
+    }IMAGE_ENTRY_t;
+}
+
+/**
+ * @brief The TImageCache class
+ * A process wide cache of decoded images. The key is the path of the file
+ * and the requested size. This way the same image file is decoded and
+ * scaled only once, no matter how many buttons or list views show it.
+ * A lookup never touches the disk. Therefore every file which is
+ * imported, replaced, renamed or deleted must be removed with
+ * invalidate().
+ *
+ * The images are stored as QImage. Therefore the cache can be used from
+ * any thread. All methods are protected by a mutex.
+ * If the memory budget is exceeded, the least recently used images are
+ * removed. The budget is the image cache size of the preferences. The
+ * pinned images count to the budget too.
+ */
+class TImageCache : public TCostCache<ImageCache::IMAGE_ENTRY_t>
+{
+    public:
+        static TImageCache& Current();
+
+        QImage getImage(const QString& file, const QSize& size=QSize(), Qt::AspectRatioMode mode=Qt::IgnoreAspectRatio, QSize *ori=nullptr);
+        QPixmap getPixmap(const QString& file, const QSize& size=QSize(), Qt::AspectRatioMode mode=Qt::IgnoreAspectRatio, QSize *ori=nullptr);
+        bool pin(const QString& file, const QSize& size=QSize(), Qt::AspectRatioMode mode=Qt::IgnoreAspectRatio);
+        void unpin(const QString& file, const QSize& size=QSize(), Qt::AspectRatioMode mode=Qt::IgnoreAspectRatio);
+        void invalidate(const QString& file);
+        quint64 getGeneration(const QString& file);
+        void clear() override;
+        void logStatistics() override;
+
+    private:
+        TImageCache();
+
+        typedef ImageCache::IMAGE_ENTRY_t IMAGE_ENTRY_t;
+
+        typedef struct PINNED_t
+        {
+            IMAGE_ENTRY_t entry;    // The pinned image
+            int count{0};           // The number of times it was pinned
+        }PINNED_t;
+
+        static QString getKey(const QString& file, const QSize& size, Qt::AspectRatioMode mode);
+
+        QHash<QString, PINNED_t> mPinned;           // Images kept until they are unpinned
+        QHash<QString, quint64> mGenerations;       // Files changed while the program runs
+        quint64 mGeneration{0};                     // The last generation given to a file
+        QMutex mMutex;                              // Protects the pinned images and the generations
+};
+
+#endif // TIMAGECACHE_H
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <QFile>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QMutexLocker>
+
+#include "timageimporter.h"
+#include "timagecache.h"
+#include "tthumbnailstore.h"
+#include "terror.h"
+
+TImageImporter::TImageImporter(const QString& target, const QSize& iconSize, QObject *parent)
+    : QObject(parent),
+      mTarget(target),
+      mIconSize(iconSize)
+{
+    DECL_TRACER("TImageImporter::TImageImporter(const QString& target, const QSize& iconSize, QObject *parent)");
+}
+
+TImageImporter::~TImageImporter()
+{
+    DECL_TRACER("TImageImporter::~TImageImporter()");
+
+    mCanceled.storeRelaxed(1);
+    mPool.clear();
+    mPool.waitForDone();
+}
+
+/**
+ * @brief TImageImporter::start
+ * Starts to import the files. The method returns immediately. The
+ * results are delivered by the signal imported(). After the last file the
+ * signal finished() is emitted.
+ *
+ * @param files     The files with their full path.
+ */
+void TImageImporter::start(const QStringList& files)
+{
+    DECL_TRACER("TImageImporter::start(const QStringList& files)");
+
+    if (mRunning)
+    {
+        MSG_WARNING("An import is already running!");
+        return;
+    }
+
+    mCanceled.storeRelaxed(0);
+    mTotal = static_cast<int>(files.size());
+    mDone = 0;
+    mRunning = true;
+
+    if (files.isEmpty())
+    {
+        QMetaObject::invokeMethod(this, [this]() { deliver(); }, Qt::QueuedConnection);
+        return;
+    }
+
+    for (const QString& file : files)
+    {
+        mPool.start(QRunnable::create([this, file]()
+        {
+            if (mCanceled.loadRelaxed())
+                return;
+
+            addResult(importFile(file));
+        }));
+    }
+}
+
+/**
+ * @brief TImageImporter::cancel
+ * Cancels the import. The files not started yet are not imported. The
+ * files already imported are delivered before finished() is emitted.
+ */
+void TImageImporter::cancel()
+{
+    DECL_TRACER("TImageImporter::cancel()");
+
+    if (!mRunning)
+        return;
+
+    MSG_INFO("Import of images was canceled.");
+    mCanceled.storeRelaxed(1);
+    mPool.clear();
+    // Only the files currently in work are waited for.
+    mPool.waitForDone();
+    deliver();
+}
+
+/**
+ * @brief TImageImporter::importFile
+ * Runs on a worker thread. The file is copied into the images folder and
+ * the copy is decoded. This way the thumbnail is in the TThumbnailStore
+ * when the list of images asks for it. If the file is not a valid image, the
+ * copy is removed again.
+ *
+ * @param file  The file with its full path.
+ * @return The result of the import.
+ */
+TImageImporter::IMPORT_RESULT_t TImageImporter::importFile(const QString& file)
+{
+    DECL_TRACER("TImageImporter::importFile(const QString& file)");
+
+    IMPORT_RESULT_t result;
+    result.file = file;
+    result.name = QFileInfo(file).fileName();
+    QString target = mTarget + "/" + result.name;
+
+    // A file left over in the images folder, which is not registered, is
+    // replaced.
+    if (QFile::exists(target))
+    {
+        QFile::remove(target);
+        TImageCache::Current().invalidate(target);
+    }
+
+    QFile f(file);
+
+    if (!f.copy(target))
+    {
+        MSG_ERROR("Couldn't copy file " << file.toStdString() << " to " << target.toStdString() << ": " << f.errorString().toStdString());
+        result.error = f.errorString();
+        return result;
+    }
+
+    result.icon = TThumbnailStore::Current().getImage(target, mIconSize, &result.original);
+
+    if (result.icon.isNull() || result.original.isEmpty())
+    {
+        MSG_WARNING("File " << file.toStdString() << " is not a valid image!");
+        result.error = tr("Not a valid image");
+        result.icon = QImage();
+        QFile::remove(target);
+    }
+
+    return result;
+}
+
+void TImageImporter::addResult(const IMPORT_RESULT_t& result)
+{
+    DECL_TRACER("TImageImporter::addResult(const IMPORT_RESULT_t& result)");
+
+    QMutexLocker locker(&mMutex);
+    mPending.append(result);
+
+    // All results arriving until the GUI thread takes them are delivered
+    // together.
+    if (mScheduled)
+        return;
+
+    mScheduled = true;
+    QMetaObject::invokeMethod(this, [this]() { deliver(); }, Qt::QueuedConnection);
+}
+
+/**
+ * @brief TImageImporter::deliver
+ * Runs on the GUI thread and emits the results collected so far.
+ */
+void TImageImporter::deliver()
+{
+    DECL_TRACER("TImageImporter::deliver()");
+
+    if (!mRunning)
+        return;
+
+    QList<IMPORT_RESULT_t> results;
+
+    {
+        QMutexLocker locker(&mMutex);
+        results.swap(mPending);
+        mScheduled = false;
+    }
+
+    if (!results.isEmpty())
+    {
+        mDone += static_cast<int>(results.size());
+        emit imported(results);
+        emit progress(mDone, mTotal);
+    }
+
+    if (mDone >= mTotal || (mCanceled.loadRelaxed() && mPool.activeThreadCount() == 0))
+    {
+        mRunning = false;
+        emit finished();
+    }
+}
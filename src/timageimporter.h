@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TIMAGEIMPORTER_H
+#define TIMAGEIMPORTER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QImage>
+#include <QSize>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QMutex>
+
+/**
+ * @brief The TImageImporter class
+ * Imports image files into the temporary images folder of the project.
+ *
+ * Each file is copied, decoded, validated and scaled to an icon on a worker
+ * thread. The thumbnail is stored in the TThumbnailStore, so the list of
+ * images doesn't need to decode the file again. The results are collected
+ * and delivered in batches on the GUI thread by the signal imported().
+ * This way the model and the maps are updated only a few times, no matter
+ * how many files are imported.
+ *
+ * Files which are not valid images are removed from the images folder
+ * again.
+ */
+class TImageImporter : public QObject
+{
+    Q_OBJECT
+
+    public:
+        typedef struct IMPORT_RESULT_t
+        {
+            QString file;           // The file which was imported
+            QString name;           // The name of the file in the images folder
+            QImage icon;            // The icon of the image
+            QSize original;         // The size of the image
+            QString error;          // An error message if the import failed
+        }IMPORT_RESULT_t;
+
+        TImageImporter(const QString& target, const QSize& iconSize, QObject *parent=nullptr);
+        ~TImageImporter();
+
+        void start(const QStringList& files);
+        void cancel();
+        bool isRunning() const { return mRunning; }
+        bool wasCanceled() const { return mCanceled.loadRelaxed() != 0; }
+
+    signals:
+        void imported(const QList<TImageImporter::IMPORT_RESULT_t>& results);
+        void progress(int done, int total);
+        void finished();
+
+    private:
+        IMPORT_RESULT_t importFile(const QString& file);
+        void addResult(const IMPORT_RESULT_t& result);
+        void deliver();
+
+        QString mTarget;                        // The folder the files are copied to
+        QSize mIconSize;                        // The size of the icons
+        QThreadPool mPool;                      // Imports the files
+        QAtomicInt mCanceled{0};                // 1 = The import was canceled
+        QList<IMPORT_RESULT_t> mPending;        // Results not yet delivered
+        bool mScheduled{false};                 // TRUE = deliver() is already queued
+        QMutex mMutex;                          // Protects mPending and mScheduled
+        int mTotal{0};                          // The number of files to import
+        int mDone{0};                           // The number of files delivered
+        bool mRunning{false};                   // TRUE = An import is running
+};
+
+#endif // TIMAGEIMPORTER_H
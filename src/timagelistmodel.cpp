@@ -0,0 +1,342 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <QRunnable>
+#include <QThread>
+#include <QMutexLocker>
+
+#include <algorithm>
+
+#include "timagelistmodel.h"
+#include "tthumbnailstore.h"
+#include "trenderqueue.h"
+#include "tconfig.h"
+#include "terror.h"
+
+#define MAX_REQUESTS        256     // Maximum number of waiting requests
+#define MAX_WORKERS         4       // Maximum number of worker threads
+
+TImageListModel::TImageListModel(const QString& path, const QSize& iconSize, const QSize& gridSize, QObject *parent)
+    : QAbstractListModel(parent),
+      mPath(path),
+      mIconSize(iconSize),
+      mGridSize(gridSize),
+      mIcons("Icon cache", "icons", TConfig::Current().getIconCacheSize())
+{
+    DECL_TRACER("TImageListModel::TImageListModel(const QString& path, const QSize& iconSize, const QSize& gridSize, QObject *parent)");
+
+    mPool.setMaxThreadCount(qMin(MAX_WORKERS, QThread::idealThreadCount()));
+    mPlaceholder = TRenderQueue::getPlaceholder(iconSize);
+}
+
+TImageListModel::~TImageListModel()
+{
+    DECL_TRACER("TImageListModel::~TImageListModel()");
+
+    {
+        QMutexLocker locker(&mMutex);
+        mStack.clear();
+    }
+
+    mPool.waitForDone();
+}
+
+int TImageListModel::rowCount(const QModelIndex& parent) const
+{
+//    DECL_TRACER("TImageListModel::rowCount(const QModelIndex& parent) const");
+
+    if (parent.isValid())
+        return 0;
+
+    return static_cast<int>(mNames.size());
+}
+
+/**
+ * @brief TImageListModel::data
+ * Returns the data of an image. The size hint is always the grid size,
+ * so the view can make its layout without asking for the icons. If the
+ * icon is not loaded yet, it is requested and the placeholder is returned.
+ */
+QVariant TImageListModel::data(const QModelIndex& index, int role) const
+{
+//    DECL_TRACER("TImageListModel::data(const QModelIndex& index, int role) const");
+
+    if (!index.isValid() || index.row() < 0 || index.row() >= mNames.size())
+        return QVariant();
+
+    const QString& name = mNames[index.row()];
+
+    switch(role)
+    {
+        case Qt::DisplayRole:
+        case Qt::EditRole:
+            return name;
+
+        case Qt::DecorationRole:
+        {
+            ICON_t icon;
+
+            if (mIcons.get(name, &icon))
+                return icon.icon;
+
+            requestIcon(name);
+            return mPlaceholder;
+        }
+
+        case Qt::SizeHintRole:
+            return mGridSize;
+
+        case Qt::TextAlignmentRole:
+            return static_cast<int>(Qt::AlignHCenter | Qt::AlignBottom);
+
+        case Qt::ToolTipRole:
+        {
+            QSize size = mSizes.value(name);
+
+            if (size.isValid())
+                return QString("%1 (%2x%3)").arg(name).arg(size.width()).arg(size.height());
+
+            return name;
+        }
+    }
+
+    return QVariant();
+}
+
+bool TImageListModel::removeRows(int row, int count, const QModelIndex& parent)
+{
+    DECL_TRACER("TImageListModel::removeRows(int row, int count, const QModelIndex& parent)");
+
+    if (parent.isValid() || row < 0 || count < 1 || (row + count) > mNames.size())
+        return false;
+
+    beginRemoveRows(parent, row, row + count - 1);
+
+    for (int i = 0; i < count; ++i)
+    {
+        QString name = mNames.takeAt(row);
+        mIcons.remove(name);
+        mSizes.remove(name);
+        mRequested.remove(name);
+    }
+
+    endRemoveRows();
+    return true;
+}
+
+/**
+ * @brief TImageListModel::setImages
+ * Replaces all images. Nothing is loaded here.
+ *
+ * @param names     The names of the image files without path.
+ */
+void TImageListModel::setImages(const QStringList& names)
+{
+    DECL_TRACER("TImageListModel::setImages(const QStringList& names)");
+
+    beginResetModel();
+    mNames = names;
+    std::sort(mNames.begin(), mNames.end());
+    mIcons.clear();
+    mSizes.clear();
+    mRequested.clear();
+    endResetModel();
+}
+
+/**
+ * @brief TImageListModel::addImage
+ * Inserts an image at its sorted position. If the image exists already,
+ * its icon is replaced.
+ *
+ * @param name      The name of the image file without path.
+ * @param icon      Optional: The icon, if it is already known.
+ * @param original  Optional: The size of the image.
+ */
+void TImageListModel::addImage(const QString& name, const QPixmap& icon, const QSize& original)
+{
+    DECL_TRACER("TImageListModel::addImage(const QString& name, const QPixmap& icon, const QSize& original)");
+
+    int row = findRow(name);
+
+    if (row < 0)
+        row = insertRow(name);
+
+    if (!icon.isNull())
+    {
+        ICON_t entry;
+        entry.icon = icon;
+        entry.original = original;
+        mIcons.insert(name, entry, static_cast<qint64>(icon.width()) * icon.height() * icon.depth() / 8);
+    }
+    else
+        mIcons.remove(name);
+
+    if (original.isValid())
+        mSizes.insert(name, original);
+
+    emit dataChanged(index(row), index(row));
+}
+
+/**
+ * @brief TImageListModel::renameImage
+ * Renames an image and moves it to its new sorted position. The icon is
+ * loaded again from the renamed file.
+ *
+ * @param ori   The old name.
+ * @param tgt   The new name.
+ */
+void TImageListModel::renameImage(const QString& ori, const QString& tgt)
+{
+    DECL_TRACER("TImageListModel::renameImage(const QString& ori, const QString& tgt)");
+
+    int row = findRow(ori);
+
+    if (row < 0)
+        return;
+
+    QSize size = mSizes.value(ori);
+    removeRows(row, 1);
+    addImage(tgt, QPixmap(), size);
+}
+
+int TImageListModel::findRow(const QString& name) const
+{
+    DECL_TRACER("TImageListModel::findRow(const QString& name) const");
+
+    QStringList::const_iterator iter = std::lower_bound(mNames.cbegin(), mNames.cend(), name);
+
+    if (iter == mNames.cend() || *iter != name)
+        return -1;
+
+    return static_cast<int>(iter - mNames.cbegin());
+}
+
+QString TImageListModel::getName(int row) const
+{
+    DECL_TRACER("TImageListModel::getName(int row) const");
+
+    if (row < 0 || row >= mNames.size())
+        return QString();
+
+    return mNames[row];
+}
+
+int TImageListModel::insertRow(const QString& name)
+{
+    DECL_TRACER("TImageListModel::insertRow(const QString& name)");
+
+    int row = static_cast<int>(std::lower_bound(mNames.begin(), mNames.end(), name) - mNames.begin());
+    beginInsertRows(QModelIndex(), row, row);
+    mNames.insert(row, name);
+    endInsertRows();
+    return row;
+}
+
+/**
+ * @brief TImageListModel::requestIcon
+ * Puts the request for an icon on top of the stack. If there are too many
+ * requests, the oldest one is dropped. It is requested again if the item
+ * becomes visible again.
+ *
+ * @param name  The name of the image.
+ */
+void TImageListModel::requestIcon(const QString& name) const
+{
+    DECL_TRACER("TImageListModel::requestIcon(const QString& name) const");
+
+    if (mRequested.contains(name))
+        return;
+
+    mRequested.insert(name);
+
+    {
+        QMutexLocker locker(&mMutex);
+        mStack.append(name);
+
+        while (mStack.size() > MAX_REQUESTS)
+            mRequested.remove(mStack.takeFirst());
+    }
+
+    startWorker();
+}
+
+void TImageListModel::startWorker() const
+{
+    DECL_TRACER("TImageListModel::startWorker() const");
+
+    QMutexLocker locker(&mMutex);
+
+    if (mWorkers >= mPool.maxThreadCount())
+        return;
+
+    mWorkers++;
+    TImageListModel *model = const_cast<TImageListModel *>(this);
+
+    mPool.start(QRunnable::create([model]()
+    {
+        while (true)
+        {
+            QString name;
+
+            {
+                QMutexLocker locker(&model->mMutex);
+
+                if (model->mStack.isEmpty())
+                {
+                    model->mWorkers--;
+                    return;
+                }
+
+                name = model->mStack.takeLast();
+            }
+
+            QSize original;
+            QImage icon = TThumbnailStore::Current().getImage(model->mPath + "/" + name, model->mIconSize, &original);
+            QMetaObject::invokeMethod(model, [model, name, icon, original]() { model->onIconLoaded(name, icon, original); }, Qt::QueuedConnection);
+        }
+    }));
+}
+
+void TImageListModel::onIconLoaded(const QString& name, const QImage& icon, const QSize& original)
+{
+    DECL_TRACER("TImageListModel::onIconLoaded(const QString& name, const QImage& icon, const QSize& original)");
+
+    if (!mRequested.remove(name))
+        return;     // The image was removed or renamed in the meantime
+
+    int row = findRow(name);
+
+    if (row < 0)
+        return;
+
+    if (icon.isNull())
+    {
+        MSG_WARNING("Couldn't load the icon of " << name.toStdString());
+    }
+
+    // A file which is not an image gets an empty icon and is not requested
+    // again.
+    ICON_t entry;
+    entry.icon = icon.isNull() ? QPixmap() : QPixmap::fromImage(icon);
+    entry.original = original;
+    mIcons.insert(name, entry, icon.sizeInBytes());
+
+    if (original.isValid() && !original.isEmpty())
+        mSizes.insert(name, original);
+
+    emit dataChanged(index(row), index(row), { Qt::DecorationRole, Qt::ToolTipRole });
+}
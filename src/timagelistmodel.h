@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TIMAGELISTMODEL_H
+#define TIMAGELISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+#include <QPixmap>
+#include <QImage>
+#include <QSize>
+#include <QThreadPool>
+#include <QMutex>
+
+#include "tcostcache.h"
+
+/**
+ * @brief The TImageListModel class
+ * The model of the images in the resource manager.
+ *
+ * The model knows only the names of the images. It reports all rows at once
+ * without loading anything. The icon of an image is requested only when a
+ * view asks for it, which means the item is visible. Until the icon is
+ * decoded a placeholder is shown.
+ *
+ * The icons are decoded on worker threads. The requests are handled last
+ * in first out, so the items visible after scrolling are decoded first.
+ * Only the last requests are kept. Older requests are dropped and
+ * requested again as soon as the item becomes visible again.
+ * The icons are taken from the TThumbnailStore, so an image is decoded
+ * only once, even across sessions. The icons are kept in a cache with a
+ * limited size.
+ *
+ * The names are always sorted.
+ */
+class TImageListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    public:
+        TImageListModel(const QString& path, const QSize& iconSize, const QSize& gridSize, QObject *parent=nullptr);
+        ~TImageListModel();
+
+        int rowCount(const QModelIndex& parent=QModelIndex()) const override;
+        QVariant data(const QModelIndex& index, int role=Qt::DisplayRole) const override;
+        bool removeRows(int row, int count, const QModelIndex& parent=QModelIndex()) override;
+
+        void setImages(const QStringList& names);
+        void addImage(const QString& name, const QPixmap& icon=QPixmap(), const QSize& original=QSize());
+        void renameImage(const QString& ori, const QString& tgt);
+        int findRow(const QString& name) const;
+        QString getName(int row) const;
+
+    private:
+        typedef struct ICON_t
+        {
+            QPixmap icon;           // The icon or a null pixmap if the file is not an image
+            QSize original;         // The size of the image
+        }ICON_t;
+
+        void requestIcon(const QString& name) const;
+        void startWorker() const;
+        void onIconLoaded(const QString& name, const QImage& icon, const QSize& original);
+        int insertRow(const QString& name);
+
+        QString mPath;                              // The folder with the images
+        QSize mIconSize;                            // The size of the icons
+        QSize mGridSize;                            // The size of an item
+        QStringList mNames;                         // The sorted names of the images
+        QPixmap mPlaceholder;                       // Shown until the icon is loaded
+        mutable TCostCache<ICON_t> mIcons;          // The decoded icons
+        QHash<QString, QSize> mSizes;               // The original sizes known so far
+        mutable QSet<QString> mRequested;           // Icons requested but not loaded yet
+        mutable QStringList mStack;                 // The requests not yet started
+        mutable int mWorkers{0};                    // The number of running workers
+        mutable QThreadPool mPool;                  // Decodes the icons
+        mutable QMutex mMutex;                      // Protects mStack and mWorkers
+};
+
+#endif // TIMAGELISTMODEL_H
@@ -17,9 +17,11 @@
  */
 #include <QPixmap>
 #include <QPainter>
+#include <QtMath>
 
 #include "tlistviewmock.h"
 #include "tobjecthandler.h"
+#include "tmockcache.h"
 #include "terror.h"
 
 // Item layout --> 4 = vertical, image top; 2 = horizontal, image right; 1 = horizontal, image left
@@ -76,6 +78,13 @@ TListViewMock::~TListViewMock()
  *
  * Before this can be used, any or better all of the otions should have been
  * set. Otherwise it will use defaults.
+ *
+ * The mockup is composed of 3 layers: The filter line, one line of items and
+ * the alphabet scrollbar. Each layer is taken from the TMockCache and drawn
+ * only if it is not there. Because the key of a layer contains only the
+ * properties it depends on, changing for example the item height draws only
+ * one line of items again. This line is then repeated until the listview is
+ * full.
  */
 void TListViewMock::drawListview()
 {
@@ -100,61 +109,185 @@ void TListViewMock::drawListview()
         return;
     }
 
-    QPixmap pxSearch(":images/system-search.svg");      // Load a magnifying glass
     QPainter painter(mPixmap);                          // Initialize a painter for ouir pixmap
     painter.setClipRect(QRect(1, 1, mWidth - 2, mHeight - 2));  // Define a clipping region to avoid overwriting the frame
-    QPen frame(mBorderColor);                           // Define a pen to draw lines
-    frame.setStyle(Qt::SolidLine);                      // Solid lines for pen
-    frame.setWidth(2);                                  // Set line width to 2 pixel
     int yPos = 0;                                       // The Y position we start of
     // If there is a filter defined, draw it first on top of list
     if (mLvs)                                           // Filter?
     {
-        painter.setPen(frame);                          // Assign the pen for lines
-        painter.drawRect(2, 2, mWidth - 4, mLsh - 4);   // Draw a rectangle
-        painter.drawPixmap(3, 3, mLsh - 6, mLsh - 6, pxSearch); // Draw the preveously loaded pixmap. Scaling is done automatically.
-        mFont.setPixelSize(mLsh - 6);                   // Set the font size in pixels.
-        painter.setFont(mFont);                         // Assign the font to the painter
-        painter.drawText(QRect(6 + mLsh, 3, mWidth - mLsh - 6, mLsh - 6), "Search", QTextOption(Qt::AlignLeft | Qt::AlignVCenter));
+        painter.drawPixmap(0, 0, getFilterLayer());
         yPos = mLsh;                                    // Adjust the Y position
     }
 
-    while (yPos < mHeight)                              // Draw the lines of the listview
-        yPos = drawItem(yPos, &painter);                // Draw one line of the listview
+    if (mLvh > 0)
+    {
+        QPixmap item = getItemLayer();
+
+        while (yPos < mHeight)                          // Draw the lines of the listview
+        {
+            painter.drawPixmap(0, yPos, item);
+            yPos += mLvh;
+        }
+    }
 
     if (mLva)                                           // Alphabet scrollbar?
-    {
-        painter.setPen(frame);                          // Assign the pen to draw lines
-        yPos = 1;                                       // Reset the Y position
+        painter.drawPixmap(mWidth - 16, 0, getAlphabetLayer());
 
-        if (mLvs)                                       // Filter?
-            yPos += mLsh;                               // Adjust the Y position below the filter
+    painter.end();                                      // End painting
+}
+
+/**
+ * @brief TListViewMock::makeLayer
+ * Creates an empty, transparent layer with the device pixel ratio of the
+ * target pixmap.
+ *
+ * @param width     The width of the layer.
+ * @param height    The height of the layer.
+ * @return The layer.
+ */
+QPixmap TListViewMock::makeLayer(int width, int height)
+{
+    DECL_TRACER("TListViewMock::makeLayer(int width, int height)");
 
-        painter.drawLine(mWidth - 15, yPos, mWidth - 15, mHeight);
+    qreal dpr = mPixmap ? mPixmap->devicePixelRatio() : 1.0;
+    QPixmap layer(qMax(1, qCeil(width * dpr)), qMax(1, qCeil(height * dpr)));
+    layer.setDevicePixelRatio(dpr);
+    layer.fill(Qt::transparent);
+    return layer;
+}
 
-        QPen text(mTextColor);                          // Define a pen to draw text with the color for it
-        painter.setPen(text);                           // Assign the pen
+/**
+ * @brief TListViewMock::getFilterLayer
+ * Returns the search input line with the magnifying glass. It depends on
+ * the width, the filter height, the font and the colors only.
+ *
+ * @return The layer with a height of the filter.
+ */
+QPixmap TListViewMock::getFilterLayer()
+{
+    DECL_TRACER("TListViewMock::getFilterLayer()");
 
-        mFont.setPointSize(mFontSize);                  // Set the font size in points
-        QFontMetrics fm(mFont);                         // Define a QFontMetric to meassure characters
-        int aHeight = fm.boundingRect('A').height();    // Get the height of the letter 'A'
-        QTextOption tOption(Qt::AlignCenter);           // Define a text option with center alignment
-        tOption.setWrapMode(QTextOption::NoWrap);       // Disable wrapping
-        painter.setFont(mFont);                         // Assign the font
+    QFont font = mFont;
+    font.setPixelSize(qMax(1, mLsh - 6));               // Set the font size in pixels.
+    QString key = QString("filter|%1x%2|%3|%4|%5|%6").arg(mWidth).arg(mLsh).arg(font.key())
+                                                      .arg(mBorderColor.rgba(), 8, 16, QChar('0'))
+                                                      .arg(mTextColor.rgba(), 8, 16, QChar('0'))
+                                                      .arg(mPixmap->devicePixelRatio());
+    QPixmap layer;
 
-        for (char ch = 'A'; ch <= 'Z'; ++ch)            // Loop through the alphabet
-        {
-            QString letter(ch);                         // Make a string out of the character
-            QRect clip(mWidth - 13, yPos, 13, aHeight);
-            painter.drawText(clip, letter, tOption);
-            yPos += aHeight + 2;                        // Increase the Y for the next line
+    if (TMockCache::Current().get(key, &layer))
+        return layer;
 
-            if (yPos > mHeight)                         // If the next line would be out of the listview, stop here.
-                break;
-        }
+    layer = makeLayer(mWidth, mLsh);
+    QPixmap pxSearch(":images/system-search.svg");      // Load a magnifying glass
+    QPainter painter(&layer);
+    QPen frame(mBorderColor);                           // Define a pen to draw lines
+    frame.setStyle(Qt::SolidLine);                      // Solid lines for pen
+    frame.setWidth(2);                                  // Set line width to 2 pixel
+    painter.setPen(frame);                              // Assign the pen for lines
+    painter.drawRect(2, 2, mWidth - 4, mLsh - 4);       // Draw a rectangle
+    painter.drawPixmap(3, 3, mLsh - 6, mLsh - 6, pxSearch); // Draw the preveously loaded pixmap. Scaling is done automatically.
+    painter.setFont(font);                              // Assign the font to the painter
+    painter.drawText(QRect(6 + mLsh, 3, mWidth - mLsh - 6, mLsh - 6), "Search", QTextOption(Qt::AlignLeft | Qt::AlignVCenter));
+    painter.end();
+
+    TMockCache::Current().insert(key, layer);
+    return layer;
+}
+
+/**
+ * @brief TListViewMock::getItemLayer
+ * Returns one line of items. All lines of the mockup look the same,
+ * therefore the line is drawn only once by drawItem(). It depends on the
+ * item height, layout, components, columns, partitions, the font size and
+ * the colors. The fill colors are not part of the mockup.
+ *
+ * @return The layer with a height of 1 item plus the separator line.
+ */
+QPixmap TListViewMock::getItemLayer()
+{
+    DECL_TRACER("TListViewMock::getItemLayer()");
+
+    QFont font = mFont;
+    font.setPointSize(mFontSize);
+    QString key = QString("item|%1|%2|%3|%4|%5|%6|%7|%8|%9").arg(mWidth).arg(mLvh).arg(mLvl).arg(mLvc)
+                                                             .arg(mLvg).arg(mLhp).arg(mLvp).arg(mLva).arg(font.key());
+    key += QString("|%1|%2|%3").arg(mBorderColor.rgba(), 8, 16, QChar('0'))
+                               .arg(mTextColor.rgba(), 8, 16, QChar('0'))
+                               .arg(mPixmap->devicePixelRatio());
+    QPixmap layer;
+
+    if (TMockCache::Current().get(key, &layer))
+        return layer;
+
+    layer = makeLayer(mWidth, mLvh + 1);
+    QPainter painter(&layer);
+    drawItem(0, &painter);
+    painter.end();
+
+    TMockCache::Current().insert(key, layer);
+    return layer;
+}
+
+/**
+ * @brief TListViewMock::getAlphabetLayer
+ * Returns the alphabet scrollbar. It is 16 pixels wide and as high as the
+ * listview. It depends on the height, the filter, the font size and the
+ * colors.
+ *
+ * @return The layer.
+ */
+QPixmap TListViewMock::getAlphabetLayer()
+{
+    DECL_TRACER("TListViewMock::getAlphabetLayer()");
+
+    int yPos = 1;
+
+    if (mLvs)                                           // Filter?
+        yPos += mLsh;                                   // Adjust the Y position below the filter
+
+    QFont font = mFont;
+    font.setPointSize(mFontSize);                       // Set the font size in points
+    QString key = QString("alpha|%1|%2|%3|%4|%5|%6").arg(mHeight).arg(yPos).arg(font.key())
+                                                     .arg(mBorderColor.rgba(), 8, 16, QChar('0'))
+                                                     .arg(mTextColor.rgba(), 8, 16, QChar('0'))
+                                                     .arg(mPixmap->devicePixelRatio());
+    QPixmap layer;
+
+    if (TMockCache::Current().get(key, &layer))
+        return layer;
+
+    layer = makeLayer(16, mHeight);
+    QPainter painter(&layer);
+    QPen frame(mBorderColor);                           // Define a pen to draw lines
+    frame.setStyle(Qt::SolidLine);                      // Solid lines for pen
+    frame.setWidth(2);                                  // Set line width to 2 pixel
+    painter.setPen(frame);                              // Assign the pen to draw lines
+    painter.drawLine(1, yPos, 1, mHeight);
+
+    QPen text(mTextColor);                              // Define a pen to draw text with the color for it
+    painter.setPen(text);                               // Assign the pen
+
+    QFontMetrics fm(font);                              // Define a QFontMetric to meassure characters
+    int aHeight = fm.boundingRect('A').height();        // Get the height of the letter 'A'
+    QTextOption tOption(Qt::AlignCenter);               // Define a text option with center alignment
+    tOption.setWrapMode(QTextOption::NoWrap);           // Disable wrapping
+    painter.setFont(font);                              // Assign the font
+
+    for (char ch = 'A'; ch <= 'Z'; ++ch)                // Loop through the alphabet
+    {
+        QString letter(ch);                             // Make a string out of the character
+        QRect clip(3, yPos, 13, aHeight);
+        painter.drawText(clip, letter, tOption);
+        yPos += aHeight + 2;                            // Increase the Y for the next line
+
+        if (yPos > mHeight)                             // If the next line would be out of the listview, stop here.
+            break;
     }
 
-    painter.end();                                      // End painting
+    painter.end();
+    TMockCache::Current().insert(key, layer);
+    return layer;
 }
 
 /**
@@ -208,9 +341,9 @@ int TListViewMock::drawItem(int start, QPainter *painter)
     if (mLvg > 1)                   // More than 1 column?
         cellWidth /= mLvg;          // Calculate the width of 1 cell
 
-    // Draw the lower separator line
-    if ((start + mLvh) < mHeight)
-        painter->drawLine(1, start + mLvh, totalWidth, start + mLvh);
+    // Draw the lower separator line. It is clipped by the painter if it is
+    // below the listview.
+    painter->drawLine(1, start + mLvh, totalWidth, start + mLvh);
 
     int startX = 1;
 
@@ -65,6 +65,11 @@ class TListViewMock
         int drawItem(int start, QPainter *painter);
 
     private:
+        QPixmap makeLayer(int width, int height);
+        QPixmap getFilterLayer();
+        QPixmap getItemLayer();
+        QPixmap getAlphabetLayer();
+
         QPixmap *mPixmap{nullptr};
         bool mInternPixmap{false};
 
@@ -22,6 +22,7 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QFile>
+#include <QSet>
 #include <QtXml/QDomDocument>
 #include <QtXml/QDomElement>
 #include <QtXml/QDomNodeList>
@@ -67,6 +68,7 @@ void TMaps::addButton(Maps::MAP_TYPE type, int port, int channel, int bt, const
         return;
 
     Page::PAGE_t *page = TPageHandler::Current().getPage(pgnum);
+    TPageHandler::Current().ensureLoaded(page);
 
     if (!page || page->pageID <= 0)
     {
@@ -169,6 +171,7 @@ void TMaps::addBitmap(const QString& file, int id, int page, int bt, int st)
     }
 
     Page::PAGE_t *pg = TPageHandler::Current().getPage(page);
+    TPageHandler::Current().ensureLoaded(pg);
 
     if (!pg || pg->pageID <= 0)
     {
@@ -194,6 +197,40 @@ void TMaps::addBitmap(const QString& file, int id, int page, int bt, int st)
     mMap.map_bm.push_back(bm);
 }
 
+/**
+ * @brief TMaps::addBitmaps
+ * Adds a list of images as resources. In opposite to addBitmap() the files
+ * are not copied. They must be already in the temporary images folder.
+ * This is used by the import of images, which copies the files on worker
+ * threads and adds them here in batches.
+ *
+ * @param files     The names of the files without path.
+ */
+void TMaps::addBitmaps(const QStringList& files)
+{
+    DECL_TRACER("TMaps::addBitmaps(const QStringList& files)");
+
+    QSet<QString> existing;
+    vector<MAP_BM_T>::iterator iter;
+
+    for (iter = mMap.map_bm.begin(); iter != mMap.map_bm.end(); ++iter)
+    {
+        if (!iter->bt && !iter->pg && !iter->st)
+            existing.insert(iter->i);
+    }
+
+    for (const QString& file : files)
+    {
+        if (existing.contains(file))
+            continue;
+
+        MAP_BM_T bm;
+        bm.i = file;
+        mMap.map_bm.push_back(bm);
+        existing.insert(file);
+    }
+}
+
 void TMaps::removeBitmap(const QString& file)
 {
     DECL_TRACER("TMaps::removeBitmap(const QString& file)");
@@ -109,6 +109,7 @@ class TMaps
 
         void addButton(Maps::MAP_TYPE type, int port, int channel, int bt, const QString& btName, int pgnum);
         void addBitmap(const QString& file, int id, int page, int bt, int st);
+        void addBitmaps(const QStringList& files);
         void removeBitmap(const QString& file);
         void renameBitmap(const QString& ori, const QString& tgt);
         bool isBitmapUsed(const QString& file);
@@ -28,6 +28,7 @@
 #include "terror.h"
 #include "tobjecthandler.h"
 #include "tpagehandler.h"
+#include "tthumbnailstore.h"
 
 using std::stringstream;
 using std::hex;
@@ -149,12 +150,12 @@ STATE_TYPE getStateFromPageType(int pt)
 
 QPixmap sizeImage(const QSize& size, const QString& file, QSize *ori)
 {
-    QPixmap pm(file);
+    QImage image = TThumbnailStore::Current().getImage(file, size, ori);
 
-    if (ori)
-        *ori = pm.size();
+    if (image.isNull())
+        return QPixmap();
 
-    return QPixmap(pm.scaled(size, Qt::KeepAspectRatio));
+    return QPixmap::fromImage(image);
 }
 
 QString convertToUTF8(const QString& filename, bool fake)
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TMOCKCACHE_H
+#define TMOCKCACHE_H
+
+#include <QPixmap>
+#include <QString>
+
+#include "tcostcache.h"
+
+/**
+ * @brief The TMockCache class
+ * A process wide cache of the layers the mockups of list views and sub-page
+ * views are composed of. A mockup consists of many identical items. Each
+ * item, the filter line and the alphabet bar are drawn once into a layer
+ * and then only blitted. The key of a layer contains exactly the
+ * properties the layer depends on. If a property changes, only the layers
+ * depending on it are drawn again while all others are found in the cache.
+ *
+ * The layers are stored as QPixmap. Therefore the cache must only be used
+ * from the GUI thread.
+ */
+class TMockCache : public TCostCache<QPixmap>
+{
+    public:
+        static TMockCache& Current();
+
+        void insert(const QString& key, const QPixmap& pm);
+
+    private:
+        TMockCache();
+};
+
+#endif // TMOCKCACHE_H
@@ -15,16 +15,29 @@
  * along with this program; if not, write to the Free Software Foundation,
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
  */
+#include <QStringList>
+
+#include <atomic>
 
 #include "tobjecthandler.h"
 #include "tdrawobject.h"
+#include "tresizablewidget.h"
+#include "tobjecttable.h"
+#include "tstringpool.h"
+#include "trenderedcache.h"
+#include "timagecache.h"
+#include "tconfmain.h"
 #include "terror.h"
 
 using namespace ObjHandler;
 
+static std::atomic<quint64> _serial{0};
+
 TObjectHandler::TObjectHandler()
 {
     DECL_TRACER("TObjectHandler::TObjectHandler()");
+
+    mSerial = ++_serial;
 }
 
 TObjectHandler::TObjectHandler(ObjHandler::BUTTONTYPE bt, int num, const QString& name)
@@ -34,6 +47,60 @@ TObjectHandler::TObjectHandler(ObjHandler::BUTTONTYPE bt, int num, const QString
     mObject.type = bt;
     mObject.bi = num;
     mObject.na = name;
+    mSerial = ++_serial;
+}
+
+TObjectHandler::~TObjectHandler()
+{
+    DECL_TRACER("TObjectHandler::~TObjectHandler()");
+
+    if (mTable)
+        mTable->remove(this);
+}
+
+void TObjectHandler::setZOrder(int zo)
+{
+    DECL_TRACER("TObjectHandler::setZOrder(int zo)");
+
+    mObject.zo = zo;
+
+    if (mTable)
+        mTable->update(this);
+}
+
+void TObjectHandler::setObjectType(ObjHandler::BUTTONTYPE btype)
+{
+    DECL_TRACER("TObjectHandler::setObjectType(ObjHandler::BUTTONTYPE btype)");
+
+    invalidate();
+    mObject.type = btype;
+
+    if (mTable)
+        mTable->update(this);
+}
+
+void TObjectHandler::setObject(const ObjHandler::TOBJECT_t& object)
+{
+    DECL_TRACER("TObjectHandler::setObject(const ObjHandler::TOBJECT_t& object)");
+
+    invalidate();
+    mObject = object;
+
+    if (mTable)
+        mTable->update(this);
+}
+
+void TObjectHandler::setSize(const QRect& rect)
+{
+    DECL_TRACER("TObjectHandler::setSize(const QRect& rect)");
+
+    mObject.lt = rect.left();
+    mObject.tp = rect.top();
+    mObject.wt = rect.width();
+    mObject.ht = rect.height();
+
+    if (mTable)
+        mTable->update(this);
 }
 
 /**
@@ -221,6 +288,7 @@ void TObjectHandler::setSrToAllInstances(const SR_T& sr)
 {
     DECL_TRACER("TObjectHandler::setSrToAllInstances(const SR_T& sr)");
 
+    invalidate();
     QList<SR_T>::Iterator iter;
 
     for (iter = mObject.sr.begin(); iter != mObject.sr.end(); ++iter)
@@ -258,14 +326,134 @@ void TObjectHandler::setSrToAllInstances(const SR_T& sr)
     }
 }
 
+/**
+ * @brief TObjectHandler::drawObject
+ * Draws an instance of the object into the widget. The finished image of
+ * each instance is kept. As long as no property of the object changed and
+ * the size is the same, the kept image is set to the widget without
+ * drawing it again.
+ * A subpage view is always drawn because it depends on the subpage sets
+ * and the size of the widget.
+ *
+ * @param widget    The widget to show the object.
+ * @param instance  The instance to draw.
+ * @return TRUE if there was an error.
+ */
 bool TObjectHandler::drawObject(TResizableWidget *widget, int instance)
 {
     DECL_TRACER("TObjectHandler::drawObject(TResizableWidget *widget, int instance)");
 
+    if (!widget)
+    {
+        MSG_ERROR("Can't draw object " << mObject.bi << " because there is no widget!");
+        return true;
+    }
+
+    QPixmap pixmap = render(instance, widget);
+
+    if (pixmap.isNull())
+        return true;
+
+    widget->setPixmap(pixmap);
+    return false;
+}
+
+/**
+ * @brief TObjectHandler::render
+ * Returns the image of an instance of the object. This works without a
+ * widget and is used to draw pages offscreen. The image is taken from the
+ * kept images if possible.
+ *
+ * @param instance  The instance to draw.
+ * @param widget    Optional: The widget the object is shown in.
+ * @return The image of the object or a null pixmap on error.
+ */
+QPixmap TObjectHandler::render(int instance, TResizableWidget *widget)
+{
+    DECL_TRACER("TObjectHandler::render(int instance, TResizableWidget *widget)");
+
+    bool cacheable = mObject.type != SUBPAGE_VIEW;
+    QString key;
+
+    if (cacheable)
+    {
+        key = getRenderKey(instance);
+        QPixmap pixmap;
+
+        if (TRenderedCache::Current().get(key, &pixmap))
+        {
+            MSG_DEBUG("Using rendered image of instance " << instance << " of object " << mObject.bi);
+            return pixmap;
+        }
+    }
+
     TDrawObject drawObject(this, widget);
     drawObject.draw(instance);
-    return drawObject.haveError();
-    // TODO: Add code to save images so they must not be drawn new every time.
+
+    if (drawObject.haveError())
+        return QPixmap();
+
+    if (cacheable)
+        TRenderedCache::Current().insert(key, drawObject.getPixmap());
+
+    return drawObject.getPixmap();
+}
+
+/**
+ * @brief TObjectHandler::getRenderKey
+ * Makes the key of the rendered image of an instance. It contains the
+ * version and the size of the object and a stamp of the image files the
+ * instance is drawn from. The stamp is made of the generations
+ * TImageCache keeps for the files. It changes if one of the files is
+ * replaced, e.g. by importing an image with the same name. The files are
+ * not looked at, so this is cheap enough for every paint.
+ *
+ * @param instance  The instance.
+ * @return The key for TRenderedCache.
+ */
+QString TObjectHandler::getRenderKey(int instance)
+{
+    DECL_TRACER("TObjectHandler::getRenderKey(int instance)");
+
+    QStringList files;
+
+    for (int i = 0; i < mObject.sr.size(); ++i)
+    {
+        // A bargraph is drawn from the images of both states
+        if (i != instance && !((mObject.type == BARGRAPH || mObject.type == MULTISTATE_BARGRAPH) && i < 2))
+            continue;
+
+        if (!mObject.sr[i].mi.isEmpty())
+            files.append(mObject.sr[i].mi);
+
+        for (const BITMAPS_t& bm : mObject.sr[i].bitmaps)
+        {
+            if (!bm.fileName.isEmpty())
+                files.append(bm.fileName);
+        }
+    }
+
+    size_t stamp = 0;
+    QString path = TConfMain::Current().getPathTemporary() + "/images/";
+
+    for (const QString& file : files)
+        stamp = qHashMulti(stamp, TImageCache::Current().getGeneration(path + file));
+
+    return QString("%1|%2|%3|%4x%5|%6").arg(mSerial).arg(instance).arg(mVersion).arg(mObject.wt).arg(mObject.ht).arg(stamp);
+}
+
+/**
+ * @brief TObjectHandler::invalidate
+ * Marks all rendered images of the object as outdated. This is called by
+ * every setter changing the look of the object. The outdated images are
+ * no longer found and are removed from TRenderedCache as soon as the
+ * memory is needed.
+ */
+void TObjectHandler::invalidate()
+{
+    DECL_TRACER("TObjectHandler::invalidate()");
+
+    mVersion++;
 }
 
 // Getter / Setter
@@ -273,6 +461,7 @@ void TObjectHandler::setDrawOrder(const QString& _do, int instance)
 {
     DECL_TRACER("TObjectHandler::setDrawOrder(const QString& _do, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -306,6 +495,7 @@ void TObjectHandler::setBorder(const QString& bs, int instance)
 {
     DECL_TRACER("TObjectHandler::setBorder(const QString& bs, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -339,6 +529,7 @@ void TObjectHandler::setChameleonImage(const QString& mi, int instance)
 {
     DECL_TRACER("TObjectHandler::setChameleonImage(const QString& mi, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -372,6 +563,7 @@ void TObjectHandler::setBorderColor(const QColor& cb, int instance)
 {
     DECL_TRACER("TObjectHandler::setBorderColor(const QColor& cb, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -405,6 +597,7 @@ void TObjectHandler::setGradientFillType(const QString& ft, int instance)
 {
     DECL_TRACER("TObjectHandler::setGradientFillType(const QString& ft, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -438,6 +631,7 @@ void TObjectHandler::setFillColor(const QColor& cf, int instance)
 {
     DECL_TRACER("TObjectHandler::setFillColor(const QColor& cf, int instance)");
 
+    invalidate();
     MSG_DEBUG("Setting color " << cf.name(QColor::HexArgb).toStdString() << " on instance " << instance);
 
     if (instance < 0 || instance >= mObject.sr.size())
@@ -473,6 +667,7 @@ void TObjectHandler::setTextColor(const QColor& ct, int instance)
 {
     DECL_TRACER("TObjectHandler::setTextColor(const QColor& ct, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -506,6 +701,7 @@ void TObjectHandler::setTextEffectColor(const QColor& ec, int instance)
 {
     DECL_TRACER("TObjectHandler::setTextEffectColor(const QColor& ec, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -539,6 +735,7 @@ void TObjectHandler::setBitmaps(const QList<BITMAPS_t>& bitmaps, int instance)
 {
     DECL_TRACER("TObjectHandler::setBitmaps(const QList<BITMAPS_t>& bitmaps, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -575,6 +772,7 @@ void TObjectHandler::setGradientColors(const QList<QColor>& colors, int instance
 {
     DECL_TRACER("TObjectHandler::setGradientColors(const QList<QColor>& colors, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -611,6 +809,7 @@ void TObjectHandler::setGradientRadius(int gr, int instance)
 {
     DECL_TRACER("TObjectHandler::setGradientRadius(int gr, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -644,6 +843,7 @@ void TObjectHandler::setGradientCenterX(int gx, int instance)
 {
     DECL_TRACER("TObjectHandler::setGradientCenterX(int gx, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -677,6 +877,7 @@ void TObjectHandler::setGradientCenterY(int gy, int instance)
 {
     DECL_TRACER("TObjectHandler::setGradientCenterY(int gy, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -710,6 +911,7 @@ void TObjectHandler::setSound(const QString& sd, int instance)
 {
     DECL_TRACER("TObjectHandler::setSound(const QString& sd, int instance)");
 
+    // A sound doesn't change the look. The rendered images stay valid.
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -743,6 +945,7 @@ void TObjectHandler::setDynamic(bool dynamic, int instance)
 {
     DECL_TRACER("TObjectHandler::setDynamic(bool dynamic, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -776,6 +979,7 @@ void TObjectHandler::setExtGraphicIndex(int sb, int instance)
 {
     DECL_TRACER("TObjectHandler::setExtGraphicIndex(int sb, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -809,6 +1013,7 @@ void TObjectHandler::setText(const QString& te, int instance)
 {
     DECL_TRACER("TObjectHandler::setText(const QString& te, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -842,6 +1047,7 @@ void TObjectHandler::setTextOrientation(ORIENTATION jt, int instance)
 {
     DECL_TRACER("TObjectHandler::setTextOrientation(ORIENTATION jt, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -875,6 +1081,7 @@ void TObjectHandler::setTextAbsoluteX(int tx, int instance)
 {
     DECL_TRACER("TObjectHandler::setTextAbsoluteX(int tx, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -908,6 +1115,7 @@ void TObjectHandler::setTextAbsoluteY(int ty, int instance)
 {
     DECL_TRACER("TObjectHandler::setTextAbsoluteY(int ty, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -941,6 +1149,7 @@ void TObjectHandler::setFontFile(const QString& ff, int instance)
 {
     DECL_TRACER("TObjectHandler::setFontFile(const QString& ff, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -974,6 +1183,7 @@ void TObjectHandler::setFontSize(int fs, int instance)
 {
     DECL_TRACER("TObjectHandler::setFontSize(int fs, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -1007,6 +1217,7 @@ void TObjectHandler::setWordWrap(int ww, int instance)
 {
     DECL_TRACER("TObjectHandler::setWordWrap(int ww, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -1040,6 +1251,7 @@ void TObjectHandler::setTextEffect(int et, int instance)
 {
     DECL_TRACER("TObjectHandler::setTextEffect(int et, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -1073,6 +1285,7 @@ void TObjectHandler::setOverallOpacity(int oo, int instance)
 {
     DECL_TRACER("TObjectHandler::setOverallOpacity(int oo, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -1106,6 +1319,7 @@ void TObjectHandler::setMarqueeType(int md, int instance)
 {
     DECL_TRACER("TObjectHandler::setMarqueeType(int md, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -1139,6 +1353,7 @@ void TObjectHandler::setMarqueeEnabled(int mr, int instance)
 {
     DECL_TRACER("TObjectHandler::setMarqueeEnabled(int mr, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -1172,6 +1387,7 @@ void TObjectHandler::setMarqueeSpeed(int ms, int instance)
 {
     DECL_TRACER("TObjectHandler::setMarqueeSpeed(int ms, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -1205,6 +1421,7 @@ void TObjectHandler::setVideoFill(const QString& vf, int instance)
 {
     DECL_TRACER("TObjectHandler::setVideoFill(const QString& vf, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -1238,6 +1455,7 @@ void TObjectHandler::setStreamingSource(const QString& dv, int instance)
 {
     DECL_TRACER("TObjectHandler::setStreamingSource(const QString& dv, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -1271,6 +1489,7 @@ void TObjectHandler::setSubPageLayoutColor(const QColor& color, int instance)
 {
     DECL_TRACER("TObjectHandler::setSubPageLayoutColor(const QColor& color, int instance)");
 
+    invalidate();
     if (instance < 0 || instance >= mObject.sr.size())
     {
         for (int i = 0; i < mObject.sr.size(); ++i)
@@ -1331,7 +1550,8 @@ bool TObjectHandler::compareBitmaps(const QList<BITMAPS_t>& bm1, const QList<BIT
 
     for (int i = 0; i < bm1.size(); ++i)
     {
-        if (bm1[i].fileName != bm2[i].fileName)
+        // Interned file names share their data; compare the content only if not.
+        if (!TStringPool::isSame(bm1[i].fileName, bm2[i].fileName) && bm1[i].fileName != bm2[i].fileName)
             return false;
         else if (bm1[i].dynamic != bm2[i].dynamic)
             return false;
@@ -478,6 +478,7 @@ namespace ObjHandler
 };
 
 class TResizableWidget;
+class TObjectTable;
 
 /**
  * @brief The TObjectHandler class
@@ -494,29 +495,29 @@ class TObjectHandler
     public:
         TObjectHandler();
         TObjectHandler(ObjHandler::BUTTONTYPE bt, int num, const QString& name);
+        ~TObjectHandler();
 
         int getButtonIndex() { return mObject.bi; }
         QString getButtonName() { return mObject.na; }
         int getZOrder() { return mObject.zo; }
-        void setZOrder(int zo) { mObject.zo = zo; }
-        void setObjectType(ObjHandler::BUTTONTYPE btype) { mObject.type = btype; }
+        void setZOrder(int zo);
+        void setObjectType(ObjHandler::BUTTONTYPE btype);
         ObjHandler::BUTTONTYPE getType() { return mObject.type; }
         void setObject(TCanvasWidget *w) { mObject.baseObject.widget = w; }
-        void setObject(const ObjHandler::TOBJECT_t& object) { mObject = object; }
+        void setObject(const ObjHandler::TOBJECT_t& object);
+        void setTable(TObjectTable *table) { mTable = table; }
+        TObjectTable *getTable() { return mTable; }
         void setSrToAllInstances(const ObjHandler::SR_T& sr);
-        ObjHandler::TOBJECT_t& getObject() { return mObject; }
+        const ObjHandler::TOBJECT_t& getObject() const { return mObject; }
         TCanvasWidget *getObjectWidget() { return mObject.baseObject.widget; }
         static int getButtonTypeIndex(ObjHandler::BUTTONTYPE bt);
         ObjHandler::SR_T getSrCommon();
         bool drawObject(TResizableWidget *widget, int instance);
+        QPixmap render(int instance, TResizableWidget *widget=nullptr);
+        void invalidate();
+        quint64 getVersion() { return mVersion; }
 
-        inline void setSize(const QRect& rect)
-        {
-            mObject.lt = rect.left();
-            mObject.tp = rect.top();
-            mObject.wt = rect.width();
-            mObject.ht = rect.height();
-        }
+        void setSize(const QRect& rect);
 
         QRect getSize();
         ObjHandler::SR_T getSr(int number);
@@ -618,7 +619,12 @@ class TObjectHandler
 
     private:
         bool compareBitmaps(const QList<ObjHandler::BITMAPS_t>& bm1, const QList<ObjHandler::BITMAPS_t>& bm2);
+        QString getRenderKey(int instance);
+
         ObjHandler::TOBJECT_t mObject;
+        TObjectTable *mTable{nullptr};      // The geometry table of the page, if any
+        quint64 mVersion{1};                // Incremented on every change of the look
+        quint64 mSerial{0};                 // Unique number of this object; part of the key of the rendered images
 };
 
 #endif // TOBJECTHANDLER_H
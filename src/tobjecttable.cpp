@@ -0,0 +1,353 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <algorithm>
+#include <numeric>
+
+#include "tobjecttable.h"
+#include "terror.h"
+
+TObjectTable::TObjectTable()
+{
+    DECL_TRACER("TObjectTable::TObjectTable()");
+}
+
+TObjectTable::~TObjectTable()
+{
+    DECL_TRACER("TObjectTable::~TObjectTable()");
+
+    clear();
+}
+
+/**
+ * @brief TObjectTable::clear
+ * Removes all rows from the table and unregisters the table from all
+ * object handlers.
+ */
+void TObjectTable::clear()
+{
+    DECL_TRACER("TObjectTable::clear()");
+
+    for (TObjectHandler *obj : mHandler)
+        obj->setTable(nullptr);
+
+    mHandler.clear();
+    mBi.clear();
+    mLeft.clear();
+    mTop.clear();
+    mWidth.clear();
+    mHeight.clear();
+    mZOrder.clear();
+    mHidden.clear();
+    mType.clear();
+    mRows.clear();
+    mBiRows.clear();
+    mIndex.clear();
+}
+
+/**
+ * @brief TObjectTable::rebuild
+ * Fills the table with the objects of a page. Any previous content is
+ * removed.
+ *
+ * @param objects   The list of the objects of a page.
+ */
+void TObjectTable::rebuild(const QList<TObjectHandler *>& objects)
+{
+    DECL_TRACER("TObjectTable::rebuild(const QList<TObjectHandler *>& objects)");
+
+    clear();
+    qsizetype count = objects.size();
+    mHandler.reserve(count);
+    mBi.reserve(count);
+    mLeft.reserve(count);
+    mTop.reserve(count);
+    mWidth.reserve(count);
+    mHeight.reserve(count);
+    mZOrder.reserve(count);
+    mHidden.reserve(count);
+    mType.reserve(count);
+    mRows.reserve(count);
+    mBiRows.reserve(count);
+
+    for (TObjectHandler *obj : objects)
+        append(obj);
+}
+
+/**
+ * @brief TObjectTable::append
+ * Appends an object handler to the table and registers the table in the
+ * handler. If the handler is already part of the table, its row is only
+ * updated.
+ *
+ * @param object    The object handler to add.
+ */
+void TObjectTable::append(TObjectHandler *object)
+{
+    DECL_TRACER("TObjectTable::append(TObjectHandler *object)");
+
+    if (!object)
+        return;
+
+    if (mRows.contains(object))
+    {
+        update(object);
+        return;
+    }
+
+    qsizetype row = mHandler.size();
+    mHandler.append(object);
+    mBi.append(object->getButtonIndex());
+    mLeft.append(0);
+    mTop.append(0);
+    mWidth.append(0);
+    mHeight.append(0);
+    mZOrder.append(0);
+    mHidden.append(0);
+    mType.append(ObjHandler::NONE);
+    mRows.insert(object, row);
+    setRow(row, object);
+    object->setTable(this);
+}
+
+/**
+ * @brief TObjectTable::remove
+ * Removes an object handler from the table. The last row is moved into
+ * the place of the removed one, so the order of the rows is not stable.
+ *
+ * @param object    The object handler to remove.
+ */
+void TObjectTable::remove(TObjectHandler *object)
+{
+    DECL_TRACER("TObjectTable::remove(TObjectHandler *object)");
+
+    if (!object || !mRows.contains(object))
+        return;
+
+    qsizetype row = mRows.take(object);
+    qsizetype last = mHandler.size() - 1;
+    mIndex.remove(mBi[row]);
+    mBiRows.remove(mBi[row]);
+
+    if (row != last)
+    {
+        mHandler[row] = mHandler[last];
+        mBi[row] = mBi[last];
+        mLeft[row] = mLeft[last];
+        mTop[row] = mTop[last];
+        mWidth[row] = mWidth[last];
+        mHeight[row] = mHeight[last];
+        mZOrder[row] = mZOrder[last];
+        mHidden[row] = mHidden[last];
+        mType[row] = mType[last];
+        mRows[mHandler[row]] = row;
+        mBiRows[mBi[row]] = row;
+    }
+
+    mHandler.removeLast();
+    mBi.removeLast();
+    mLeft.removeLast();
+    mTop.removeLast();
+    mWidth.removeLast();
+    mHeight.removeLast();
+    mZOrder.removeLast();
+    mHidden.removeLast();
+    mType.removeLast();
+    object->setTable(nullptr);
+}
+
+/**
+ * @brief TObjectTable::update
+ * Copies the current values of an object handler into its row. This is
+ * called by the object handler whenever one of the values in the table
+ * changes.
+ *
+ * @param object    The object handler which changed.
+ */
+void TObjectTable::update(TObjectHandler *object)
+{
+    DECL_TRACER("TObjectTable::update(TObjectHandler *object)");
+
+    QHash<TObjectHandler *, qsizetype>::ConstIterator iter = mRows.constFind(object);
+
+    if (iter == mRows.constEnd())
+        return;
+
+    setRow(iter.value(), object);
+}
+
+/**
+ * @brief TObjectTable::getRow
+ * Searches for the row of the object with the button index \b bi.
+ *
+ * @param bi    The button index.
+ * @return If the object was found, the row is returned. Otherwise -1.
+ */
+int TObjectTable::getRow(int bi) const
+{
+    DECL_TRACER("TObjectTable::getRow(int bi) const");
+
+    return static_cast<int>(mBiRows.value(bi, -1));
+}
+
+int TObjectTable::getMaxButtonIndex() const
+{
+    DECL_TRACER("TObjectTable::getMaxButtonIndex() const");
+
+    if (mBi.empty())
+        return 0;
+
+    return *std::max_element(mBi.constBegin(), mBi.constEnd());
+}
+
+/**
+ * @brief TObjectTable::getZOrdered
+ * Returns the object handlers sorted by their z-order, starting with the
+ * bottom most object. Only the z-order column is read for sorting.
+ *
+ * @return The list of handlers in drawing order.
+ */
+QList<TObjectHandler *> TObjectTable::getZOrdered() const
+{
+    DECL_TRACER("TObjectTable::getZOrdered() const");
+
+    QList<qsizetype> rows(mHandler.size());
+    std::iota(rows.begin(), rows.end(), 0);
+    std::stable_sort(rows.begin(), rows.end(), [this](qsizetype a, qsizetype b) { return mZOrder[a] < mZOrder[b]; });
+
+    QList<TObjectHandler *> list;
+    list.reserve(rows.size());
+
+    for (qsizetype row : rows)
+        list.append(mHandler[row]);
+
+    return list;
+}
+
+/**
+ * @brief TObjectTable::getObjectAt
+ * Searches for the top most object at the position \b pt. Only the
+ * objects in the cell of the spatial index containing the point are
+ * tested.
+ *
+ * @param pt            The position on the page.
+ * @param visibleOnly   TRUE = hidden objects are ignored.
+ * @return If an object was found, the button index is returned.
+ * Otherwise 0 is returned.
+ */
+int TObjectTable::getObjectAt(const QPoint& pt, bool visibleOnly) const
+{
+    DECL_TRACER("TObjectTable::getObjectAt(const QPoint& pt, bool visibleOnly) const");
+
+    int bi = 0;
+    int zo = -1;
+    const int x = pt.x();
+    const int y = pt.y();
+    const QList<int> candidates = mIndex.query(pt);
+
+    for (int id : candidates)
+    {
+        qsizetype i = mBiRows.value(id, -1);
+
+        if (i < 0 || (visibleOnly && mHidden[i]) || x < mLeft[i] || y < mTop[i] ||
+            x >= mLeft[i] + mWidth[i] || y >= mTop[i] + mHeight[i])
+            continue;
+
+        if (mZOrder[i] >= zo)
+        {
+            zo = mZOrder[i];
+            bi = mBi[i];
+        }
+    }
+
+    return bi;
+}
+
+/**
+ * @brief TObjectTable::getObjectsIn
+ * Searches for all objects intersecting the area \b rect. Only the
+ * objects in the cells of the spatial index covered by the area are
+ * tested.
+ *
+ * @param rect          An area of the page.
+ * @param visibleOnly   TRUE = hidden objects are ignored.
+ * @return The button indexes of the objects sorted by their z-order,
+ * starting with the bottom most object.
+ */
+QList<int> TObjectTable::getObjectsIn(const QRect& rect, bool visibleOnly) const
+{
+    DECL_TRACER("TObjectTable::getObjectsIn(const QRect& rect, bool visibleOnly) const");
+
+    const QList<int> candidates = mIndex.query(rect);
+    QList<qsizetype> rows;
+    rows.reserve(candidates.size());
+
+    for (int id : candidates)
+    {
+        qsizetype i = mBiRows.value(id, -1);
+
+        if (i < 0 || (visibleOnly && mHidden[i]) || !rect.intersects(getRect(i)))
+            continue;
+
+        rows.append(i);
+    }
+
+    std::stable_sort(rows.begin(), rows.end(), [this](qsizetype a, qsizetype b) { return mZOrder[a] < mZOrder[b]; });
+    QList<int> list;
+    list.reserve(rows.size());
+
+    for (qsizetype row : rows)
+        list.append(mBi[row]);
+
+    return list;
+}
+
+void TObjectTable::setRow(qsizetype row, TObjectHandler *object)
+{
+    DECL_TRACER("TObjectTable::setRow(qsizetype row, TObjectHandler *object)");
+
+    const ObjHandler::TOBJECT_t& obj = object->getObject();
+    qsizetype other = mBiRows.value(obj.bi, -1);
+
+    // Another handler with the same button index replaces the old one.
+    // Its row is removed first, otherwise both rows would share the
+    // entries in the maps and in the spatial index.
+    if (other >= 0 && other != row)
+    {
+        MSG_WARNING("Button index " << obj.bi << " is already in the table. Replacing the old object.");
+        remove(mHandler[other]);
+        // Removing a row moves the last row into its place.
+        row = mRows.value(object);
+    }
+
+    if (mBi[row] != obj.bi)
+    {
+        mIndex.remove(mBi[row]);
+        mBiRows.remove(mBi[row]);
+    }
+
+    mBi[row] = obj.bi;
+    mLeft[row] = obj.lt;
+    mTop[row] = obj.tp;
+    mWidth[row] = obj.wt;
+    mHeight[row] = obj.ht;
+    mZOrder[row] = obj.zo;
+    mHidden[row] = obj.hd ? 1 : 0;
+    mType[row] = obj.type;
+    mBiRows.insert(obj.bi, row);
+    mIndex.insert(obj.bi, QRect(obj.lt, obj.tp, obj.wt, obj.ht));
+}
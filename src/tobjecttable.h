@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TOBJECTTABLE_H
+#define TOBJECTTABLE_H
+
+#include <QList>
+#include <QHash>
+#include <QRect>
+#include <QPoint>
+
+#include "tobjecthandler.h"
+#include "tspatialindex.h"
+
+/**
+ * @brief The TObjectTable class
+ * This is a side table of a page holding the geometry and some meta data
+ * of all objects. Each value is stored in its own contiguous array (one
+ * row per object). This way geometry queries like hit tests don't need
+ * to walk through all the object handlers with their large structures.
+ *
+ * The table is kept in sync by the object handlers themselves. Every
+ * handler registered in the table reports changes of geometry, z-order,
+ * type or visibility.
+ * Additionally the rectangles are kept in a spatial index. A point query
+ * looks only at the objects near the position.
+ */
+class TObjectTable
+{
+    public:
+        TObjectTable();
+        ~TObjectTable();
+
+        void clear();
+        void rebuild(const QList<TObjectHandler *>& objects);
+        void append(TObjectHandler *object);
+        void remove(TObjectHandler *object);
+        void update(TObjectHandler *object);
+
+        qsizetype size() const { return mBi.size(); }
+        int getRow(int bi) const;
+        int getButtonIndex(qsizetype row) const { return mBi[row]; }
+        QRect getRect(qsizetype row) const { return QRect(mLeft[row], mTop[row], mWidth[row], mHeight[row]); }
+        int getZOrder(qsizetype row) const { return mZOrder[row]; }
+        bool isHidden(qsizetype row) const { return mHidden[row] != 0; }
+        ObjHandler::BUTTONTYPE getType(qsizetype row) const { return mType[row]; }
+        TObjectHandler *getHandler(qsizetype row) const { return mHandler[row]; }
+        int getMaxButtonIndex() const;
+        QList<TObjectHandler *> getZOrdered() const;
+
+        int getObjectAt(const QPoint& pt, bool visibleOnly=true) const;
+        QList<int> getObjectsIn(const QRect& rect, bool visibleOnly=true) const;
+
+    private:
+        void setRow(qsizetype row, TObjectHandler *object);
+
+        QList<TObjectHandler *> mHandler;       // The handler of each row
+        QList<int> mBi;                         // Button index
+        QList<int> mLeft;                       // Left position
+        QList<int> mTop;                        // Top position
+        QList<int> mWidth;                      // Width
+        QList<int> mHeight;                     // Height
+        QList<int> mZOrder;                     // Z-order
+        QList<char> mHidden;                    // 1 = hidden
+        QList<ObjHandler::BUTTONTYPE> mType;    // The type of the object
+        QHash<TObjectHandler *, qsizetype> mRows;   // Maps a handler to its row
+        QHash<int, qsizetype> mBiRows;          // Maps a button index to its row
+        TSpatialIndex mIndex;                   // The rectangles of the objects
+};
+
+#endif // TOBJECTTABLE_H
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <QDir>
+#include <QImage>
+#include <QRunnable>
+#include <QMutexLocker>
+
+#include "tpageexporter.h"
+#include "tpagerenderer.h"
+#include "terror.h"
+
+using namespace Page;
+
+TPageExporter::TPageExporter(const QString& dir)
+    : mDirectory(dir)
+{
+    DECL_TRACER("TPageExporter::TPageExporter(const QString& dir)");
+
+    mSlots.release(mPool.maxThreadCount() * 2);
+}
+
+TPageExporter::~TPageExporter()
+{
+    DECL_TRACER("TPageExporter::~TPageExporter()");
+
+    mPool.waitForDone();
+}
+
+/**
+ * @brief TPageExporter::exportPages
+ * Exports the pages with the IDs in @b pageIDs. The method returns after
+ * all files are written.
+ *
+ * @param pageIDs   The IDs of the pages and popups to export.
+ * @return TRUE if all pages were exported. FALSE if at least one page
+ * couldn't be exported or the export was canceled.
+ */
+bool TPageExporter::exportPages(const QList<int>& pageIDs)
+{
+    DECL_TRACER("TPageExporter::exportPages(const QList<int>& pageIDs)");
+
+    QDir dir(mDirectory);
+
+    if (!dir.exists() && !dir.mkpath("."))
+    {
+        MSG_ERROR("Couldn't create the directory " << mDirectory.toStdString());
+        return false;
+    }
+
+    int total = static_cast<int>(pageIDs.size());
+    int done = 0;
+    bool canceled = false;
+
+    for (int pageID : pageIDs)
+    {
+        if (_progress && !_progress(done, total))
+        {
+            MSG_INFO("Export of pages was canceled.");
+            canceled = true;
+            break;
+        }
+
+        done++;
+        PAGE_t *page = TPageHandler::Current().getPage(pageID);
+        TPageHandler::Current().ensureLoaded(page);
+
+        if (!page)
+        {
+            MSG_ERROR("Page " << pageID << " doesn't exist!");
+            mErrors.ref();
+            continue;
+        }
+
+        QImage img = TPageRenderer::renderPage(page);
+
+        if (img.isNull())
+        {
+            MSG_ERROR("Couldn't render page " << page->name.toStdString());
+            mErrors.ref();
+            continue;
+        }
+
+        QString file = dir.filePath(getFileName(*page));
+        // Blocks as soon as enough images wait for the thread pool.
+        mSlots.acquire();
+
+        mPool.start(QRunnable::create([this, img, file]()
+        {
+            if (img.save(file, "PNG"))
+            {
+                QMutexLocker locker(&mMutex);
+                mFiles.append(file);
+            }
+            else
+            {
+                MSG_ERROR("Couldn't write file " << file.toStdString());
+                mErrors.ref();
+            }
+
+            mSlots.release();
+        }));
+    }
+
+    mPool.waitForDone();
+
+    if (_progress && !canceled)
+        _progress(total, total);
+
+    MSG_INFO("Exported " << mFiles.size() << " of " << total << " pages to " << mDirectory.toStdString());
+    return !canceled && mErrors.loadRelaxed() == 0;
+}
+
+bool TPageExporter::exportAll()
+{
+    DECL_TRACER("TPageExporter::exportAll()");
+
+    return exportPages(TPageHandler::Current().getPageNumbers());
+}
+
+/**
+ * @brief TPageExporter::getFileName
+ * Makes the name of the file for a page. The name depends only on the
+ * type, the name and the ID of the page. This way the files of two
+ * revisions of a project can be compared directly. Characters not allowed
+ * in a file name are replaced by an underscore. Therefore two pages may
+ * get the same name (e.g. "Main Page" and "Main_Page"). The ID of the page
+ * at the end makes the name unique.
+ *
+ * @param page  The page.
+ * @return The file name without path.
+ */
+QString TPageExporter::getFileName(const PAGE_t& page)
+{
+    DECL_TRACER("TPageExporter::getFileName(const PAGE_t& page)");
+
+    QString name = page.name;
+
+    for (QChar& c : name)
+    {
+        if (!c.isLetterOrNumber() && c != '-' && c != '_' && c != '.')
+            c = '_';
+    }
+
+    name += QString("_%1.png").arg(page.pageID);
+
+    if (page.popupType == PT_POPUP)
+        return "popup_" + name;
+    else if (page.popupType == PT_SUBPAGE)
+        return "subpage_" + name;
+
+    return "page_" + name;
+}
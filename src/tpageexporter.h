@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TPAGEEXPORTER_H
+#define TPAGEEXPORTER_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QThreadPool>
+#include <QSemaphore>
+#include <QAtomicInt>
+#include <QMutex>
+
+#include <functional>
+
+#include "tpagehandler.h"
+
+/**
+ * @brief The TPageExporter class
+ * Writes pages and popups of the current project as PNG files into a
+ * directory. The pages are composed by TPageRenderer, so no window is
+ * needed and the export works from the command line as well.
+ *
+ * Composing a page uses the drawing code of the editor, which must run on
+ * the GUI thread. Encoding and writing the PNG files is the expensive part
+ * and runs on all cores. The number of images waiting to be written is
+ * limited, so the memory stays bounded even for large projects.
+ */
+class TPageExporter
+{
+    public:
+        TPageExporter(const QString& dir);
+        ~TPageExporter();
+
+        bool exportPages(const QList<int>& pageIDs);
+        bool exportAll();
+        QStringList getFiles() const { return mFiles; }
+        int getErrors() const { return mErrors.loadRelaxed(); }
+
+        // Callback to report the progress. Returning false cancels the export.
+        void regProgress(std::function<bool (int done, int total)> func) { _progress = func; }
+
+        static QString getFileName(const Page::PAGE_t& page);
+
+    private:
+        std::function<bool (int done, int total)> _progress{nullptr};
+
+        QString mDirectory;             // The directory the files are written to
+        QThreadPool mPool;              // Encodes and writes the images
+        QSemaphore mSlots;              // Limits the images waiting to be written
+        QAtomicInt mErrors{0};          // The number of pages which couldn't be exported
+        QStringList mFiles;             // The files written
+        QMutex mMutex;                  // Protects mFiles
+};
+
+#endif // TPAGEEXPORTER_H
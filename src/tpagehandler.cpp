@@ -19,7 +19,14 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QCborValue>
+#include <QCborMap>
+#include <QCborArray>
 #include <QFile>
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QElapsedTimer>
 #include <QMdiArea>
 #include <QMdiSubWindow>
 #include <QtXml/QDomDocument>
@@ -28,16 +35,32 @@
 
 #include "tpagehandler.h"
 #include "tcanvaswidget.h"
+#include "tobjecttable.h"
 #include "tconverticons.h"
 #include "tconvertcolors.h"
 #include "tconfmain.h"
+#include "tconfig.h"
 #include "tfonts.h"
+#include "tstringpool.h"
+#include "tcostcache.h"
+#include "tthumbnailcache.h"
+#include "tthumbnailstore.h"
 #include "tmisc.h"
 #include "terror.h"
 
+#define PAGE_INDEX_FILE     "pages_.cbor"
+
 using namespace Page;
+using namespace Qt::StringLiterals;
 using std::vector;
 
+// Pages are parsed from JSON and from CBOR by the same code. These
+// functions cover the few places where the APIs of both differ.
+static inline int valueToInt(const QJsonValue& value, int def=0) { return value.toInt(def); }
+static inline int valueToInt(const QCborValue& value, int def=0) { return static_cast<int>(value.toInteger(def)); }
+static inline QJsonObject valueToMap(const QJsonValue& value) { return value.toObject(); }
+static inline QCborMap valueToMap(const QCborValue& value) { return value.toMap(); }
+
 TPageHandler* TPageHandler::mCurrent{nullptr};
 
 TPageHandler::TPageHandler()
@@ -156,8 +179,28 @@ void TPageHandler::reset()
 {
     DECL_TRACER("TPageHandler::reset()");
 
+    QList<PAGE_t>::Iterator iter;
+
+    for (iter = mPages.begin(); iter != mPages.end(); ++iter)
+    {
+        // A copy of the page may still hold the table. Detach it from
+        // the objects in any case.
+        if (iter->objectTable)
+        {
+            iter->objectTable->clear();
+            iter->objectTable.reset();
+        }
+    }
+
     mPages.clear();
+    mUnloadedPages = 0;
     mPathTemporary.clear();
+    TStringPool::Current().clear();
+    // The borders and images of the next project may differ
+    TCostCacheBase::resetAll();
+    TThumbnailCache::Current().clear();
+    // The thumbnails of images are kept for the next project
+    TThumbnailStore::Current().logStatistics();
     mMaxPageNumber = 0;
     mMaxPopupNumber = 500;
 }
@@ -264,7 +307,7 @@ PAGE_t TPageHandler::getCurrentPage(QMdiArea *area)
     if (id <= 0)
         return PAGE_t();
 
-    for (PAGE_t page : mPages)
+    for (const PAGE_t& page : std::as_const(mPages))
     {
         if (page.pageID == id)
             return page;
@@ -396,6 +439,34 @@ PAGE_t *TPageHandler::getPage(int number)
     return getPagePointer(number);
 }
 
+/**
+ * @brief TPageHandler::getPageHeader
+ * Returns a pointer to a page or popup without forcing its body to be
+ * parsed. Only the header fields (ID, name, type, group, size and position)
+ * are guaranteed to be valid. If the member \b loaded is FALSE, the
+ * objects, states and events were not read yet.
+ * Use this method if only the header is needed, like for building the
+ * workspace tree.
+ *
+ * @param number    The number of the page or popup.
+ * @return On success a pointer to the page is returned. Otherwise
+ * nullptr is returned.
+ */
+PAGE_t *TPageHandler::getPageHeader(int number)
+{
+    DECL_TRACER("TPageHandler::getPageHeader(int number)");
+
+    QList<PAGE_t>::Iterator iter;
+
+    for (iter = mPages.begin(); iter != mPages.end(); ++iter)
+    {
+        if (iter->pageID == number)
+            return &(*iter);
+    }
+
+    return nullptr;
+}
+
 PAGE_t *TPageHandler::getPage(const QString& name)
 {
     DECL_TRACER("TPageHandler::getPage(const QString& name)");
@@ -480,7 +551,13 @@ void TPageHandler::setPage(PAGE_t& page)
     if (!pg)
         return;
 
+    // The geometry table belongs to the stored page
+    std::shared_ptr<TObjectTable> table = pg->objectTable;
     *pg = page;
+    pg->objectTable = table;
+
+    if (table)
+        table->rebuild(pg->objects);
 }
 
 void TPageHandler::setPageBgColor(int number, QColor& col)
@@ -492,6 +569,8 @@ void TPageHandler::setPageBgColor(int number, QColor& col)
     if (!page)
         return;
 
+    ensureLoaded(page);
+
     page->srPage.cf = col;
 }
 
@@ -504,6 +583,8 @@ void TPageHandler::setPageTextColor(int number, QColor& col)
     if (!page)
         return;
 
+    ensureLoaded(page);
+
     page->srPage.ct = col;
 }
 
@@ -553,6 +634,10 @@ void TPageHandler::changePageName(int id, const QString& name)
     if (!page)
         return;
 
+    // The file of the page is removed on renaming. Therefore the page
+    // must be in memory to be written with the new name.
+    ensureLoaded(page);
+
     if (id > 0 && id < 500)
         TConfMain::Current().renamePage(id, name);
     else if (id > 500 && id < 1000)
@@ -598,6 +683,8 @@ int TPageHandler::appendObject(int pageID, TObjectHandler *object)
     if (!page)
         return -1;
 
+    ensureLoaded(page);
+
     // Check if object is unique
     for (TObjectHandler *o : page->objects)
     {
@@ -609,6 +696,10 @@ int TPageHandler::appendObject(int pageID, TObjectHandler *object)
     }
 
     page->objects.append(object);
+
+    if (page->objectTable)
+        page->objectTable->append(object);
+
     return page->objects.size() - 1;
 }
 
@@ -624,6 +715,8 @@ void TPageHandler::removeObject(int pageID, int bi)
     if (!page)
         return;
 
+    ensureLoaded(page);
+
     QList<TObjectHandler *>::Iterator iter;
 
     for (iter = page->objects.begin(); iter != page->objects.end(); ++iter)
@@ -632,6 +725,9 @@ void TPageHandler::removeObject(int pageID, int bi)
 
         if (o->getObject().bi == bi)
         {
+            if (page->objectTable)
+                page->objectTable->remove(o);
+
             page->objects.erase(iter);
             break;
         }
@@ -647,6 +743,8 @@ void TPageHandler::setObject(int num, ObjHandler::TOBJECT_t& object)
     if (!page)
         return;
 
+    ensureLoaded(page);
+
     // Make sure the object does not already exist
     QList<TObjectHandler *>::Iterator iter;
 
@@ -665,6 +763,9 @@ void TPageHandler::setObject(int num, ObjHandler::TOBJECT_t& object)
     o->setObject(object);
     o->setZOrder(page->objects.size());
     page->objects.append(o);
+
+    if (page->objectTable)
+        page->objectTable->append(o);
 }
 
 ObjHandler::TOBJECT_t TPageHandler::getObject(int page, int bi)
@@ -672,6 +773,7 @@ ObjHandler::TOBJECT_t TPageHandler::getObject(int page, int bi)
     DECL_TRACER("TPageHandler::getObject(int page, int bi)");
 
     PAGE_t *pg = getPage(page);
+    ensureLoaded(pg);
 
     if (!pg || pg->pageID <= 0)
         return ObjHandler::TOBJECT_t();
@@ -690,6 +792,7 @@ TObjectHandler *TPageHandler::getObjectHandler(int page, int bi)
     DECL_TRACER("TPageHandler::getObjectHandler(int page, int bi)");
 
     PAGE_t *pg = getPage(page);
+    ensureLoaded(pg);
 
     if (!pg || pg->pageID <= 0)
         return nullptr;
@@ -755,30 +858,111 @@ void TPageHandler::setObjectGeometry(int pageID, int bi, const QRect& geom)
 {
     DECL_TRACER("TPageHandler::setObjectGeometry(int pageID, int bi, const QRect& geom)");
 
+    TObjectTable *table = getObjectTable(pageID);
+
+    if (!table)
+        return;
+
+    int row = table->getRow(bi);
+
+    // This updates the geometry table and the spatial index too.
+    if (row >= 0 && table->getRect(row) != geom)
+        table->getHandler(row)->setSize(geom);
+}
+
+/**
+ * @brief TPageHandler::getObjectTable
+ * Returns the geometry side table of a page. If the table doesn't exist
+ * yet, it is created from the objects of the page. Once created, the
+ * table is kept up to date by the object handlers.
+ *
+ * @param pageID    The number of the page or popup.
+ * @return A pointer to the table or nullptr if the page doesn't exist.
+ */
+TObjectTable *TPageHandler::getObjectTable(int pageID)
+{
+    DECL_TRACER("TPageHandler::getObjectTable(int pageID)");
+
     PAGE_t *page = getPagePointer(pageID);
 
     if (!page)
-        return;
+        return nullptr;
+
+    ensureLoaded(page);
 
-    for (TObjectHandler *obj : page->objects)
+    if (!page->objectTable)
     {
-        if (obj->getButtonIndex() == bi)
-        {
-            obj->setSize(geom);
-            break;
-        }
+        page->objectTable = std::make_shared<TObjectTable>();
+        page->objectTable->rebuild(page->objects);
     }
+
+    return page->objectTable.get();
+}
+
+/**
+ * @brief TPageHandler::getObjectAt
+ * Searches for the top most object at the position \b pt.
+ *
+ * @param pageID        The number of the page or popup.
+ * @param pt            The position on the page.
+ * @param visibleOnly   TRUE = hidden objects are ignored.
+ * @return The button index of the object or 0 if there is none.
+ */
+int TPageHandler::getObjectAt(int pageID, const QPoint& pt, bool visibleOnly)
+{
+    DECL_TRACER("TPageHandler::getObjectAt(int pageID, const QPoint& pt, bool visibleOnly)");
+
+    TObjectTable *table = getObjectTable(pageID);
+
+    if (!table)
+        return 0;
+
+    return table->getObjectAt(pt, visibleOnly);
+}
+
+/**
+ * @brief TPageHandler::getObjectsIn
+ * Searches for all objects intersecting the area \b rect.
+ *
+ * @param pageID        The number of the page or popup.
+ * @param rect          The area on the page.
+ * @param visibleOnly   TRUE = hidden objects are ignored.
+ * @return The button indexes of the objects in z-order, starting with
+ * the bottom most object.
+ */
+QList<int> TPageHandler::getObjectsIn(int pageID, const QRect& rect, bool visibleOnly)
+{
+    DECL_TRACER("TPageHandler::getObjectsIn(int pageID, const QRect& rect, bool visibleOnly)");
+
+    TObjectTable *table = getObjectTable(pageID);
+
+    if (!table)
+        return QList<int>();
+
+    return table->getObjectsIn(rect, visibleOnly);
 }
 
 bool TPageHandler::saveAllPages()
 {
     DECL_TRACER("TPageHandler::saveAllPages()");
 
-    TFonts::reset();
+    TFonts::clearFontList();
     QList<Page::PAGE_t>::Iterator pageIter;
 
     for (pageIter = mPages.begin(); pageIter != mPages.end(); ++pageIter)
     {
+        // A page which was never opened is unchanged on disk. Only the
+        // font of the page must be registered again.
+        if (!pageIter->loaded)
+        {
+            if (!pageIter->srPage.ff.isEmpty())
+                TFonts::addFontFamily(pageIter->srPage.ff);
+
+            TConfMain::Current().setPageFile(pageIter->name, findPageFile(pageIter->name));
+
+            continue;
+        }
+
         if (pageIter->popupType == PT_PAGE)
         {
             if (!savePage(*pageIter))
@@ -791,7 +975,7 @@ bool TPageHandler::saveAllPages()
         }
     }
 
-    return true;
+    return writePageIndex();
 }
 
 bool TPageHandler::savePage(const PAGE_t& page)
@@ -821,19 +1005,10 @@ bool TPageHandler::savePage(const PAGE_t& page)
 
     saveEvents(page, &root);
 
-    QJsonDocument doc;
-    doc.setObject(root);
-    QString metaFile = mPathTemporary + "/" + page.name + ".json";
-    QFile file(metaFile);
-
-    if(!file.open(QIODevice::WriteOnly))
-    {
-        MSG_ERROR("Error opening file \"" << metaFile.toStdString() << "\" for writing!");
+    if (!writePageFile(page.name, root))
         return false;
-    }
 
-    file.write(doc.toJson(QJsonDocument::Indented));
-    file.close();
+    TThumbnailCache::Current().update(page.pageID, QCryptographicHash::hash(QJsonDocument(root).toJson(QJsonDocument::Compact), QCryptographicHash::Md5).toHex());
     return true;
 }
 
@@ -871,9 +1046,32 @@ bool TPageHandler::savePopup(const PAGE_t& popup)
     QJsonObject sr = getSr(popup.popupType, popup.srPage);
     root.insert("sr", sr);
 
-    QJsonDocument doc;
-    doc.setObject(root);
-    QString metaFile = mPathTemporary + "/" + popup.name + ".json";
+    if (!writePageFile(popup.name, root))
+        return false;
+
+    TThumbnailCache::Current().update(popup.pageID, QCryptographicHash::hash(QJsonDocument(root).toJson(QJsonDocument::Compact), QCryptographicHash::Md5).toHex());
+    return true;
+}
+
+/**
+ * @brief TPageHandler::writePageFile
+ * Writes the JSON object of a page or popup into the temporary directory.
+ * Depending on the configuration the file is written as compact binary
+ * CBOR (<name>.cbor) or as human readable JSON (<name>.json). The file of
+ * the other format, if any, is removed afterwards so that there is always
+ * only one valid representation of a page in the project. The file written
+ * is recorded in the page list of the project.
+ *
+ * @param name  The name of the page or popup.
+ * @param root  The complete JSON object of the page.
+ * @return On success TRUE is returned.
+ */
+bool TPageHandler::writePageFile(const QString& name, const QJsonObject& root)
+{
+    DECL_TRACER("TPageHandler::writePageFile(const QString& name, const QJsonObject& root)");
+
+    bool binary = TConfig::Current().getBinaryPages();
+    QString metaFile = mPathTemporary + "/" + name + (binary ? ".cbor" : ".json");
     QFile file(metaFile);
 
     if(!file.open(QIODevice::WriteOnly))
@@ -882,8 +1080,114 @@ bool TPageHandler::savePopup(const PAGE_t& popup)
         return false;
     }
 
-    file.write(doc.toJson(QJsonDocument::Indented));
+    if (binary)
+        file.write(QCborValue::fromJsonValue(root).toCbor());
+    else
+    {
+        QJsonDocument doc;
+        doc.setObject(root);
+        file.write(doc.toJson(QJsonDocument::Indented));
+    }
+
     file.close();
+    QString otherFile = mPathTemporary + "/" + name + (binary ? ".json" : ".cbor");
+
+    if (QFile::exists(otherFile) && !QFile::remove(otherFile))
+        MSG_WARNING("Couldn't remove the obsolete page file " << otherFile.toStdString());
+
+    TConfMain::Current().setPageFile(name, basename(metaFile));
+    return true;
+}
+
+/**
+ * @brief TPageHandler::findPageFile
+ * Returns the file name of a page as it is stored in the temporary
+ * directory. If a binary file (<name>.cbor) exists, it is preferred.
+ * Otherwise the JSON file (<name>.json) is used. This way projects written
+ * by older versions can still be read.
+ *
+ * @param name  The name of the page or popup.
+ * @return The file name without path.
+ */
+QString TPageHandler::findPageFile(const QString& name)
+{
+    DECL_TRACER("TPageHandler::findPageFile(const QString& name)");
+
+    QString file = name + ".cbor";
+
+    if (QFile::exists(mPathTemporary + "/" + file))
+        return file;
+
+    return name + ".json";
+}
+
+/**
+ * @brief TPageHandler::readPageFile
+ * Reads a page or popup from the temporary directory and parses it. A
+ * binary page is parsed directly from CBOR without a conversion to JSON.
+ * The file read is recorded in the page list of the project.
+ *
+ * @param name      The name of the page or popup.
+ * @param target    Optional: A page read from the index which gets the
+ * content. If this is nullptr, the page is appended to the list of pages.
+ * @return On success TRUE is returned.
+ */
+bool TPageHandler::readPageFile(const QString& name, PAGE_t *target)
+{
+    DECL_TRACER("TPageHandler::readPageFile(const QString& name, PAGE_t *target)");
+
+    QString fileName = findPageFile(name);
+    bool binary = fileName.endsWith(".cbor");
+    QFile pageFile(mPathTemporary + "/" + fileName);
+    MSG_DEBUG("Reading page " << pageFile.fileName().toStdString());
+
+    if (!pageFile.exists())
+    {
+        MSG_ERROR("The page file " << name.toStdString() << " was not found!");
+        return false;
+    }
+
+    if (!pageFile.open(QIODevice::ReadOnly))
+    {
+        MSG_ERROR("Error reading file " << name.toStdString());
+        return false;
+    }
+
+    QByteArray content = pageFile.readAll();
+    pageFile.close();
+    // The time to decode and parse is logged, so the formats can be compared.
+    QElapsedTimer timer;
+    timer.start();
+
+    if (binary)
+    {
+        QCborParserError error;
+        QCborValue cbor = QCborValue::fromCbor(content, &error);
+
+        if (error.error != QCborError::NoError || !cbor.isMap())
+        {
+            MSG_ERROR("Error parsing binary page " << name.toStdString() << ": " << error.errorString().toStdString());
+            return false;
+        }
+
+        parsePage(cbor.toMap(), target);
+    }
+    else
+    {
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(content, &error);
+
+        if (error.error != QJsonParseError::NoError)
+        {
+            MSG_ERROR("Error parsing page " << name.toStdString() << ": " << error.errorString().toStdString());
+            return false;
+        }
+
+        parsePage(doc.object(), target);
+    }
+
+    MSG_DEBUG("Parsed page " << name.toStdString() << " (" << (binary ? "CBOR" : "JSON") << ", " << content.size() << " bytes) in " << timer.nsecsElapsed() / 1000 << " µs");
+    TConfMain::Current().setPageFile(name, fileName);
     return true;
 }
 
@@ -1275,31 +1579,219 @@ bool TPageHandler::readPages(const QStringList& list)
     if (!mPages.empty())
         reset();
 
+    QElapsedTimer timer;
+    timer.start();
+    QHash<QString, PAGE_t> index;
+    // The index is written again if it doesn't match the pages exactly.
+    bool indexValid = readPageIndex(&index) && index.size() == list.size();
     QStringList::ConstIterator iter;
 
     for (iter = list.constBegin(); iter != list.constEnd(); ++iter)
     {
-        QFile pageFile(mPathTemporary + "/" + *iter + ".json");
-        MSG_DEBUG("Reading page " << pageFile.fileName().toStdString());
-
-        if (!pageFile.exists())
+        // If the page is in the index, only the header is taken. The body
+        // is parsed the first time the page is needed.
+        if (index.contains(*iter))
         {
-            MSG_ERROR("The page file " << iter->toStdString() << " was not found!");
+            PAGE_t pg = index.value(*iter);
+
+            if (pg.popupType == PT_PAGE && pg.pageID > mMaxPageNumber)
+                mMaxPageNumber = pg.pageID;
+            else if (pg.popupType != PT_PAGE && pg.pageID > mMaxPopupNumber)
+                mMaxPopupNumber = pg.pageID;
+
+            mPages.append(pg);
+            mUnloadedPages++;
+            continue;
+        }
+
+        indexValid = false;
+
+        if (!readPageFile(*iter))
             return false;
+    }
+
+    MSG_INFO("Read " << list.size() << " pages, " << index.size() << " of them from index, in " << timer.elapsed() << " ms.");
+
+    if (!indexValid)
+    {
+        MSG_DEBUG("The page index is missing or outdated. Writing a new one.");
+        writePageIndex();
+    }
+
+    // Pages read from the index are parsed later by ensureLoaded().
+    if (mUnloadedPages == 0)
+        TStringPool::Current().logStatistics();
+
+    return true;
+}
+
+/**
+ * @brief TPageHandler::ensureLoaded
+ * The getters return a page as it is in memory. A page read from the page
+ * index contains only the header. Everybody who needs the objects, states
+ * or events of a page must call this method first. It reads the file of
+ * the page and parses the complete content. The internal states of the
+ * page (widget, visibility, grid) are kept.
+ *
+ * @param page  A pointer to the page to complete. Can be nullptr.
+ * @return On success TRUE is returned.
+ */
+bool TPageHandler::ensureLoaded(PAGE_t *page)
+{
+    DECL_TRACER("TPageHandler::ensureLoaded(PAGE_t *page)");
+
+    if (!page || page->loaded)
+        return true;
+
+    // Mark it as loaded in any case to not try it again and again on error
+    page->loaded = true;
+    mUnloadedPages--;
+    bool ret = readPageFile(page->name, page);
+
+    // The last page was parsed, so the pool is complete now.
+    if (mUnloadedPages == 0)
+        TStringPool::Current().logStatistics();
+
+    return ret;
+}
+
+/**
+ * @brief TPageHandler::writePageIndex
+ * Writes a small index file containing the header of every page and
+ * popup. On reading a project this index is used to build the list of
+ * pages without parsing every single page file.
+ * For every page the name, size and modification time of its file is
+ * stored too. This allows to detect a page file which was changed after
+ * the index was written.
+ *
+ * @return On success TRUE is returned.
+ */
+bool TPageHandler::writePageIndex()
+{
+    DECL_TRACER("TPageHandler::writePageIndex()");
+
+    QCborArray index;
+    QList<PAGE_t>::Iterator iter;
+
+    for (iter = mPages.begin(); iter != mPages.end(); ++iter)
+    {
+        QCborMap entry;
+        entry.insert(QStringLiteral("type"), static_cast<int>(iter->popupType));
+        entry.insert(QStringLiteral("pageID"), iter->pageID);
+        entry.insert(QStringLiteral("name"), iter->name);
+        entry.insert(QStringLiteral("group"), iter->group);
+        entry.insert(QStringLiteral("left"), iter->left);
+        entry.insert(QStringLiteral("top"), iter->top);
+        entry.insert(QStringLiteral("width"), iter->width);
+        entry.insert(QStringLiteral("height"), iter->height);
+        entry.insert(QStringLiteral("ff"), iter->srPage.ff);
+
+        QString fileName = findPageFile(iter->name);
+        QFileInfo info(mPathTemporary + "/" + fileName);
+        entry.insert(QStringLiteral("file"), fileName);
+        entry.insert(QStringLiteral("size"), info.size());
+        entry.insert(QStringLiteral("mtime"), info.lastModified().toSecsSinceEpoch());
+        index.append(entry);
+    }
+
+    QString indexFile = mPathTemporary + "/" + PAGE_INDEX_FILE;
+    QFile file(indexFile);
+
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        MSG_ERROR("Error opening file \"" << indexFile.toStdString() << "\" for writing!");
+        return false;
+    }
+
+    file.write(QCborValue(index).toCbor());
+    file.close();
+    return true;
+}
+
+/**
+ * @brief TPageHandler::readPageIndex
+ * Reads the page index, if there is one, into a hash with the page name
+ * as the key. The pages in the hash contain only the header and are
+ * marked as not loaded.
+ * An entry is only taken if the file of the page still has the size and
+ * modification time stored in the index. Otherwise the page must be
+ * parsed from its file.
+ *
+ * @param index A pointer to a hash receiving the page headers.
+ * @return If an index was found and all entries match their files, TRUE
+ * is returned.
+ */
+bool TPageHandler::readPageIndex(QHash<QString, PAGE_t> *index)
+{
+    DECL_TRACER("TPageHandler::readPageIndex(QHash<QString, PAGE_t> *index)");
+
+    if (!index)
+        return false;
+
+    QFile file(mPathTemporary + "/" + PAGE_INDEX_FILE);
+
+    if (!file.exists())
+        return false;
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        MSG_ERROR("Error reading file " << file.fileName().toStdString());
+        return false;
+    }
+
+    QCborParserError error;
+    QCborValue cbor = QCborValue::fromCbor(file.readAll(), &error);
+    file.close();
+
+    if (error.error != QCborError::NoError || !cbor.isArray())
+    {
+        MSG_WARNING("Invalid page index " << file.fileName().toStdString() << ": " << error.errorString().toStdString());
+        return false;
+    }
+
+    QCborArray entries = cbor.toArray();
+    bool valid = true;
+
+    for (const QCborValue& value : entries)
+    {
+        QCborMap entry = value.toMap();
+        PAGE_t pg;
+        pg.popupType = static_cast<PAGE_TYPE>(entry.value(QStringLiteral("type")).toInteger(PT_UNKNOWN));
+        pg.pageID = static_cast<int>(entry.value(QStringLiteral("pageID")).toInteger(0));
+        pg.name = entry.value(QStringLiteral("name")).toString();
+        pg.group = entry.value(QStringLiteral("group")).toString();
+        pg.left = static_cast<int>(entry.value(QStringLiteral("left")).toInteger(0));
+        pg.top = static_cast<int>(entry.value(QStringLiteral("top")).toInteger(0));
+        pg.width = static_cast<int>(entry.value(QStringLiteral("width")).toInteger(0));
+        pg.height = static_cast<int>(entry.value(QStringLiteral("height")).toInteger(0));
+        pg.srPage.ff = entry.value(QStringLiteral("ff")).toString();
+        pg.loaded = false;
+
+        if (pg.pageID <= 0 || pg.name.isEmpty())
+        {
+            valid = false;
+            continue;
         }
 
-        if (!pageFile.open(QIODevice::ReadOnly))
+        // The archive keeps the time stamps of the files, but only in
+        // seconds.
+        QString fileName = findPageFile(pg.name);
+        QFileInfo info(mPathTemporary + "/" + fileName);
+
+        if (!info.exists() ||
+            entry.value(QStringLiteral("file")).toString() != fileName ||
+            entry.value(QStringLiteral("size")).toInteger(-1) != info.size() ||
+            entry.value(QStringLiteral("mtime")).toInteger(-1) != info.lastModified().toSecsSinceEpoch())
         {
-            MSG_ERROR("Error reading file " << iter->toStdString());
-            return false;
+            MSG_DEBUG("Page " << pg.name.toStdString() << " was changed since the index was written.");
+            valid = false;
+            continue;
         }
 
-        QJsonDocument doc = QJsonDocument::fromJson(pageFile.readAll());
-        pageFile.close();
-        parsePage(doc.object());
+        index->insert(pg.name, pg);
     }
 
-    return true;
+    return valid;
 }
 
 Page::PAGE_t *TPageHandler::getPagePointer(int num)
@@ -1317,78 +1809,89 @@ Page::PAGE_t *TPageHandler::getPagePointer(int num)
     return nullptr;
 }
 
-void TPageHandler::parsePage(const QJsonObject& page)
+/**
+ * @brief TPageHandler::parsePage
+ * Parses the content of a page or popup. The same code reads a page
+ * stored as JSON (QJsonObject) and as CBOR (QCborMap), so a binary page
+ * is never converted to JSON.
+ *
+ * @param page      The content of the page.
+ * @param target    Optional: A page read from the index which gets the
+ * content. If this is nullptr, the page is appended to the list of pages.
+ */
+template<typename Map>
+void TPageHandler::parsePage(const Map& page, PAGE_t *target)
 {
-    DECL_TRACER("TPageHandler::parsePage(const QJsonObject& page)");
+    DECL_TRACER("TPageHandler::parsePage(const Map& page, PAGE_t *target)");
 
     int setupPort = TConfMain::Current().getSetupPort();
     PAGE_t pg;
-    pg.popupType = static_cast<PAGE_TYPE>(page.value("type").toInt(PT_UNKNOWN));
-    pg.pageID = page.value("pageID").toInt(0);
+    pg.popupType = static_cast<PAGE_TYPE>(valueToInt(page.value("type"_L1), PT_UNKNOWN));
+    pg.pageID = valueToInt(page.value("pageID"_L1), 0);
 
     if (pg.popupType == PT_PAGE && pg.pageID > mMaxPageNumber)
         mMaxPageNumber = pg.pageID;
     else if (pg.pageID > mMaxPopupNumber)
         mMaxPopupNumber = pg.pageID;
 
-    pg.name = page.value("name").toString();
-    pg.description = page.value("description").toString();
-    pg.ap = page.value("ap").toInt(setupPort);
-    pg.ad = page.value("ad").toInt(1);
-    pg.cp = page.value("cp").toInt(setupPort);
-    pg.ch = page.value("ch").toInt(1);
-    pg.left = page.value("left").toInt(0);
-    pg.top = page.value("top").toInt(0);
-    pg.width = page.value("width").toInt(0);
-    pg.height = page.value("height").toInt(0);
-    pg.modal = page.value("modal").toInt(0);
-    pg.showLockX = page.value("showLocX").toInt(0);
-    pg.collapseDirection = static_cast<COLDIR_t>(page.value("collapseDirection").toInt(COLDIR_NONE));
-    pg.collapseOffset = page.value("collapseOffset").toInt(0);
-    pg.collapsible = page.value("collapsible").toBool(false);
-    pg.colState = static_cast<COLLAPS_STATE_t>(page.value("colState").toInt(COL_CLOSED));
-    pg.group = page.value("group").toString();
-    pg.timeout = page.value("timeout").toInt(0);
-    pg.showEffect = static_cast<SHOWEFFECT>(page.value("showEffect").toInt(SE_NONE));
-    pg.showTime = page.value("showTime").toInt(0);
-    pg.showX = page.value("showX").toInt(0);
-    pg.showY = page.value("showY").toInt(0);
-    pg.hideEffect = static_cast<SHOWEFFECT>(page.value("hideEffect").toInt(SE_NONE));
-    pg.hideTime = page.value("hideTime").toInt(0);
-    pg.hideX = page.value("hideX").toInt(0);
-    pg.hideY = page.value("hideY").toInt(0);
-
-    QJsonObject srPage = page.value("sr").toObject();
-    pg.srPage.bs = srPage.value("bs").toString();
-    pg.srPage.mi = srPage.value("mi").toString();
-    pg.srPage.cb = QColor::fromString(srPage.value("cb").toString("#ffa100"));
-    pg.srPage.ft = srPage.value("ft").toString();
-    pg.srPage.cf = QColor::fromString(srPage.value("cf").toString(TConfMain::Current().getColorBackground().name(QColor::HexArgb)));
-    pg.srPage.ct = QColor::fromString(srPage.value("ct").toString(TConfMain::Current().getColorText().name(QColor::HexArgb)));
-    pg.srPage.ec = QColor::fromString(srPage.value("ec").toString("#ff808080"));
-    pg.srPage.bm = srPage.value("bm").toString();
-
-    QJsonArray bitmaps = srPage.value("bitmaps").toArray();
-
-    for (int i = 0; i < bitmaps.count(); ++i)
-    {
-        QJsonObject entry = bitmaps[i].toObject();
+    pg.name = page.value("name"_L1).toString();
+    pg.description = page.value("description"_L1).toString();
+    pg.ap = valueToInt(page.value("ap"_L1), setupPort);
+    pg.ad = valueToInt(page.value("ad"_L1), 1);
+    pg.cp = valueToInt(page.value("cp"_L1), setupPort);
+    pg.ch = valueToInt(page.value("ch"_L1), 1);
+    pg.left = valueToInt(page.value("left"_L1), 0);
+    pg.top = valueToInt(page.value("top"_L1), 0);
+    pg.width = valueToInt(page.value("width"_L1), 0);
+    pg.height = valueToInt(page.value("height"_L1), 0);
+    pg.modal = valueToInt(page.value("modal"_L1), 0);
+    pg.showLockX = valueToInt(page.value("showLocX"_L1), 0);
+    pg.collapseDirection = static_cast<COLDIR_t>(valueToInt(page.value("collapseDirection"_L1), COLDIR_NONE));
+    pg.collapseOffset = valueToInt(page.value("collapseOffset"_L1), 0);
+    pg.collapsible = page.value("collapsible"_L1).toBool(false);
+    pg.colState = static_cast<COLLAPS_STATE_t>(valueToInt(page.value("colState"_L1), COL_CLOSED));
+    pg.group = page.value("group"_L1).toString();
+    pg.timeout = valueToInt(page.value("timeout"_L1), 0);
+    pg.showEffect = static_cast<SHOWEFFECT>(valueToInt(page.value("showEffect"_L1), SE_NONE));
+    pg.showTime = valueToInt(page.value("showTime"_L1), 0);
+    pg.showX = valueToInt(page.value("showX"_L1), 0);
+    pg.showY = valueToInt(page.value("showY"_L1), 0);
+    pg.hideEffect = static_cast<SHOWEFFECT>(valueToInt(page.value("hideEffect"_L1), SE_NONE));
+    pg.hideTime = valueToInt(page.value("hideTime"_L1), 0);
+    pg.hideX = valueToInt(page.value("hideX"_L1), 0);
+    pg.hideY = valueToInt(page.value("hideY"_L1), 0);
+
+    auto srPage = valueToMap(page.value("sr"_L1));
+    pg.srPage.bs = srPage.value("bs"_L1).toString();
+    pg.srPage.mi = srPage.value("mi"_L1).toString();
+    pg.srPage.cb = QColor::fromString(srPage.value("cb"_L1).toString("#ffa100"));
+    pg.srPage.ft = srPage.value("ft"_L1).toString();
+    pg.srPage.cf = QColor::fromString(srPage.value("cf"_L1).toString(TConfMain::Current().getColorBackground().name(QColor::HexArgb)));
+    pg.srPage.ct = QColor::fromString(srPage.value("ct"_L1).toString(TConfMain::Current().getColorText().name(QColor::HexArgb)));
+    pg.srPage.ec = QColor::fromString(srPage.value("ec"_L1).toString("#ff808080"));
+    pg.srPage.bm = srPage.value("bm"_L1).toString();
+
+    auto bitmaps = srPage.value("bitmaps"_L1).toArray();
+
+    for (int i = 0; i < bitmaps.size(); ++i)
+    {
+        auto entry = valueToMap(bitmaps.at(i));
         ObjHandler::BITMAPS_t bm;
         bm.index = i;
-        bm.fileName = entry.value("fileName").toString();
-        bm.dynamic = entry.value("dynamic").toBool(false);
-        bm.justification = static_cast<ObjHandler::ORIENTATION>(entry.value("justification").toInt(ObjHandler::ORI_CENTER_MIDDLE));
-        bm.offsetX = entry.value("offsetX").toInt(0);
-        bm.offsetY = entry.value("offsetY").toInt(0);
+        bm.fileName = entry.value("fileName"_L1).toString();
+        bm.dynamic = entry.value("dynamic"_L1).toBool(false);
+        bm.justification = static_cast<ObjHandler::ORIENTATION>(valueToInt(entry.value("justification"_L1), ObjHandler::ORI_CENTER_MIDDLE));
+        bm.offsetX = valueToInt(entry.value("offsetX"_L1), 0);
+        bm.offsetY = valueToInt(entry.value("offsetY"_L1), 0);
         pg.srPage.bitmaps.append(bm);
     }
 
-    QJsonArray gradientColors = srPage.value("gradientColors").toArray();
+    auto gradientColors = srPage.value("gradientColors"_L1).toArray();
 
-    if (gradientColors.count() > 0)
+    if (gradientColors.size() > 0)
     {
-        for (int i = 0; i < gradientColors.count(); ++i)
-            pg.srPage.gradientColors.append(QColor::fromString(gradientColors[i].toString()));
+        for (int i = 0; i < gradientColors.size(); ++i)
+            pg.srPage.gradientColors.append(QColor::fromString(gradientColors.at(i).toString()));
     }
     else
     {
@@ -1396,24 +1899,24 @@ void TPageHandler::parsePage(const QJsonObject& page)
         pg.srPage.gradientColors.append(Qt::white);
     }
 
-    pg.srPage.gr = srPage.value("gr").toInt(0);
-    pg.srPage.gx = srPage.value("gx").toInt(0);
-    pg.srPage.gy = srPage.value("gy").toInt(0);
-    pg.srPage.dynamic = srPage.value("dynamic").toBool(false);
-    pg.srPage.sb = srPage.value("sb").toInt(0);
-    pg.srPage.jb = srPage.value("jb").toInt(5);
-    pg.srPage.bx = srPage.value("bx").toInt(0);
-    pg.srPage.by = srPage.value("by").toInt(0);
-    pg.srPage.fi = srPage.value("fi").toInt(0);
-    pg.srPage.te = srPage.value("te").toString();
-    pg.srPage.jt = static_cast<ObjHandler::ORIENTATION>(srPage.value("jt").toInt(ObjHandler::ORI_CENTER_MIDDLE));
-    pg.srPage.tx = srPage.value("tx").toInt(0);
-    pg.srPage.ty = srPage.value("ty").toInt(0);
-    pg.srPage.ff = srPage.value("ff").toString();
-    pg.srPage.fs = srPage.value("fs").toInt(0);
-    pg.srPage.ww = srPage.value("ww").toInt(0);
-    pg.srPage.et = srPage.value("et").toInt(0);
-    pg.srPage.oo = srPage.value("oo").toInt(255);
+    pg.srPage.gr = valueToInt(srPage.value("gr"_L1), 0);
+    pg.srPage.gx = valueToInt(srPage.value("gx"_L1), 0);
+    pg.srPage.gy = valueToInt(srPage.value("gy"_L1), 0);
+    pg.srPage.dynamic = srPage.value("dynamic"_L1).toBool(false);
+    pg.srPage.sb = valueToInt(srPage.value("sb"_L1), 0);
+    pg.srPage.jb = valueToInt(srPage.value("jb"_L1), 5);
+    pg.srPage.bx = valueToInt(srPage.value("bx"_L1), 0);
+    pg.srPage.by = valueToInt(srPage.value("by"_L1), 0);
+    pg.srPage.fi = valueToInt(srPage.value("fi"_L1), 0);
+    pg.srPage.te = srPage.value("te"_L1).toString();
+    pg.srPage.jt = static_cast<ObjHandler::ORIENTATION>(valueToInt(srPage.value("jt"_L1), ObjHandler::ORI_CENTER_MIDDLE));
+    pg.srPage.tx = valueToInt(srPage.value("tx"_L1), 0);
+    pg.srPage.ty = valueToInt(srPage.value("ty"_L1), 0);
+    pg.srPage.ff = srPage.value("ff"_L1).toString();
+    pg.srPage.fs = valueToInt(srPage.value("fs"_L1), 0);
+    pg.srPage.ww = valueToInt(srPage.value("ww"_L1), 0);
+    pg.srPage.et = valueToInt(srPage.value("et"_L1), 0);
+    pg.srPage.oo = valueToInt(srPage.value("oo"_L1), 255);
 
     QStringList events = { "eventShow", "eventHide", "gestureAny", "gestureUp",
                            "gestureDown", "gestureRight", "gestureLeft",
@@ -1422,28 +1925,28 @@ void TPageHandler::parsePage(const QJsonObject& page)
 
     for (QString event : events)
     {
-        QJsonArray eventShow = page.value(event).toArray();
+        auto eventShow = page.value(event).toArray();
 
-        for (int i = 0; i < eventShow.count(); ++i)
+        for (int i = 0; i < eventShow.size(); ++i)
         {
-            QJsonObject entry = eventShow[i].toObject();
+            auto entry = valueToMap(eventShow.at(i));
             EVENT_t ev;
-            ev.evCommand = static_cast<EVENT_TYPE_t>(entry.value("evType").toInt(EV_CMD_NONE));
-            ev.evAction = static_cast<ObjHandler::BUTTON_ACTION_t>(entry.value("evAction").toInt());
-            ev.content = entry.value("content").toString();
-            ev.item = entry.value("item").toInt(0);
-            ev.name = entry.value("name").toString();
-            ev.ID = entry.value("ID").toInt(0);
-            ev.action = entry.value("action").toString();
-            ev.port = entry.value("port").toInt(0);
-            ev.key = entry.value("key").toInt();
-            ev.type = entry.value("type").toInt();
-            ev.flag = entry.value("flag").toInt();
-            ev.value1 = entry.value("value1").toInt();
-            ev.value2 = entry.value("value2").toInt();
-            ev.value3 = entry.value("value3").toInt();
-            ev.text = entry.value("text").toString();
-            ev.encode = entry.value("encode").toString();
+            ev.evCommand = static_cast<EVENT_TYPE_t>(valueToInt(entry.value("evType"_L1), EV_CMD_NONE));
+            ev.evAction = static_cast<ObjHandler::BUTTON_ACTION_t>(valueToInt(entry.value("evAction"_L1)));
+            ev.content = entry.value("content"_L1).toString();
+            ev.item = valueToInt(entry.value("item"_L1), 0);
+            ev.name = entry.value("name"_L1).toString();
+            ev.ID = valueToInt(entry.value("ID"_L1), 0);
+            ev.action = entry.value("action"_L1).toString();
+            ev.port = valueToInt(entry.value("port"_L1), 0);
+            ev.key = valueToInt(entry.value("key"_L1));
+            ev.type = valueToInt(entry.value("type"_L1));
+            ev.flag = valueToInt(entry.value("flag"_L1));
+            ev.value1 = valueToInt(entry.value("value1"_L1));
+            ev.value2 = valueToInt(entry.value("value2"_L1));
+            ev.value3 = valueToInt(entry.value("value3"_L1));
+            ev.text = entry.value("text"_L1).toString();
+            ev.encode = entry.value("encode"_L1).toString();
 
             if (event == "eventShow")
                 pg.eventShow.append(ev);
@@ -1472,169 +1975,189 @@ void TPageHandler::parsePage(const QJsonObject& page)
         }
     }
 
-    parseObjects(&pg, page.value("objects").toArray());
+    parseObjects(&pg, page.value("objects"_L1).toArray());
+
+    if (target)
+    {
+        if (target->objectTable)
+        {
+            target->objectTable->clear();
+            target->objectTable.reset();
+        }
+
+        // Keep the internal states of a page read from the index
+        pg.baseObject = target->baseObject;
+        pg.visible = target->visible;
+        pg.gridVisible = target->gridVisible;
+        pg.snapToGrid = target->snapToGrid;
+        *target = pg;
+        return;
+    }
+
     mPages.append(pg);
 }
 
-void TPageHandler::parseObjects(PAGE_t *page, const QJsonArray& obj)
+template<typename Array>
+void TPageHandler::parseObjects(PAGE_t *page, const Array& obj)
 {
-    DECL_TRACER("TPageHandler::parseObjects(PAGE_t *page, const QJsonArray& obj)");
+    DECL_TRACER("TPageHandler::parseObjects(PAGE_t *page, const Array& obj)");
 
     int setupPort = TConfMain::Current().getSetupPort();
+    TStringPool& pool = TStringPool::Current();
 
-    for (int i = 0; i < obj.count(); ++i)
+    for (int i = 0; i < obj.size(); ++i)
     {
-        QJsonObject jo = obj[i].toObject();
+        auto jo = valueToMap(obj.at(i));
         ObjHandler::TOBJECT_t object;
-        object.type = static_cast<ObjHandler::BUTTONTYPE>(jo.value("type").toInt(ObjHandler::BUTTONTYPE::NONE));
-        object.bi = jo.value("bi").toInt(0);
-        object.na = jo.value("na").toString();
-        object.bd = jo.value("bd").toString();
-        object.li = jo.value("li").toBool(false);
-        object.lt = jo.value("lt").toInt(0);
-        object.tp = jo.value("tp").toInt(0);
-        object.wt = jo.value("wt").toInt(0);
-        object.ht = jo.value("ht").toInt(0);
-        object.zo = jo.value("zo").toInt(0);
-        object.hs = jo.value("hs").toString();
-        object.bs = jo.value("bs").toString();
-        object.fb = static_cast<ObjHandler::FEEDBACK_t>(jo.value("fb").toInt(ObjHandler::FEEDBACK_t::FB_NONE));
-        object.ap = jo.value("ap").toInt(1);
-        object.ad = jo.value("ad").toInt(setupPort);
-        object.ch = jo.value("ch").toInt(setupPort);
-        object.cp = jo.value("cp").toInt(1);
-        object.lp = jo.value("lp").toInt(1);
-        object.lv = jo.value("lv").toInt(setupPort);
-        object.inputType = jo.value("inputType").toInt(1);  // G5 Text input
+        object.type = static_cast<ObjHandler::BUTTONTYPE>(valueToInt(jo.value("type"_L1), ObjHandler::BUTTONTYPE::NONE));
+        object.bi = valueToInt(jo.value("bi"_L1), 0);
+        object.na = jo.value("na"_L1).toString();
+        object.bd = jo.value("bd"_L1).toString();
+        object.li = jo.value("li"_L1).toBool(false);
+        object.lt = valueToInt(jo.value("lt"_L1), 0);
+        object.tp = valueToInt(jo.value("tp"_L1), 0);
+        object.wt = valueToInt(jo.value("wt"_L1), 0);
+        object.ht = valueToInt(jo.value("ht"_L1), 0);
+        object.zo = valueToInt(jo.value("zo"_L1), 0);
+        object.hs = jo.value("hs"_L1).toString();
+        object.bs = jo.value("bs"_L1).toString();
+        object.fb = static_cast<ObjHandler::FEEDBACK_t>(valueToInt(jo.value("fb"_L1), ObjHandler::FEEDBACK_t::FB_NONE));
+        object.ap = valueToInt(jo.value("ap"_L1), 1);
+        object.ad = valueToInt(jo.value("ad"_L1), setupPort);
+        object.ch = valueToInt(jo.value("ch"_L1), setupPort);
+        object.cp = valueToInt(jo.value("cp"_L1), 1);
+        object.lp = valueToInt(jo.value("lp"_L1), 1);
+        object.lv = valueToInt(jo.value("lv"_L1), setupPort);
+        object.inputType = valueToInt(jo.value("inputType"_L1), 1);  // G5 Text input
         // Allthough we read the parameters of the old G4 Listboxes, they're not
         // supported. Instead the G5 Listview is supported.
-        object.ta = jo.value("ta").toInt(0);        // G4 Listbox table channel
-        object.ti = jo.value("ti").toInt(0);        // G4 Listbox table index number of rows (all rows have this number in "cp")
-        object.tr = jo.value("tr").toInt(0);        // G4 Listbox number of rows
-        object.tc = jo.value("tc").toInt(0);        // G4 Listbox number of columns
-        object.tj = jo.value("tj").toInt(0);        // G4 Listbox row height
-        object.tk = jo.value("tk").toInt(0);        // G4 Listbox preferred row height
-        object.of = jo.value("of").toInt(0);        // G4 Listbox list offset: 0=disabled/1=enabled
-        object.tg = jo.value("tg").toInt(0);        // G4 Listbox managed: 0=no/1=yes
-        object.lvc = jo.value("lvc").toInt(0);      // G5 Listview: Listview components? [ ORed values: (2 = Primary Text; 4 = Primary+Secondary Text; 1 = Image only)]
-        object.lvh = jo.value("lvh").toInt(48);     // G5 Listview: Item height
-        object.lvl = jo.value("lvl").toInt(1);      // G5 Listview: Item Layout
-        object.lvg = jo.value("lvg").toInt(1);      // G5 Listview: Number of columns
-        object.lhp = jo.value("lhp").toInt(5);      // G5 Listview: Primary Partition (%)
-        object.lvp = jo.value("lvp").toInt(95);     // G5 Listview: Secondary Partition (%)
-        object.lvs = jo.value("lvs").toInt(0);      // G5 Listview: Filter enabled; 1 = TRUE
-        object.lsh = jo.value("lsh").toInt(24);     // G5 Listview: Filter height
-        object.lva = jo.value("lva").toInt(0);      // G5 Listview: Alphabet scrollbar; 1 = TRUE
-        object.lds = jo.value("lds").toString();    // G5 Listview: Dynamic data source
-        object.ldm = jo.value("ldm").toString();    // G5 Listview: Internal distinct name?
-        object.ddt = jo.value("ddt").toString();    // G5: Drag/Drop type (dr = draggable, dt = drop target)
-        object.so = jo.value("so").toInt(1);        // String output port
-        object.co = jo.value("co").toInt(1);        // Command port
-
-        QJsonArray cm = jo.value("cm").toArray();
-
-        for (int j = 0; j < cm.count(); ++j)
-            object.cm.push_back(cm[j].toString());
-
-        object.dr = jo.value("dr").toString();
-        object.va = jo.value("va").toInt(0);
-        object.stateCount = jo.value("stateCount").toInt(0);
-        object.rm = jo.value("rm").toInt(0);
-        object.nu = jo.value("nu").toInt(2);
-        object.nd = jo.value("nd").toInt(2);
-        object.ar = jo.value("ar").toInt(0);
-        object.ru = jo.value("ru").toInt(2);
-        object.rd = jo.value("rd").toInt(2);
-        object.lu = jo.value("lu").toInt(2);
-        object.ld = jo.value("ld").toInt(2);
-        object.rv = jo.value("rv").toInt(0);
-        object.rl = jo.value("rl").toInt(0);
-        object.rh = jo.value("rh").toInt(255);
-        object.ri = jo.value("ri").toInt(0);
-        object.ji = jo.value("ji").toInt(0);
-        object.rn = jo.value("rn").toInt(0);
-        object.ac_di = jo.value("ac").toInt(0);
-        object.hd = jo.value("hd").toInt(0);
-        object.da = jo.value("da").toInt(0);
-        object.pp = jo.value("pp").toInt(0);
-        object.lf = jo.value("lf").toString();
-        object.sd = jo.value("sd").toString();
-        object.vt = jo.value("vt").toString();
-        object.cd = jo.value("cd").toString();
-        object.sc = QColor(jo.value("sc").toString());
-        object.cc = QColor(jo.value("cc").toString());
-        object.mt = jo.value("mt").toInt(0);
-        object.dt = jo.value("dt").toString();
-        object.im = jo.value("im").toString();
-        object.st = jo.value("st").toInt(0);
-        object.ws = jo.value("ws").toInt(0);
-        object.on = jo.value("on").toString();
-        object.sa = jo.value("sa").toInt(0);
-        object.dy = jo.value("dy").toInt(0);
-        object.rs = jo.value("rs").toInt(0);
-        object.ba = jo.value("ba").toInt(0);
-        object.bo = jo.value("bo").toInt(0);
-        object.sw = jo.value("sw").toInt(1);
-        object.ds = jo.value("ds").toInt(0);
-        object.sdd = jo.value("sdd").toInt(1);
-        object.we = jo.value("we").toString();
-        object.pc = jo.value("pc").toString();
-        object.op = jo.value("op").toString();
-
-        QJsonArray pushFunc = jo.value("pushFunc").toArray();
-
-        for (int j = 0; j < pushFunc.count(); ++j)
+        object.ta = valueToInt(jo.value("ta"_L1), 0);       // G4 Listbox table channel
+        object.ti = valueToInt(jo.value("ti"_L1), 0);       // G4 Listbox table index number of rows (all rows have this number in "cp")
+        object.tr = valueToInt(jo.value("tr"_L1), 0);       // G4 Listbox number of rows
+        object.tc = valueToInt(jo.value("tc"_L1), 0);       // G4 Listbox number of columns
+        object.tj = valueToInt(jo.value("tj"_L1), 0);       // G4 Listbox row height
+        object.tk = valueToInt(jo.value("tk"_L1), 0);       // G4 Listbox preferred row height
+        object.of = valueToInt(jo.value("of"_L1), 0);       // G4 Listbox list offset: 0=disabled/1=enabled
+        object.tg = valueToInt(jo.value("tg"_L1), 0);       // G4 Listbox managed: 0=no/1=yes
+        object.lvc = valueToInt(jo.value("lvc"_L1), 0);     // G5 Listview: Listview components? [ ORed values: (2 = Primary Text; 4 = Primary+Secondary Text; 1 = Image only)]
+        object.lvh = valueToInt(jo.value("lvh"_L1), 48);    // G5 Listview: Item height
+        object.lvl = valueToInt(jo.value("lvl"_L1), 1);     // G5 Listview: Item Layout
+        object.lvg = valueToInt(jo.value("lvg"_L1), 1);     // G5 Listview: Number of columns
+        object.lhp = valueToInt(jo.value("lhp"_L1), 5);     // G5 Listview: Primary Partition (%)
+        object.lvp = valueToInt(jo.value("lvp"_L1), 95);    // G5 Listview: Secondary Partition (%)
+        object.lvs = valueToInt(jo.value("lvs"_L1), 0);     // G5 Listview: Filter enabled; 1 = TRUE
+        object.lsh = valueToInt(jo.value("lsh"_L1), 24);    // G5 Listview: Filter height
+        object.lva = valueToInt(jo.value("lva"_L1), 0);     // G5 Listview: Alphabet scrollbar; 1 = TRUE
+        object.lds = jo.value("lds"_L1).toString();         // G5 Listview: Dynamic data source
+        object.ldm = jo.value("ldm"_L1).toString();         // G5 Listview: Internal distinct name?
+        object.ddt = jo.value("ddt"_L1).toString();         // G5: Drag/Drop type (dr = draggable, dt = drop target)
+        object.so = valueToInt(jo.value("so"_L1), 1);       // String output port
+        object.co = valueToInt(jo.value("co"_L1), 1);       // Command port
+
+        auto cm = jo.value("cm"_L1).toArray();
+
+        for (int j = 0; j < cm.size(); ++j)
+            object.cm.push_back(cm.at(j).toString());
+
+        object.dr = jo.value("dr"_L1).toString();
+        object.va = valueToInt(jo.value("va"_L1), 0);
+        object.stateCount = valueToInt(jo.value("stateCount"_L1), 0);
+        object.rm = valueToInt(jo.value("rm"_L1), 0);
+        object.nu = valueToInt(jo.value("nu"_L1), 2);
+        object.nd = valueToInt(jo.value("nd"_L1), 2);
+        object.ar = valueToInt(jo.value("ar"_L1), 0);
+        object.ru = valueToInt(jo.value("ru"_L1), 2);
+        object.rd = valueToInt(jo.value("rd"_L1), 2);
+        object.lu = valueToInt(jo.value("lu"_L1), 2);
+        object.ld = valueToInt(jo.value("ld"_L1), 2);
+        object.rv = valueToInt(jo.value("rv"_L1), 0);
+        object.rl = valueToInt(jo.value("rl"_L1), 0);
+        object.rh = valueToInt(jo.value("rh"_L1), 255);
+        object.ri = valueToInt(jo.value("ri"_L1), 0);
+        object.ji = valueToInt(jo.value("ji"_L1), 0);
+        object.rn = valueToInt(jo.value("rn"_L1), 0);
+        object.ac_di = valueToInt(jo.value("ac"_L1), 0);
+        object.hd = valueToInt(jo.value("hd"_L1), 0);
+        object.da = valueToInt(jo.value("da"_L1), 0);
+        object.pp = valueToInt(jo.value("pp"_L1), 0);
+        object.lf = jo.value("lf"_L1).toString();
+        object.sd = jo.value("sd"_L1).toString();
+        object.vt = jo.value("vt"_L1).toString();
+        object.cd = jo.value("cd"_L1).toString();
+        object.sc = QColor(jo.value("sc"_L1).toString());
+        object.cc = QColor(jo.value("cc"_L1).toString());
+        object.mt = valueToInt(jo.value("mt"_L1), 0);
+        object.dt = jo.value("dt"_L1).toString();
+        object.im = jo.value("im"_L1).toString();
+        object.st = valueToInt(jo.value("st"_L1), 0);
+        object.ws = valueToInt(jo.value("ws"_L1), 0);
+        object.on = jo.value("on"_L1).toString();
+        object.sa = valueToInt(jo.value("sa"_L1), 0);
+        object.dy = valueToInt(jo.value("dy"_L1), 0);
+        object.rs = valueToInt(jo.value("rs"_L1), 0);
+        object.ba = valueToInt(jo.value("ba"_L1), 0);
+        object.bo = valueToInt(jo.value("bo"_L1), 0);
+        object.sw = valueToInt(jo.value("sw"_L1), 1);
+        object.ds = valueToInt(jo.value("ds"_L1), 0);
+        object.sdd = valueToInt(jo.value("sdd"_L1), 1);
+        object.we = jo.value("we"_L1).toString();
+        object.pc = jo.value("pc"_L1).toString();
+        object.op = jo.value("op"_L1).toString();
+
+        auto pushFunc = jo.value("pushFunc"_L1).toArray();
+
+        for (int j = 0; j < pushFunc.size(); ++j)
         {
             ObjHandler::PUSH_FUNC_T pf;
-            QJsonObject jpf = pushFunc[j].toObject();
-            pf.item = jpf.value("item").toInt(0);
-            pf.pfType = jpf.value("pfType").toString();
-            pf.pfAction = jpf.value("pfAction").toString();
-            pf.pfName = jpf.value("pfName").toString();
-            pf.action = static_cast<ObjHandler::BUTTON_ACTION_t>(jpf.value("action").toInt(ObjHandler::BUTTON_ACTION_t::BT_ACTION_PGFLIP));
-            pf.ID = jpf.value("id").toInt(0);
-            pf.event = static_cast<ObjHandler::BUTTON_EVENT_t>(jpf.value("event").toInt(ObjHandler::BUTTON_EVENT_t::EVENT_NONE));
+            auto jpf = valueToMap(pushFunc.at(j));
+            pf.item = valueToInt(jpf.value("item"_L1), 0);
+            pf.pfType = jpf.value("pfType"_L1).toString();
+            pf.pfAction = jpf.value("pfAction"_L1).toString();
+            pf.pfName = jpf.value("pfName"_L1).toString();
+            pf.action = static_cast<ObjHandler::BUTTON_ACTION_t>(valueToInt(jpf.value("action"_L1), ObjHandler::BUTTON_ACTION_t::BT_ACTION_PGFLIP));
+            pf.ID = valueToInt(jpf.value("id"_L1), 0);
+            pf.event = static_cast<ObjHandler::BUTTON_EVENT_t>(valueToInt(jpf.value("event"_L1), ObjHandler::BUTTON_EVENT_t::EVENT_NONE));
             object.pushFunc.push_back(pf);
         }
 
-        QJsonArray sr = jo.value("sr").toArray();
+        auto sr = jo.value("sr"_L1).toArray();
 
-        for (int j = 0; j < sr.count(); ++j)
+        for (int j = 0; j < sr.size(); ++j)
         {
-            QJsonObject jsr = sr[j].toObject();
+            auto jsr = valueToMap(sr.at(j));
             ObjHandler::SR_T s;
-            s.number = jsr.value("number").toInt(0);
-            s._do = jsr.value("do").toString();
-            s.bs = jsr.value("bs").toString();
-            s.mi = jsr.value("mi").toString();
-            s.cb = QColor(jsr.value("cb").toString("#ffff0000"));      // Border color
-            s.ft = jsr.value("ft").toString("solid");
-            s.cf = QColor(jsr.value("cf").toString(TConfMain::Current().getColorBackground().name(QColor::HexArgb)));      // Fill color
-            s.ct = QColor(jsr.value("ct").toString(TConfMain::Current().getColorText().name(QColor::HexArgb)));      // Text color
-            s.ec = QColor(jsr.value("ec").toString("#ff808080"));      // Text effect color
-            s.lc = QColor(jsr.value("lc").toString("#ffffff"));
-            s.bm = jsr.value("bm").toString();
-            QJsonArray bitmaps = jsr.value("bitmapEntries").toArray();
-
-            for (int k = 0; k < bitmaps.count(); ++k)
+            s.number = valueToInt(jsr.value("number"_L1), 0);
+            s._do = pool.intern(jsr.value("do"_L1).toString());
+            s.bs = pool.intern(jsr.value("bs"_L1).toString());
+            s.mi = pool.intern(jsr.value("mi"_L1).toString());
+            s.cb = QColor(jsr.value("cb"_L1).toString("#ffff0000"));      // Border color
+            s.ft = pool.intern(jsr.value("ft"_L1).toString("solid"));
+            s.cf = QColor(jsr.value("cf"_L1).toString(TConfMain::Current().getColorBackground().name(QColor::HexArgb)));      // Fill color
+            s.ct = QColor(jsr.value("ct"_L1).toString(TConfMain::Current().getColorText().name(QColor::HexArgb)));      // Text color
+            s.ec = QColor(jsr.value("ec"_L1).toString("#ff808080"));      // Text effect color
+            s.lc = QColor(jsr.value("lc"_L1).toString("#ffffff"));
+            s.bm = pool.intern(jsr.value("bm"_L1).toString());
+            auto bitmaps = jsr.value("bitmapEntries"_L1).toArray();
+
+            for (int k = 0; k < bitmaps.size(); ++k)
             {
-                QJsonObject bm = bitmaps[k].toObject();
+                auto bm = valueToMap(bitmaps.at(k));
                 ObjHandler::BITMAPS_t m;
-                m.fileName = bm.value("fileName").toString();
-                m.index = bm.value("index").toInt(k);
-                m.dynamic = bm.value("dynamic").toBool(false);
-                m.justification = static_cast<ObjHandler::ORIENTATION>(bm.value("justification").toInt(ObjHandler::ORIENTATION::ORI_CENTER_MIDDLE));
-                m.offsetX = bm.value("offsetX").toInt(0);
-                m.offsetY = bm.value("offsetY").toInt(0);
+                m.fileName = pool.intern(bm.value("fileName"_L1).toString());
+                m.index = valueToInt(bm.value("index"_L1), k);
+                m.dynamic = bm.value("dynamic"_L1).toBool(false);
+                m.justification = static_cast<ObjHandler::ORIENTATION>(valueToInt(bm.value("justification"_L1), ObjHandler::ORIENTATION::ORI_CENTER_MIDDLE));
+                m.offsetX = valueToInt(bm.value("offsetX"_L1), 0);
+                m.offsetY = valueToInt(bm.value("offsetY"_L1), 0);
                 s.bitmaps.append(m);
             }
 
-            QJsonArray gradients = jsr.value("gradientColors").toArray();
+            auto gradients = jsr.value("gradientColors"_L1).toArray();
 
-            if (gradients.count() > 0)
+            if (gradients.size() > 0)
             {
-                for (int k = 0; k < gradients.count(); ++k)
-                    s.gradientColors.append(gradients[k].toString());
+                for (int k = 0; k < gradients.size(); ++k)
+                    s.gradientColors.append(gradients.at(k).toString());
             }
             else
             {
@@ -1642,29 +2165,29 @@ void TPageHandler::parseObjects(PAGE_t *page, const QJsonArray& obj)
                 s.gradientColors.append(Qt::white);
             }
 
-            s.gr = jsr.value("gr").toInt(15);
-            s.gx = jsr.value("gx").toInt(50);
-            s.gy = jsr.value("gy").toInt(50);
-            s.sd = jsr.value("sd").toString();
-            s.dynamic = jsr.value("dynamic").toBool(false);
-            s.sb = jsr.value("sb").toInt(0);
-            s.jb = jsr.value("jb").toInt(5);
-            s.bx = jsr.value("bx").toInt(0);
-            s.by = jsr.value("by").toInt(0);
-            s.fi = jsr.value("fi").toInt(0);
-            s.te = jsr.value("te").toString();
-            s.jt = static_cast<ObjHandler::ORIENTATION>(jsr.value("jt").toInt(ObjHandler::ORIENTATION::ORI_CENTER_MIDDLE));
-            s.tx = jsr.value("tx").toInt(0);
-            s.ty = jsr.value("ty").toInt(0);
-            s.ff = jsr.value("ff").toString(TConfMain::Current().getFontBase().family());
-            s.fs = jsr.value("fs").toInt(TConfMain::Current().getFontBaseSize());
-            s.ww = jsr.value("ww").toInt(0);
-            s.et = jsr.value("et").toInt(0);
-            s.oo = jsr.value("oo").toInt(255);
-            s.md = jsr.value("md").toInt(0);
-            s.mr = jsr.value("mr").toInt(0);
-            s.ms = jsr.value("ms").toInt(1);
-            s.vf = jsr.value("vf").toString();
+            s.gr = valueToInt(jsr.value("gr"_L1), 15);
+            s.gx = valueToInt(jsr.value("gx"_L1), 50);
+            s.gy = valueToInt(jsr.value("gy"_L1), 50);
+            s.sd = pool.intern(jsr.value("sd"_L1).toString());
+            s.dynamic = jsr.value("dynamic"_L1).toBool(false);
+            s.sb = valueToInt(jsr.value("sb"_L1), 0);
+            s.jb = valueToInt(jsr.value("jb"_L1), 5);
+            s.bx = valueToInt(jsr.value("bx"_L1), 0);
+            s.by = valueToInt(jsr.value("by"_L1), 0);
+            s.fi = valueToInt(jsr.value("fi"_L1), 0);
+            s.te = jsr.value("te"_L1).toString();
+            s.jt = static_cast<ObjHandler::ORIENTATION>(valueToInt(jsr.value("jt"_L1), ObjHandler::ORIENTATION::ORI_CENTER_MIDDLE));
+            s.tx = valueToInt(jsr.value("tx"_L1), 0);
+            s.ty = valueToInt(jsr.value("ty"_L1), 0);
+            s.ff = pool.intern(jsr.value("ff"_L1).toString(TConfMain::Current().getFontBase().family()));
+            s.fs = valueToInt(jsr.value("fs"_L1), TConfMain::Current().getFontBaseSize());
+            s.ww = valueToInt(jsr.value("ww"_L1), 0);
+            s.et = valueToInt(jsr.value("et"_L1), 0);
+            s.oo = valueToInt(jsr.value("oo"_L1), 255);
+            s.md = valueToInt(jsr.value("md"_L1), 0);
+            s.mr = valueToInt(jsr.value("mr"_L1), 0);
+            s.ms = valueToInt(jsr.value("ms"_L1), 1);
+            s.vf = pool.intern(jsr.value("vf"_L1).toString());
             object.sr.append(s);
         }
 
@@ -1751,7 +2274,7 @@ bool TPageHandler::readAMXPages(const QStringList& list)
             if (pg->srPage.ii > 0)
             {
                 ObjHandler::BITMAPS_t bm;
-                bm.fileName = icons.getIcon(pg->srPage.ii);
+                bm.fileName = TStringPool::Current().intern(icons.getIcon(pg->srPage.ii));
                 bm.justification = static_cast<ObjHandler::ORIENTATION>(pg->srPage.ji);
                 bm.offsetX = pg->srPage.ix;
                 bm.offsetY = pg->srPage.iy;
@@ -1778,7 +2301,7 @@ bool TPageHandler::readAMXPages(const QStringList& list)
                     if (iter->ii > 0)
                     {
                         ObjHandler::BITMAPS_t bm;
-                        bm.fileName = icons.getIcon(pg->srPage.ii);
+                        bm.fileName = TStringPool::Current().intern(icons.getIcon(pg->srPage.ii));
                         bm.justification = static_cast<ObjHandler::ORIENTATION>(pg->srPage.ji);
                         bm.offsetX = pg->srPage.ix;
                         bm.offsetY = pg->srPage.iy;
@@ -1794,6 +2317,7 @@ bool TPageHandler::readAMXPages(const QStringList& list)
         f.remove();
     }
 
+    TStringPool::Current().logStatistics();
     // Save the just read pages
     saveAllPages();
 
@@ -1811,7 +2335,7 @@ void TPageHandler::parseBitmapEntry(ObjHandler::SR_T *sr, const QDomNodeList& bi
 
     for (int i = 0; i < bitmapEntry.count(); ++i)
     {
-        bitmap.fileName = bitmapEntry.at(i).firstChildElement("fileName").text();
+        bitmap.fileName = TStringPool::Current().intern(bitmapEntry.at(i).firstChildElement("fileName").text());
 
         if (!bitmapEntry.at(i).firstChildElement("justification").isNull())
             bitmap.justification = static_cast<ObjHandler::ORIENTATION>(bitmapEntry.at(i).firstChildElement("justification").text().toInt());
@@ -1849,11 +2373,12 @@ void TPageHandler::parseSR(ObjHandler::TOBJECT_t *object, const QDomElement &sr)
 {
     DECL_TRACER("TPageHandler::parseSR(ObjHandler::TOBJECT_t *object, const QDomElement &sr) ");
 
+    TStringPool& pool = TStringPool::Current();
     ObjHandler::SR_T lsr;
     lsr.number = sr.attribute("number").toInt();
-    lsr.bs = sr.firstChildElement("bs").text();
-    lsr._do = sr.firstChildElement("do").text();
-    lsr.ft = sr.firstChildElement("ft").text();
+    lsr.bs = pool.intern(sr.firstChildElement("bs").text());
+    lsr._do = pool.intern(sr.firstChildElement("do").text());
+    lsr.ft = pool.intern(sr.firstChildElement("ft").text());
     lsr.cb = getColor(sr.firstChildElement("cb").text());
     lsr.cf = getColor(sr.firstChildElement("cf").text());
     lsr.ct = getColor(sr.firstChildElement("ct").text());
@@ -1865,12 +2390,12 @@ void TPageHandler::parseSR(ObjHandler::TOBJECT_t *object, const QDomElement &sr)
         lsr.lc = qRgb(255, 255, 255);
 
     if (!sr.firstChildElement("mi").isNull())
-        lsr.mi = sr.firstChildElement("mi").text();
+        lsr.mi = pool.intern(sr.firstChildElement("mi").text());
 
     if (!TConfMain::Current().isG5() && !sr.firstChildElement("bm").isNull())
     {
         ObjHandler::BITMAPS_t bitmap;
-        bitmap.fileName = sr.firstChildElement("bm").text();
+        bitmap.fileName = pool.intern(sr.firstChildElement("bm").text());
         bitmap.dynamic = sr.firstChildElement("bm").attribute("dynamic").toInt();
         bitmap.index = 0;
 
@@ -1893,9 +2418,9 @@ void TPageHandler::parseSR(ObjHandler::TOBJECT_t *object, const QDomElement &sr)
     parseGradientColors(&lsr.gradientColors, gradColors);
 
     if (!sr.firstChildElement("ff").isNull())
-        lsr.ff = TFonts::getFontNameFromFile(sr.firstChildElement("ff").text());
+        lsr.ff = pool.intern(TFonts::getFontNameFromFile(sr.firstChildElement("ff").text()));
     else
-        lsr.ff = TFonts::getFontName(TConfMain::Current().getFontBase().family());
+        lsr.ff = pool.intern(TFonts::getFontName(TConfMain::Current().getFontBase().family()));
 
     if (!sr.firstChildElement("fs").isNull())
         lsr.fs = sr.firstChildElement("fs").text().toInt();
@@ -1929,7 +2454,7 @@ void TPageHandler::parseSR(ObjHandler::TOBJECT_t *object, const QDomElement &sr)
         lsr.gy = sr.firstChildElement("gy").text().toInt();
 
     if (!sr.firstChildElement("sd").isNull())
-        lsr.sd = sr.firstChildElement("sd").text();
+        lsr.sd = pool.intern(sr.firstChildElement("sd").text());
 
     if (!sr.firstChildElement("dynamic").isNull())
         lsr.dynamic = sr.firstChildElement("dynamic").text().toInt() == 0 ? false : true;
@@ -1973,12 +2498,12 @@ void TPageHandler::parseSR(ObjHandler::TOBJECT_t *object, const QDomElement &sr)
         lsr.ms = sr.firstChildElement("ms").text().toInt();
 
     if (!sr.firstChildElement("vf").isNull())
-        lsr.vf = sr.firstChildElement("vf").text();
+        lsr.vf = pool.intern(sr.firstChildElement("vf").text());
 
     if (lsr.fi > 0)
     {
         QFont font = TFonts::getFontFromIndex(lsr.fi);
-        lsr.ff = TFonts::getFontName(font);
+        lsr.ff = pool.intern(TFonts::getFontName(font));
         lsr.fs = font.pointSize();
     }
 
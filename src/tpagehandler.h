@@ -22,11 +22,15 @@
 #include <QString>
 #include <QList>
 #include <QColor>
+#include <QHash>
+
+#include <memory>
 
 #include "tobjecthandler.h"
 #include "tmisc.h"
 
 class TCanvasWidget;
+class TObjectTable;
 class QMdiArea;
 class QDomElement;
 class QDomNodeList;
@@ -162,6 +166,8 @@ namespace Page
         bool visible{false};                    // Internal use: TRUE = The page/popup is visible as MDI window
         bool gridVisible{false};                // Internal use: TRUE = Grid is visible
         bool snapToGrid{true};                  // Internal use: FALSE = No snap to grid
+        bool loaded{true};                      // Internal use: FALSE = Only the header is read; the body is parsed on demand
+        std::shared_ptr<TObjectTable> objectTable;  // Internal use: Geometry side table of the objects; created on demand; shared by copies
         int ap{0};                              // Default: 0; Address port
         int ad{1};                              // Default: 1; Address code
         int cp{0};                              // Default: 0; Channel port
@@ -242,6 +248,7 @@ class TPageHandler : public QObject
         void removeObject(int pageID, int bi);
         // Getter/Setter
         Page::PAGE_t *getPage(int number);
+        Page::PAGE_t *getPageHeader(int number);
         Page::PAGE_t *getPage(const QString& name);
         Page::PAGE_t *getPopup(const QString& name);
         Page::PAGE_t *getSubPage(const QString& name);
@@ -266,14 +273,23 @@ class TPageHandler : public QObject
         void setSelectedToolToAllPages(TOOL t);
         QList<ObjHandler::TOBJECT_t> getObjectList(const Page::PAGE_t& page);
         void setObjectGeometry(int pageID, int bi, const QRect& geom);
+        TObjectTable *getObjectTable(int pageID);
+        int getObjectAt(int pageID, const QPoint& pt, bool visibleOnly=true);
+        QList<int> getObjectsIn(int pageID, const QRect& rect, bool visibleOnly=true);
+        bool ensureLoaded(Page::PAGE_t *page);
 
     protected:
         bool savePage(const Page::PAGE_t& page);
         bool savePopup(const Page::PAGE_t& popup);
+        bool writePageFile(const QString& name, const QJsonObject& root);
+        bool readPageFile(const QString& name, Page::PAGE_t *target=nullptr);
+        QString findPageFile(const QString& name);
         void saveEvents(const Page::PAGE_t& page, QJsonObject *root);
         QJsonObject getSr(Page::PAGE_TYPE pt, const Page::SR_t& sr, int number=0);
-        void parsePage(const QJsonObject& page);
-        void parseObjects(Page::PAGE_t *page, const QJsonArray& obj);
+        template<typename Map> void parsePage(const Map& page, Page::PAGE_t *target=nullptr);
+        bool writePageIndex();
+        bool readPageIndex(QHash<QString, Page::PAGE_t> *index);
+        template<typename Array> void parseObjects(Page::PAGE_t *page, const Array& obj);
         QJsonArray getObjects(const QList<TObjectHandler *>& objects);
         Page::PAGE_t *getPagePointer(int num);
         int parsePage(const QDomElement &page);
@@ -296,6 +312,7 @@ class TPageHandler : public QObject
         QList<Page::PAGE_t> mPages;
         int mMaxPageNumber{0};
         int mMaxPopupNumber{500};
+        int mUnloadedPages{0};                  // Number of pages with only the header read
         STATE_TYPE mCurrentState{STATE_UNKNOWN};
 };
 
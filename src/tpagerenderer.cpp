@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <QPainter>
+#include <QPixmap>
+#include <QFont>
+
+#include "tpagerenderer.h"
+#include "tobjecthandler.h"
+#include "tobjecttable.h"
+#include "tdrawobject.h"
+#include "tdrawimage.h"
+#include "tgradientcache.h"
+#include "ttextrenderer.h"
+#include "terror.h"
+
+using namespace Page;
+using namespace ObjHandler;
+
+/**
+ * @brief TPageRenderer::renderPage
+ * Composes the page or popup with the ID \b pageID. If only the header of
+ * the page was read so far, the body is loaded.
+ *
+ * @param pageID    The ID of the page or popup.
+ * @param instance  The instance (state) of the objects to draw. Objects
+ * with less instances are drawn with their first instance.
+ * @return The image of the page or a null image on error.
+ */
+QImage TPageRenderer::renderPage(int pageID, int instance)
+{
+    DECL_TRACER("TPageRenderer::renderPage(int pageID, int instance)");
+
+    PAGE_t *page = TPageHandler::Current().getPage(pageID);
+    TPageHandler::Current().ensureLoaded(page);
+    return renderPage(page, instance);
+}
+
+QImage TPageRenderer::renderPage(PAGE_t *page, int instance)
+{
+    DECL_TRACER("TPageRenderer::renderPage(PAGE_t *page, int instance)");
+
+    if (!page || page->pageID <= 0 || page->width <= 0 || page->height <= 0)
+    {
+        MSG_ERROR("Got no valid page to render!");
+        return QImage();
+    }
+
+    const QRect rect(0, 0, page->width, page->height);
+    QPixmap background(rect.size());
+    background.fill(Qt::transparent);
+    QPainter p(&background);
+
+    if (page->srPage.vf == "100" || page->srPage.vf == "101")
+        p.drawPixmap(rect, QPixmap(":images/videostream.png"));
+    else
+    {
+        GRAD_TYPE_t grad = TDrawObject::getGradientType(page->srPage.ft);
+
+        if (grad == GRAD_SOLID)
+            p.fillRect(rect, page->srPage.cf);
+        else
+            p.drawImage(0, 0, TGradientCache::Current().getImage(grad, page->srPage.gradientColors, rect.size(), page->srPage.gx, page->srPage.gy, page->srPage.gr));
+    }
+
+    p.end();
+
+    if (!page->srPage.bitmaps.empty())
+    {
+        TDrawImage drawImage;
+        drawImage.setPixmap(&background);
+        drawImage.setSize(page->width, page->height);
+        drawImage.setBitmaps(page->srPage.bitmaps);
+        drawImage.draw();
+    }
+
+    QImage img = background.toImage().convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    if (!page->srPage.te.isEmpty())
+        drawText(&img, *page);
+
+    QPainter painter(&img);
+    // The objects are drawn from the bottom to the top most one.
+    TObjectTable *table = TPageHandler::Current().getObjectTable(page->pageID);
+    const QList<TObjectHandler *> objects = table ? table->getZOrdered() : page->objects;
+
+    for (TObjectHandler *object : objects)
+    {
+        if (!object)
+            continue;
+
+        const TOBJECT_t& obj = object->getObject();
+        int inst = instance >= 0 && instance < obj.sr.size() ? instance : 0;
+        QPixmap pm = object->render(inst);
+
+        if (pm.isNull())
+        {
+            MSG_WARNING("Object " << obj.bi << " of page " << page->pageID << " couldn't be drawn!");
+            continue;
+        }
+
+        painter.drawPixmap(obj.lt, obj.tp, pm);
+    }
+
+    painter.end();
+    return img;
+}
+
+/**
+ * @brief TPageRenderer::getBackground
+ * Creates the brush for the background of a page. This is either the
+ * fill color or a gradient of the gradient colors.
+ *
+ * @param page  The page.
+ * @param rect  The area of the page.
+ * @return The brush.
+ */
+QBrush TPageRenderer::getBackground(const PAGE_t& page, const QRect& rect)
+{
+    DECL_TRACER("TPageRenderer::getBackground(const PAGE_t& page, const QRect& rect)");
+
+    GRAD_TYPE_t grad = TDrawObject::getGradientType(page.srPage.ft);
+
+    if (grad == GRAD_SOLID)
+        return QBrush(page.srPage.cf);
+
+    // Radial and linear gradients cover the page, the sweep the widget.
+    QSize size = (grad == GRAD_SWEEP) ? rect.size() : QSize(page.width, page.height);
+    return TGradientCache::getBrush(grad, page.srPage.gradientColors, size, page.srPage.gx, page.srPage.gy, page.srPage.gr);
+}
+
+/**
+ * @brief TPageRenderer::drawText
+ * Draws the text of the page. The position is the same as the label
+ * TDrawText puts on the canvas.
+ *
+ * @param img   The image of the page.
+ * @param page  The page.
+ */
+void TPageRenderer::drawText(QImage *img, const PAGE_t& page)
+{
+    DECL_TRACER("TPageRenderer::drawText(QImage *img, const PAGE_t& page)");
+
+    QFont font(page.srPage.ff);
+
+    if (page.srPage.fs > 0)
+        font.setPointSize(page.srPage.fs);
+
+    QRect rect(0, 0, page.width, page.height);
+    int align = Qt::AlignCenter;
+
+    switch(page.srPage.jt)
+    {
+        case ORI_ABSOLUT:
+            rect = QRect(page.srPage.tx, page.srPage.ty, page.width - page.srPage.tx, page.height - page.srPage.ty);
+            align = Qt::AlignTop | Qt::AlignLeft;
+        break;
+
+        case ORI_TOP_LEFT:      align = Qt::AlignTop | Qt::AlignLeft; break;
+        case ORI_TOP_MIDDLE:    align = Qt::AlignTop | Qt::AlignHCenter; break;
+        case ORI_TOP_RIGHT:     align = Qt::AlignTop | Qt::AlignRight; break;
+        case ORI_CENTER_LEFT:   align = Qt::AlignVCenter | Qt::AlignLeft; break;
+        case ORI_CENTER_MIDDLE: align = Qt::AlignCenter; break;
+        case ORI_CENTER_RIGHT:  align = Qt::AlignVCenter | Qt::AlignRight; break;
+        case ORI_BOTTOM_LEFT:   align = Qt::AlignBottom | Qt::AlignLeft; break;
+        case ORI_BOTTOM_MIDDLE: align = Qt::AlignBottom | Qt::AlignHCenter; break;
+        case ORI_BOTTOM_RIGHT:  align = Qt::AlignBottom | Qt::AlignRight; break;
+
+        default:
+            align = Qt::AlignCenter;
+    }
+
+    QImage text = TTextRenderer::Current().render(page.srPage.te, font, rect.size(), align, page.srPage.ct, page.srPage.ec, page.srPage.et);
+
+    if (text.isNull())
+        return;
+
+    QPainter p(img);
+    p.drawImage(rect.topLeft(), text);
+    p.end();
+}
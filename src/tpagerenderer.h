@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TPAGERENDERER_H
+#define TPAGERENDERER_H
+
+#include <QImage>
+#include <QBrush>
+#include <QRect>
+
+#include "tpagehandler.h"
+
+/**
+ * @brief The TPageRenderer class
+ * Composes a page or popup with all its objects into an image without
+ * creating any widget. The background, the bitmaps and the text of the
+ * page are drawn the same way as on the canvas. The objects are drawn by
+ * TObjectHandler::render(), which uses the same drawing code as the
+ * editor and keeps the images of the objects.
+ *
+ * The class is used for thumbnails and for exporting pages as images.
+ */
+class TPageRenderer
+{
+    public:
+        static QImage renderPage(int pageID, int instance=0);
+        static QImage renderPage(Page::PAGE_t *page, int instance=0);
+        static QBrush getBackground(const Page::PAGE_t& page, const QRect& rect);
+
+    private:
+        static void drawText(QImage *img, const Page::PAGE_t& page);
+};
+
+#endif // TPAGERENDERER_H
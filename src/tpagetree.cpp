@@ -19,9 +19,15 @@
 #include <QTreeView>
 #include <QMenu>
 #include <QCursor>
+#include <QLabel>
+#include <QHelpEvent>
+#include <QMouseEvent>
+#include <QIcon>
+#include <QStandardItemModel>
 
 #include "tpagetree.h"
 #include "tcustomitem.h"
+#include "tthumbnailcache.h"
 #include "terror.h"
 
 TPageTree::TPageTree(QTreeView *tree, QWidget *parent)
@@ -29,11 +35,16 @@ TPageTree::TPageTree(QTreeView *tree, QWidget *parent)
       mParent(parent)
 {
     DECL_TRACER("TPageTree::TPageTree(QTreeView *tree, QWidget *parent)");
+
+    connect(&TThumbnailCache::Current(), &TThumbnailCache::thumbnailChanged, this, &TPageTree::setThumbnail);
 }
 
 TPageTree::~TPageTree()
 {
     DECL_TRACER("TPageTree::~TPageTree()");
+
+    if (mPreview)
+        delete mPreview;
 }
 
 /**
@@ -151,6 +162,9 @@ void TPageTree::makeTree(const QString& job, const QString& panel, const QString
     }
 
     mTreeView->expandAll();
+    // Installing the same filter again has no effect.
+    mTreeView->viewport()->installEventFilter(this);
+    mTreeView->viewport()->setMouseTracking(true);
     connect(mTreeView, &QTreeView::pressed, this, &TPageTree::onClicked);
     connect(mTreeView, &QTreeView::doubleClicked, this, &TPageTree::onDoubleClicked);
 }
@@ -167,6 +181,7 @@ void TPageTree::resetTree()
     if (!mTreeView)
         return;
 
+    hidePreview();
     mTreeView->reset();
     disconnect(mTreeView, &QTreeView::pressed, this, &TPageTree::onClicked);
     disconnect(mTreeView, &QTreeView::doubleClicked, this, &TPageTree::onDoubleClicked);
@@ -193,6 +208,7 @@ void TPageTree::addTreePage(const QString& name, int num)
     QStandardItem *pg = new QStandardItem(name);
     pg->setEditable(false);
     pg->setData(num);
+    pg->setIcon(getThumbnailIcon(num));
     mPages->appendRow(pg);
 }
 
@@ -219,6 +235,7 @@ void TPageTree::addTreePopup(const QString& name, const QString& group, int num)
     TCustomItem *pg = new TCustomItem(name);
     pg->setEditable(false);
     pg->setData(num);
+    pg->setIcon(getThumbnailIcon(num));
 
     if (!group.isEmpty())
     {
@@ -270,6 +287,7 @@ void TPageTree::addTreeSubPage(const QString& name, int num)
     TCustomItem *pg = new TCustomItem(name);
     pg->setEditable(false);
     pg->setData(num);
+    pg->setIcon(getThumbnailIcon(num));
     mSubPages->appendRow(pg);
     mSubPages->sortChildren(0);
 }
@@ -774,3 +792,157 @@ void TPageTree::onMenuTriggeredDelete(bool checked)
     Q_UNUSED(checked);
     MSG_DEBUG("Popup action: Delete");
 }
+
+/**
+ * @brief TPageTree::setThumbnail
+ * Updates the icon of a page, popup or subpage with its current
+ * thumbnail. If the preview currently shows this page, it is updated too.
+ *
+ * @param pageID    The ID of the page.
+ */
+void TPageTree::setThumbnail(int pageID)
+{
+    DECL_TRACER("TPageTree::setThumbnail(int pageID)");
+
+    if (!mItemModel)
+        return;
+
+    QStandardItem *item = findPageItem(mItemModel->invisibleRootItem(), pageID);
+
+    if (item)
+        item->setIcon(getThumbnailIcon(pageID));
+
+    // The mouse may still rest over the page the thumbnail was requested for.
+    if (mPreview && mPreviewID == pageID)
+        showPreview(pageID, mPreview->pos());
+}
+
+/**
+ * @brief TPageTree::eventFilter
+ * Shows the thumbnail of a page as a preview while the mouse rests over
+ * its entry in the tree. If there is no thumbnail yet, it is requested
+ * and the preview appears as soon as it was made.
+ */
+bool TPageTree::eventFilter(QObject *watched, QEvent *event)
+{
+//    DECL_TRACER("TPageTree::eventFilter(QObject *watched, QEvent *event)");
+
+    if (!mTreeView || !mItemModel || watched != mTreeView->viewport())
+        return QObject::eventFilter(watched, event);
+
+    if (event->type() == QEvent::ToolTip)
+    {
+        QHelpEvent *he = static_cast<QHelpEvent *>(event);
+        QStandardItem *item = mItemModel->itemFromIndex(mTreeView->indexAt(he->pos()));
+
+        if (!item || item->data().toInt() >= MENU_PAGE)
+        {
+            hidePreview();
+            return QObject::eventFilter(watched, event);
+        }
+
+        int pageID = item->data().toInt();
+        QPoint pos = he->globalPos() + QPoint(16, 16);
+
+        if (TThumbnailCache::Current().getThumbnail(pageID).isNull())
+        {
+            // The preview is shown by setThumbnail() as soon as the
+            // thumbnail exists.
+            mPreviewID = pageID;
+            TThumbnailCache::Current().request(pageID);
+
+            if (!mPreview)
+                mPreview = new QLabel(nullptr, Qt::ToolTip);
+
+            mPreview->move(pos);
+        }
+        else
+            showPreview(pageID, pos);
+
+        return true;
+    }
+    else if (event->type() == QEvent::Leave)
+        hidePreview();
+    else if (event->type() == QEvent::MouseMove && mPreviewID)
+    {
+        QMouseEvent *me = static_cast<QMouseEvent *>(event);
+        QStandardItem *item = mItemModel->itemFromIndex(mTreeView->indexAt(me->position().toPoint()));
+
+        if (!item || item->data().toInt() != mPreviewID)
+            hidePreview();
+    }
+
+    return QObject::eventFilter(watched, event);
+}
+
+QStandardItem *TPageTree::findPageItem(QStandardItem *parent, int pageID)
+{
+    DECL_TRACER("TPageTree::findPageItem(QStandardItem *parent, int pageID)");
+
+    if (!parent)
+        return nullptr;
+
+    for (int i = 0; i < parent->rowCount(); ++i)
+    {
+        QStandardItem *item = parent->child(i, 0);
+
+        if (!item)
+            continue;
+
+        int id = item->data().toInt();
+
+        if (id < MENU_PAGE && id == pageID)
+            return item;
+
+        if (item->hasChildren())
+        {
+            QStandardItem *found = findPageItem(item, pageID);
+
+            if (found)
+                return found;
+        }
+    }
+
+    return nullptr;
+}
+
+QIcon TPageTree::getThumbnailIcon(int pageID)
+{
+    DECL_TRACER("TPageTree::getThumbnailIcon(int pageID)");
+
+    QImage thumb = TThumbnailCache::Current().getThumbnail(pageID);
+
+    if (thumb.isNull())
+        return QIcon();
+
+    return QIcon(QPixmap::fromImage(thumb.scaled(32, 32, Qt::KeepAspectRatio, Qt::SmoothTransformation)));
+}
+
+void TPageTree::showPreview(int pageID, const QPoint& pos)
+{
+    DECL_TRACER("TPageTree::showPreview(int pageID, const QPoint& pos)");
+
+    QImage thumb = TThumbnailCache::Current().getThumbnail(pageID);
+
+    if (thumb.isNull())
+        return;
+
+    if (!mPreview)
+        mPreview = new QLabel(nullptr, Qt::ToolTip);
+
+    mPreviewID = pageID;
+    mPreview->setPixmap(QPixmap::fromImage(thumb));
+    mPreview->adjustSize();
+    mPreview->move(pos);
+    mPreview->show();
+}
+
+void TPageTree::hidePreview()
+{
+    DECL_TRACER("TPageTree::hidePreview()");
+
+    mPreviewID = 0;
+
+    if (mPreview)
+        mPreview->hide();
+}
@@ -27,8 +27,11 @@
 class QWidget;
 class QTreeView;
 class QStandardItemModel;
+class QStandardItem;
 class QMenu;
 class QModelIndex;
+class QLabel;
+class QIcon;
 class TCustomItem;
 
 class TPageTree : public QObject
@@ -79,6 +82,7 @@ class TPageTree : public QObject
         void setPageType(Page::PAGE_TYPE ptype, int pageID, const QString& group);
         void setFocus(int id);
         void setPopupGroup(const QString& group, int pageID);
+        void setThumbnail(int pageID);
 
     signals:
         void clicked(const WINTYPE_t wt, int num, const QString& name);
@@ -107,8 +111,14 @@ class TPageTree : public QObject
         TPageTree *getPointer() { return this; }
         void makeTree(const QString& job, const QString& panel, const QString& pname, int pageID);
         void removeGroupFromList(const QString& name);
+        bool eventFilter(QObject *watched, QEvent *event) override;
 
     private:
+        QStandardItem *findPageItem(QStandardItem *parent, int pageID);
+        QIcon getThumbnailIcon(int pageID);
+        void showPreview(int pageID, const QPoint& pos);
+        void hidePreview();
+
         QTreeView *mTreeView{nullptr};
         QWidget *mParent{nullptr};
         QStandardItemModel *mItemModel{nullptr};
@@ -119,6 +129,8 @@ class TPageTree : public QObject
         TCustomItem *mApps{nullptr};        // Pointer to tree part containing the apps
         QMenu *mMenuPopup{nullptr};
         bool mHaveModel{false};
+        QLabel *mPreview{nullptr};          // Shows the thumbnail of the page the mouse is over
+        int mPreviewID{0};                  // The ID of the page shown in the preview
 };
 
 #endif // TPAGETREE_H
@@ -0,0 +1,544 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HAVE_SSE2
+#endif
+
+#include "tpixelkernels.h"
+#include "terror.h"
+
+/**
+ * @brief TPixelKernels::chameleonRow
+ * Creates one line of a chameleon image. For every pixel the red/green
+ * channels of the \b red image select the color:
+ *   - alpha == 0       --> the pixel of the mask
+ *   - red < green      --> col2
+ *   - red != 0         --> col1
+ *   - else             --> transparent
+ *
+ * @param red   The line of the chameleon image.
+ * @param mask  The line of the mask image. If this is nullptr, a
+ * transparent mask is assumed.
+ * @param dst   The line to write the result into.
+ * @param count The number of pixels to process.
+ * @param col1  The first chameleon color.
+ * @param col2  The second chameleon color.
+ */
+void TPixelKernels::chameleonRow(const QRgb *red, const QRgb *mask, QRgb *dst, int count, QRgb col1, QRgb col2)
+{
+    int x = 0;
+#ifdef HAVE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi32(-1);
+    const __m128i byteMask = _mm_set1_epi32(0xff);
+    const __m128i c1 = _mm_set1_epi32(static_cast<int>(col1));
+    const __m128i c2 = _mm_set1_epi32(static_cast<int>(col2));
+
+    for (; x + 4 <= count; x += 4)
+    {
+        __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i *>(red + x));
+        __m128i mk = mask ? _mm_loadu_si128(reinterpret_cast<const __m128i *>(mask + x)) : zero;
+        __m128i a = _mm_srli_epi32(px, 24);
+        __m128i r = _mm_and_si128(_mm_srli_epi32(px, 16), byteMask);
+        __m128i g = _mm_and_si128(_mm_srli_epi32(px, 8), byteMask);
+        __m128i aZero = _mm_cmpeq_epi32(a, zero);
+        __m128i useC2 = _mm_cmplt_epi32(r, g);
+        __m128i useC1 = _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi32(r, zero), useC2), ones);
+        __m128i color = _mm_or_si128(_mm_and_si128(useC2, c2), _mm_and_si128(useC1, c1));
+        __m128i out = _mm_or_si128(_mm_and_si128(aZero, mk), _mm_andnot_si128(aZero, color));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), out);
+    }
+#endif
+    for (; x < count; ++x)
+        dst[x] = chameleonPixel(red[x], mask ? mask[x] : 0, col1, col2);
+}
+
+/**
+ * @brief TPixelKernels::chameleon
+ * Creates a chameleon image. The target image \b dst defines the size.
+ * Pixels outside of the image \b red are taken from the mask, pixels
+ * outside of the mask are transparent.
+ *
+ * @param red   The chameleon image. Any format.
+ * @param mask  The mask image. Any format, may be a null image.
+ * @param dst   The target image. It must be initialized.
+ * @param col1  The first chameleon color.
+ * @param col2  The second chameleon color.
+ */
+void TPixelKernels::chameleon(const QImage& red, const QImage& mask, QImage *dst, QRgb col1, QRgb col2)
+{
+    DECL_TRACER("TPixelKernels::chameleon(const QImage& red, const QImage& mask, QImage *dst, QRgb col1, QRgb col2)");
+
+    if (!dst || dst->isNull())
+        return;
+
+    if (dst->format() != QImage::Format_ARGB32)
+        *dst = dst->convertToFormat(QImage::Format_ARGB32);
+
+    QImage imgRed = red.isNull() || red.format() == QImage::Format_ARGB32 ? red : red.convertToFormat(QImage::Format_ARGB32);
+    QImage imgMask = mask.isNull() || mask.format() == QImage::Format_ARGB32 ? mask : mask.convertToFormat(QImage::Format_ARGB32);
+    const int width = dst->width();
+    const int height = dst->height();
+
+    for (int y = 0; y < height; ++y)
+    {
+        QRgb *out = reinterpret_cast<QRgb *>(dst->scanLine(y));
+        const QRgb *lineRed = y < imgRed.height() ? reinterpret_cast<const QRgb *>(imgRed.constScanLine(y)) : nullptr;
+        const QRgb *lineMask = y < imgMask.height() ? reinterpret_cast<const QRgb *>(imgMask.constScanLine(y)) : nullptr;
+        const int rw = lineRed ? std::min(width, imgRed.width()) : 0;
+        const int mw = lineMask ? std::min(width, imgMask.width()) : 0;
+
+        // Part covered by the chameleon image
+        if (mw >= rw)
+            chameleonRow(lineRed, lineMask, out, rw, col1, col2);
+        else
+        {
+            chameleonRow(lineRed, lineMask, out, mw, col1, col2);
+            chameleonRow(lineRed + mw, nullptr, out + mw, rw - mw, col1, col2);
+        }
+
+        // Part outside of the chameleon image: Take the mask
+        if (mw > rw)
+            memcpy(out + rw, lineMask + rw, static_cast<size_t>(mw - rw) * sizeof(QRgb));
+
+        const int filled = std::max(rw, mw);
+
+        if (filled < width)
+            memset(out + filled, 0, static_cast<size_t>(width - filled) * sizeof(QRgb));
+    }
+}
+
+/**
+ * @brief TPixelKernels::colorizeRow
+ * Colors all visible pixels of a line with \b color. The alpha value of
+ * every pixel is kept, the alpha value of the color is ignored. Invisible
+ * pixels become transparent.
+ *
+ * @param line  The line to colorize.
+ * @param count The number of pixels to process.
+ * @param color The new color.
+ */
+void TPixelKernels::colorizeRow(QRgb *line, int count, QRgb color)
+{
+    const QRgb rgb = color & 0x00ffffff;
+    int x = 0;
+#ifdef HAVE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xff000000));
+    const __m128i col = _mm_set1_epi32(static_cast<int>(rgb));
+
+    for (; x + 4 <= count; x += 4)
+    {
+        __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i *>(line + x));
+        __m128i a = _mm_and_si128(px, alphaMask);
+        __m128i aZero = _mm_cmpeq_epi32(a, zero);
+        __m128i out = _mm_andnot_si128(aZero, _mm_or_si128(a, col));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(line + x), out);
+    }
+#endif
+    for (; x < count; ++x)
+    {
+        QRgb a = line[x] & 0xff000000;
+        line[x] = a ? (a | rgb) : 0;
+    }
+}
+
+/**
+ * @brief TPixelKernels::underlayRow
+ * Creates a line which has the color \b color where the source line is
+ * invisible and which is transparent everywhere else.
+ *
+ * @param src   The source line.
+ * @param dst   The line to write the result into.
+ * @param count The number of pixels to process.
+ * @param color The color to use for the invisible pixels.
+ */
+void TPixelKernels::underlayRow(const QRgb *src, QRgb *dst, int count, QRgb color)
+{
+    int x = 0;
+#ifdef HAVE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xff000000));
+    const __m128i col = _mm_set1_epi32(static_cast<int>(color));
+
+    for (; x + 4 <= count; x += 4)
+    {
+        __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+        __m128i aZero = _mm_cmpeq_epi32(_mm_and_si128(px, alphaMask), zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), _mm_and_si128(aZero, col));
+    }
+#endif
+    for (; x < count; ++x)
+        dst[x] = (src[x] & 0xff000000) ? 0 : color;
+}
+
+/**
+ * @brief TPixelKernels::firstOpaque
+ * Searches for the first pixel in a line which is not fully transparent.
+ *
+ * @param line  The line to search.
+ * @param count The number of pixels in the line.
+ * @return The index of the pixel found or \b count if all pixels are
+ * transparent.
+ */
+int TPixelKernels::firstOpaque(const QRgb *line, int count)
+{
+    int x = 0;
+#ifdef HAVE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xff000000));
+
+    for (; x + 4 <= count; x += 4)
+    {
+        __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i *>(line + x));
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(px, alphaMask), zero)) != 0xffff)
+            break;
+    }
+#endif
+    for (; x < count; ++x)
+    {
+        if (line[x] & 0xff000000)
+            return x;
+    }
+
+    return count;
+}
+
+/**
+ * @brief TPixelKernels::lastOpaque
+ * Searches for the last pixel in a line which is not fully transparent.
+ *
+ * @param line  The line to search.
+ * @param count The number of pixels in the line.
+ * @return The index of the pixel found or -1 if all pixels are transparent.
+ */
+int TPixelKernels::lastOpaque(const QRgb *line, int count)
+{
+    int x = count;
+#ifdef HAVE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xff000000));
+
+    for (; x >= 4; x -= 4)
+    {
+        __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i *>(line + x - 4));
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(px, alphaMask), zero)) != 0xffff)
+            break;
+    }
+#endif
+    for (--x; x >= 0; --x)
+    {
+        if (line[x] & 0xff000000)
+            return x;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief TPixelKernels::colorize
+ * Colors all visible pixels of an image with \b color. The alpha value of
+ * every pixel is kept. This is how the alpha mask of a border fragment is
+ * turned into the border color.
+ *
+ * @param src   The source image. Any format.
+ * @param color The new color.
+ * @return The colored image in the format QImage::Format_ARGB32.
+ */
+QImage TPixelKernels::colorize(const QImage& src, QRgb color)
+{
+    DECL_TRACER("TPixelKernels::colorize(const QImage& src, QRgb color)");
+
+    QImage img = src.convertToFormat(QImage::Format_ARGB32);
+
+    for (int y = 0; y < img.height(); ++y)
+        colorizeRow(reinterpret_cast<QRgb *>(img.scanLine(y)), img.width(), color);
+
+    return img;
+}
+
+/**
+ * @brief TPixelKernels::underlay
+ * Creates an image with the size of \b src which has the color \b color
+ * where \b src is invisible and which is transparent everywhere else.
+ * This is drawn over a border fragment without an alpha mask.
+ *
+ * @param src   The source image. Any format.
+ * @param color The color for the invisible pixels.
+ * @return The new image in the format QImage::Format_ARGB32.
+ */
+QImage TPixelKernels::underlay(const QImage& src, QRgb color)
+{
+    DECL_TRACER("TPixelKernels::underlay(const QImage& src, QRgb color)");
+
+    QImage img = src.format() == QImage::Format_ARGB32 ? src : src.convertToFormat(QImage::Format_ARGB32);
+    QImage dst(img.size(), QImage::Format_ARGB32);
+
+    for (int y = 0; y < img.height(); ++y)
+        underlayRow(reinterpret_cast<const QRgb *>(img.constScanLine(y)), reinterpret_cast<QRgb *>(dst.scanLine(y)), img.width(), color);
+
+    return dst;
+}
+
+/**
+ * @brief TPixelKernels::eraseMask
+ * Finds all pixels outside of a frame. Every line is scanned from the
+ * left and from the right, every column from the top and from the bottom.
+ * A scan stops at the first visible pixel of the frame or at the clip
+ * region. This way the content inside of the frame remains untouched.
+ * The scans only read the frame, so their order doesn't matter.
+ *
+ * @param frame The frame and only the frame. Any format.
+ * @param clip  The region which must not be erased.
+ * @return An image of the size of \b frame in the format
+ * QImage::Format_ARGB32_Premultiplied. Every pixel to erase is opaque
+ * black, all other pixels are transparent.
+ */
+QImage TPixelKernels::eraseMask(const QImage& frame, const QRect& clip)
+{
+    DECL_TRACER("TPixelKernels::eraseMask(const QImage& frame, const QRect& clip)");
+
+    // The alpha channel is at the same place in both ARGB32 formats.
+    // Therefore we can work on the raw lines.
+    QImage msk = frame.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    const int width = msk.width();
+    const int height = msk.height();
+    QImage img(width, height, QImage::Format_ARGB32_Premultiplied);
+    img.fill(Qt::transparent);
+    const QRect cl = clip.normalized();
+    const qsizetype stride = msk.bytesPerLine() / static_cast<qsizetype>(sizeof(QRgb));
+    const QRgb *mbits = reinterpret_cast<const QRgb *>(msk.constBits());
+    const QRgb erase = 0xff000000;
+
+    for (int y = 0; y < height; ++y)
+    {
+        bool inClip = !cl.isEmpty() && y >= cl.top() && y <= cl.bottom();
+        const QRgb *mline = reinterpret_cast<const QRgb *>(msk.constScanLine(y));
+        QRgb *line = reinterpret_cast<QRgb *>(img.scanLine(y));
+        // from left
+        int end = inClip && cl.right() >= 0 ? qBound(0, cl.left(), width) : width;
+        int first = firstOpaque(mline, end);
+        std::fill(line, line + first, erase);
+        // from right (the first column is not part of it)
+        int start = inClip && cl.left() < width ? qBound(1, cl.right() + 1, width) : 1;
+        int last = lastOpaque(mline + start, width - start);
+        last = last < 0 ? start : start + last + 1;
+
+        if (last < width)
+            std::fill(line + last, line + width, erase);
+    }
+
+    for (int x = 0; x < width; ++x)
+    {
+        bool inClip = !cl.isEmpty() && x >= cl.left() && x <= cl.right();
+        // from top
+        int end = inClip && cl.bottom() >= 0 ? qBound(0, cl.top(), height) : height;
+
+        for (int y = 0; y < end && qAlpha(mbits[y * stride + x]) == 0; ++y)
+            reinterpret_cast<QRgb *>(img.scanLine(y))[x] = erase;
+
+        // from bottom (the first row is not part of it)
+        int start = inClip && cl.top() < height ? qBound(1, cl.bottom() + 1, height) : 1;
+
+        for (int y = height - 1; y >= start && qAlpha(mbits[y * stride + x]) == 0; --y)
+            reinterpret_cast<QRgb *>(img.scanLine(y))[x] = erase;
+    }
+
+    return img;
+}
+
+/**
+ * @brief TPixelKernels::blurColumns
+ * One vertical pass of a box blur. Every pixel becomes the average of the
+ * \b radius pixels above, the pixel itself and the \b radius pixels
+ * below. Pixels outside of the image count as 0. The sums of all columns
+ * are kept in an array and updated line by line. This way the inner loop
+ * runs over a whole line and 8 columns are processed at once with SSE2.
+ *
+ * @param src       The source image. Must not be the same as \b dst.
+ * @param dst       The target image.
+ * @param stride    The number of bytes per line of both images.
+ * @param width     The width of the images in pixels.
+ * @param height    The height of the images in pixels.
+ * @param radius    The radius of the box. Must be between 1 and 127.
+ */
+void TPixelKernels::blurColumns(const uchar *src, uchar *dst, qsizetype stride, int width, int height, int radius)
+{
+    if (radius < 1 || radius > 127 || width <= 0 || height <= 0)
+        return;
+
+    // The sum of a box is at most 255 * 255, so it fits into 16 bits.
+    // The division is done by a multiplication with the rounded up
+    // reciprocal: (sum * mul) >> 16
+    const int div = radius * 2 + 1;
+    const quint16 mul = static_cast<quint16>((65536 + div - 1) / div);
+    std::vector<quint16> acc(static_cast<size_t>(width), 0);
+    quint16 *sum = acc.data();
+
+    for (int y = 0; y < std::min(radius, height); ++y)
+    {
+        const uchar *line = src + y * stride;
+
+        for (int x = 0; x < width; ++x)
+            sum[x] += line[x];
+    }
+
+    for (int y = 0; y < height; ++y)
+    {
+        const uchar *add = y + radius < height ? src + (y + radius) * stride : nullptr;
+        const uchar *sub = y - radius - 1 >= 0 ? src + (y - radius - 1) * stride : nullptr;
+        uchar *out = dst + y * stride;
+        int x = 0;
+#ifdef HAVE_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i m = _mm_set1_epi16(static_cast<short>(mul));
+
+        for (; x + 8 <= width; x += 8)
+        {
+            __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sum + x));
+
+            if (add)
+                s = _mm_add_epi16(s, _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(add + x)), zero));
+
+            if (sub)
+                s = _mm_sub_epi16(s, _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(sub + x)), zero));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(sum + x), s);
+            __m128i avg = _mm_mulhi_epu16(s, m);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(out + x), _mm_packus_epi16(avg, zero));
+        }
+#endif
+        for (; x < width; ++x)
+        {
+            if (add)
+                sum[x] += add[x];
+
+            if (sub)
+                sum[x] -= sub[x];
+
+            out[x] = static_cast<uchar>((static_cast<quint32>(sum[x]) * mul) >> 16);
+        }
+    }
+}
+
+/**
+ * @brief TPixelKernels::blurRows
+ * One horizontal pass of a box blur. This is the counterpart of
+ * blurColumns() and produces the same values. It works in place with a
+ * running sum over every line.
+ *
+ * @param bits      The image.
+ * @param stride    The number of bytes per line.
+ * @param width     The width of the image in pixels.
+ * @param height    The height of the image in pixels.
+ * @param radius    The radius of the box. Must be between 1 and 127.
+ */
+void TPixelKernels::blurRows(uchar *bits, qsizetype stride, int width, int height, int radius)
+{
+    if (radius < 1 || radius > 127 || width <= 0 || height <= 0)
+        return;
+
+    const int div = radius * 2 + 1;
+    const quint32 mul = static_cast<quint32>((65536 + div - 1) / div);
+    std::vector<uchar> copy(static_cast<size_t>(width));
+
+    for (int y = 0; y < height; ++y)
+    {
+        uchar *line = bits + y * stride;
+        memcpy(copy.data(), line, static_cast<size_t>(width));
+        quint32 sum = 0;
+
+        for (int x = 0; x < std::min(radius, width); ++x)
+            sum += copy[x];
+
+        for (int x = 0; x < width; ++x)
+        {
+            if (x + radius < width)
+                sum += copy[x + radius];
+
+            if (x - radius - 1 >= 0)
+                sum -= copy[x - radius - 1];
+
+            line[x] = static_cast<uchar>((sum * mul) >> 16);
+        }
+    }
+}
+
+/**
+ * @brief TPixelKernels::blurAlpha
+ * Blurs an image with several passes of a box blur in both directions.
+ * Three passes come very close to a gaussian blur.
+ *
+ * @param alpha     The image to blur. It is converted to the format
+ * QImage::Format_Alpha8 if necessary.
+ * @param radius    The radius of the box of one pass.
+ * @param passes    The number of passes.
+ */
+void TPixelKernels::blurAlpha(QImage *alpha, int radius, int passes)
+{
+    DECL_TRACER("TPixelKernels::blurAlpha(QImage *alpha, int radius, int passes)");
+
+    if (!alpha || alpha->isNull() || radius < 1)
+        return;
+
+    if (alpha->format() != QImage::Format_Alpha8)
+        *alpha = alpha->convertToFormat(QImage::Format_Alpha8);
+
+    radius = std::min(radius, 127);
+    const int width = alpha->width();
+    const int height = alpha->height();
+    const qsizetype stride = alpha->bytesPerLine();
+    QImage tmp(width, height, QImage::Format_Alpha8);
+
+    if (tmp.bytesPerLine() != stride)
+        return;
+
+    for (int i = 0; i < passes; ++i)
+    {
+        memcpy(tmp.bits(), alpha->constBits(), static_cast<size_t>(alpha->sizeInBytes()));
+        blurColumns(tmp.constBits(), alpha->bits(), stride, width, height, radius);
+        blurRows(alpha->bits(), stride, width, height, radius);
+    }
+}
+
+/**
+ * @brief TPixelKernels::boxRadius
+ * Converts the blur radius of a QGraphicsDropShadowEffect into the radius
+ * of the box of blurAlpha() with 3 passes. Qt blurs with an exponential
+ * filter which is cut off at the blur radius, so most of its weight is
+ * close to the center. The factor 1/5 was found by comparing both blurs
+ * (see tests/tst_textshadow.cpp) and is the one with the smallest
+ * difference for all radii used by the text effects.
+ *
+ * @param blurRadius    The blur radius of QGraphicsDropShadowEffect.
+ * @return The radius of the box or 0 if there is nothing to blur.
+ */
+int TPixelKernels::boxRadius(qreal blurRadius)
+{
+    if (blurRadius <= 0.0)
+        return 0;
+
+    return std::max(1, qRound(blurRadius / 5.0));
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TPIXELKERNELS_H
+#define TPIXELKERNELS_H
+
+#include <QImage>
+#include <QRgb>
+#include <QRect>
+
+/**
+ * @brief The TPixelKernels class
+ * Contains kernels working on whole scanlines of images in the format
+ * QImage::Format_ARGB32 (not premultiplied). They replace the slow
+ * per pixel access with QImage::pixelColor() and QImage::setPixelColor().
+ *
+ * On CPUs with SSE2 (every x86_64 CPU) 4 pixels are processed at once.
+ * On all other CPUs a scalar version is used. Both versions produce
+ * exactly the same result.
+ *
+ * The blur kernels work on images in the format QImage::Format_Alpha8.
+ */
+class TPixelKernels
+{
+    public:
+        static void chameleonRow(const QRgb *red, const QRgb *mask, QRgb *dst, int count, QRgb col1, QRgb col2);
+        static void chameleon(const QImage& red, const QImage& mask, QImage *dst, QRgb col1, QRgb col2);
+        static void colorizeRow(QRgb *line, int count, QRgb color);
+        static void underlayRow(const QRgb *src, QRgb *dst, int count, QRgb color);
+        static int firstOpaque(const QRgb *line, int count);
+        static int lastOpaque(const QRgb *line, int count);
+        static QImage colorize(const QImage& src, QRgb color);
+        static QImage underlay(const QImage& src, QRgb color);
+        static QImage eraseMask(const QImage& frame, const QRect& clip);
+        static void blurColumns(const uchar *src, uchar *dst, qsizetype stride, int width, int height, int radius);
+        static void blurRows(uchar *bits, qsizetype stride, int width, int height, int radius);
+        static void blurAlpha(QImage *alpha, int radius, int passes=3);
+        static int boxRadius(qreal blurRadius);
+
+        static inline QRgb chameleonPixel(QRgb red, QRgb mask, QRgb col1, QRgb col2)
+        {
+            if (qAlpha(red) == 0)
+                return mask;
+
+            int r = qRed(red);
+            int g = qGreen(red);
+
+            if (r < g)          // This includes r == 0 and g > 0
+                return col2;
+
+            if (r)
+                return col1;
+
+            return 0;           // Transparent
+        }
+};
+
+#endif // TPIXELKERNELS_H
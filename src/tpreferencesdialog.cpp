@@ -26,6 +26,7 @@
 #include "ui_tpreferencesdialog.h"
 
 #include "tconfig.h"
+#include "timagecache.h"
 #include "terror.h"
 #include "tmisc.h"
 
@@ -65,6 +66,8 @@ void TPreferencesDialog::init(INIT_t i)
         mUsePostfix = TConfig::Current().getUsePostfix();
         mRetainSelectedTool = TConfig::Current().getRetainSelectedTool();
         mImageCacheSize = TConfig::Current().getImageCacheSize();
+        mBinaryPages = TConfig::Current().getBinaryPages();
+        mPrivateFonts = TConfig::Current().getPrivateFonts();
 
         ui->checkBoxSystemGeneratedName->setChecked(mSystemGeneratedName);
         ui->checkBoxReloadLastWorkspace->setChecked(mReloadLastWorkspace);
@@ -75,6 +78,8 @@ void TPreferencesDialog::init(INIT_t i)
         ui->checkBoxPostfix->setChecked(mUsePostfix);
         ui->checkBoxRetainSelectedTool->setChecked(mRetainSelectedTool);
         ui->spinBoxChacheSize->setValue(mImageCacheSize);
+        ui->checkBoxBinaryPages->setChecked(mBinaryPages);
+        ui->checkBoxPrivateFonts->setChecked(mPrivateFonts);
     }
 
     if (i == INIT_ALL || i == INIT_APPEARANCE)
@@ -408,6 +413,26 @@ void TPreferencesDialog::on_spinBoxChacheSize_valueChanged(int arg1)
     mImageCacheSize = arg1;
 }
 
+void TPreferencesDialog::on_checkBoxBinaryPages_checkStateChanged(const Qt::CheckState &arg1)
+{
+    DECL_TRACER("TPreferencesDialog::on_checkBoxBinaryPages_checkStateChanged(const Qt::CheckState &arg1)");
+
+    if (!mInitialized)
+        return;
+
+    mBinaryPages = arg1 == Qt::Checked ? true : false;
+}
+
+void TPreferencesDialog::on_checkBoxPrivateFonts_checkStateChanged(const Qt::CheckState &arg1)
+{
+    DECL_TRACER("TPreferencesDialog::on_checkBoxPrivateFonts_checkStateChanged(const Qt::CheckState &arg1)");
+
+    if (!mInitialized)
+        return;
+
+    mPrivateFonts = arg1 == Qt::Checked ? true : false;
+}
+
 void TPreferencesDialog::on_pushButtonReset_clicked()
 {
     DECL_TRACER("TPreferencesDialog::on_pushButtonReset_clicked()");
@@ -999,6 +1024,9 @@ void TPreferencesDialog::save()
     TConfig::Current().setUsePostfix(mUsePostfix);
     TConfig::Current().setRetainSelectedTool(mRetainSelectedTool);
     TConfig::Current().setImageCacheSize(mImageCacheSize);
+    TImageCache::Current().setBudget(mImageCacheSize);
+    TConfig::Current().setBinaryPages(mBinaryPages);
+    TConfig::Current().setPrivateFonts(mPrivateFonts);
 
     TConfig::Current().setInitialZoom(mInitialZoom);
     TConfig::Current().setVisibleSize(mVisibleSize);
@@ -47,6 +47,8 @@ class TPreferencesDialog : public QDialog
         void on_checkBoxPostfix_checkStateChanged(const Qt::CheckState &arg1);
         void on_checkBoxRetainSelectedTool_checkStateChanged(const Qt::CheckState &arg1);
         void on_spinBoxChacheSize_valueChanged(int arg1);
+        void on_checkBoxBinaryPages_checkStateChanged(const Qt::CheckState &arg1);
+        void on_checkBoxPrivateFonts_checkStateChanged(const Qt::CheckState &arg1);
         void on_pushButtonReset_clicked();
 
         void on_comboBoxInitialZoom_currentIndexChanged(int index);
@@ -133,7 +135,9 @@ class TPreferencesDialog : public QDialog
         bool mCreateBackup{true};
         bool mUsePostfix{true};
         bool mRetainSelectedTool{true};
-        qsizetype mImageCacheSize{8};       // Mib
+        qsizetype mImageCacheSize{64};      // Mib
+        bool mBinaryPages{false};
+        bool mPrivateFonts{true};
         // Preferences: Appearance
         int mInitialZoom{100};              // Percent
         qreal mVisibleSize{0.0};            // Inches
@@ -372,6 +372,7 @@ void TPropertiesGeneral::loadPage(int pageID)
         saveChangedData(mPage, TBL_GENERAL);
 
     mPage = TPageHandler::Current().getPage(pageID);
+    TPageHandler::Current().ensureLoaded(mPage);
     mChanged = false;
     mInitialized = false;
 }
@@ -129,6 +129,7 @@ void TPropertiesProgramming::setProgrammingPage(const QString& name)
     }
 
     Page::PAGE_t *page = TPageHandler::Current().getPage(name);
+    TPageHandler::Current().ensureLoaded(page);
 
     if (!page || page->pageID == mPage->pageID)
         return;
@@ -157,6 +158,7 @@ void TPropertiesProgramming::setProgrammingPage(int id, bool loaded)
     if (!loaded)
     {
         page = TPageHandler::Current().getPage(id);
+        TPageHandler::Current().ensureLoaded(page);
 
         if (!page)
             return;
@@ -192,6 +194,7 @@ void TPropertiesProgramming::setProgrammingPopup(const QString& name)
 
     bool equal = false;
     Page::PAGE_t *page = TPageHandler::Current().getPage(name);
+    TPageHandler::Current().ensureLoaded(page);
 
     if (!page || !mPage)
         return;
@@ -223,6 +226,7 @@ void TPropertiesProgramming::setProgrammingPopup(int id, bool loaded)
     if (!loaded)
     {
         page = TPageHandler::Current().getPage(id);
+        TPageHandler::Current().ensureLoaded(page);
 
         if (!page)
             return;
@@ -294,9 +298,9 @@ void TPropertiesProgramming::setObjectType(ObjHandler::BUTTONTYPE btype, int ind
     mChanged = true;
 }
 
-void TPropertiesProgramming::setObject(ObjHandler::TOBJECT_t& object, int id)
+void TPropertiesProgramming::setObject(const ObjHandler::TOBJECT_t& object, int id)
 {
-    DECL_TRACER("TPropertiesProgramming::setObject(ObjHandler::TOBJECT_t& object, int id)");
+    DECL_TRACER("TPropertiesProgramming::setObject(const ObjHandler::TOBJECT_t& object, int id)");
 
     MSG_DEBUG("Changed: " << (mChanged ? "YES" : "NO") << ", BI: " << object.bi << ", new ID: " << id << ", old ID: " << mActObjectID);
 
@@ -312,7 +316,10 @@ void TPropertiesProgramming::setObject(ObjHandler::TOBJECT_t& object, int id)
         }
         // Check if the new ID is in range. If not, reload page.
         if (id >= mPage->objects.size())
+        {
             mPage = TPageHandler::Current().getPage(mPage->pageID);
+            TPageHandler::Current().ensureLoaded(mPage);
+        }
 
         mActObject = object;
         mActObjectID = id;
@@ -45,7 +45,7 @@ class TPropertiesProgramming : public QObject
         void setProgrammingPage(int id, bool loaded=false);
         void setProgrammingPopup(const QString& name);
         void setProgrammingPopup(int id, bool loaded=false);
-        void setObject(ObjHandler::TOBJECT_t& object, int id);
+        void setObject(const ObjHandler::TOBJECT_t& object, int id);
         void setObjectID(int id);
         void setObjectType(ObjHandler::BUTTONTYPE btype, int index);
         bool isChanged() { return mChanged; }
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+#include <QElapsedTimer>
+
+#include "trendercheck.h"
+#include "tpageexporter.h"
+#include "tpagehandler.h"
+#include "tobjecthandler.h"
+#include "tdrawobject.h"
+#include "terror.h"
+
+using namespace Page;
+
+TRenderCheck::TRenderCheck(const QString& references, const QString& output, int tolerance)
+    : mReferences(references),
+      mOutput(output),
+      mTolerance(tolerance)
+{
+    DECL_TRACER("TRenderCheck::TRenderCheck(const QString& references, const QString& output, int tolerance)");
+}
+
+/**
+ * @brief TRenderCheck::run
+ * Draws all states of all objects of the current project and compares
+ * them with the reference images.
+ *
+ * @param update    TRUE = The drawn images replace the references.
+ * @return TRUE if no image differs from its reference.
+ */
+bool TRenderCheck::run(bool update)
+{
+    DECL_TRACER("TRenderCheck::run(bool update)");
+
+    QDir refs(mReferences);
+    QDir dir(mOutput);
+
+    if (update && !refs.mkpath("."))
+    {
+        MSG_ERROR("Couldn't create the directory " << mReferences.toStdString());
+        return false;
+    }
+
+    if (!dir.mkpath("diff"))
+    {
+        MSG_ERROR("Couldn't create the directory " << dir.filePath("diff").toStdString());
+        return false;
+    }
+
+    QFile report(dir.filePath("report.csv"));
+
+    if (!report.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        MSG_ERROR("Couldn't write " << report.fileName().toStdString());
+        return false;
+    }
+
+    QTextStream out(&report);
+    out << "image,milliseconds,result,pixels\n";
+    mPassed = mFailed = mCreated = 0;
+    double total = 0.0;
+
+    for (int pageID : TPageHandler::Current().getPageNumbers())
+    {
+        PAGE_t *page = TPageHandler::Current().getPage(pageID);
+        TPageHandler::Current().ensureLoaded(page);
+
+        if (!page)
+            continue;
+
+        QString base = TPageExporter::getFileName(*page);
+        base.chop(4);   // ".png"
+
+        for (TObjectHandler *object : page->objects)
+        {
+            int instances = static_cast<int>(object->getObject().sr.size());
+
+            for (int inst = 0; inst < instances; ++inst)
+            {
+                QString name = QString("%1_%2_%3.png").arg(base).arg(object->getObject().bi).arg(inst);
+                // TDrawObject is used directly, because the object keeps
+                // its rendered images and the drawing code must be timed.
+                TDrawObject drawObject(object, nullptr);
+                QElapsedTimer timer;
+                timer.start();
+                drawObject.draw(inst);
+                double ms = static_cast<double>(timer.nsecsElapsed()) / 1000000.0;
+                total += ms;
+
+                if (drawObject.haveError() || drawObject.getPixmap().isNull())
+                {
+                    MSG_ERROR("Couldn't draw " << name.toStdString());
+                    out << name << "," << ms << ",error,0\n";
+                    mFailed++;
+                    continue;
+                }
+
+                QImage image = drawObject.getPixmap().toImage();
+                QString file = refs.filePath(name);
+
+                if (update)
+                {
+                    if (!image.save(file, "PNG"))
+                    {
+                        MSG_ERROR("Couldn't write " << file.toStdString());
+                        mFailed++;
+                        continue;
+                    }
+
+                    out << name << "," << ms << ",created,0\n";
+                    mCreated++;
+                    continue;
+                }
+
+                if (!QFile::exists(file))
+                {
+                    MSG_ERROR("Missing the reference image " << file.toStdString());
+                    out << name << "," << ms << ",missing,0\n";
+                    mFailed++;
+                    continue;
+                }
+
+                QImage diff;
+                qsizetype pixels = compare(image, QImage(file), mTolerance, &diff);
+
+                if (pixels == 0)
+                {
+                    out << name << "," << ms << ",passed,0\n";
+                    mPassed++;
+                    continue;
+                }
+
+                MSG_WARNING("Image " << name.toStdString() << " differs in " << pixels << " pixels.");
+                out << name << "," << ms << ",failed," << pixels << "\n";
+                mFailed++;
+
+                if (!diff.isNull())
+                    diff.save(dir.filePath("diff/" + name), "PNG");
+            }
+        }
+    }
+
+    out << "total," << total << ",,\n";
+    report.close();
+    MSG_INFO("Render check: " << mPassed << " passed, " << mFailed << " failed, " << mCreated << " created in " << total << " ms");
+    return mFailed == 0;
+}
+
+/**
+ * @brief TRenderCheck::compare
+ * Compares an image with its reference pixel by pixel.
+ *
+ * @param image     The drawn image.
+ * @param golden    The reference image.
+ * @param tolerance The maximum difference of any channel of a pixel.
+ * @param diff      Optional: Receives an image showing the differing
+ * pixels in red. If the sizes differ, this is a null image.
+ * @return The number of differing pixels. If the sizes differ, it is the
+ * number of pixels of the larger image.
+ */
+qsizetype TRenderCheck::compare(const QImage& image, const QImage& golden, int tolerance, QImage *diff)
+{
+    DECL_TRACER("TRenderCheck::compare(const QImage& image, const QImage& golden, int tolerance, QImage *diff)");
+
+    if (diff)
+        *diff = QImage();
+
+    if (image.size() != golden.size())
+    {
+        MSG_WARNING("Size " << image.width() << "x" << image.height() << " differs from reference " << golden.width() << "x" << golden.height());
+        return qMax(static_cast<qsizetype>(image.width()) * image.height(), static_cast<qsizetype>(golden.width()) * golden.height());
+    }
+
+    QImage a = image.convertToFormat(QImage::Format_ARGB32);
+    QImage b = golden.convertToFormat(QImage::Format_ARGB32);
+
+    if (diff)
+        *diff = QImage(a.size(), QImage::Format_ARGB32);
+
+    qsizetype count = 0;
+
+    for (int y = 0; y < a.height(); ++y)
+    {
+        const QRgb *la = reinterpret_cast<const QRgb *>(a.constScanLine(y));
+        const QRgb *lb = reinterpret_cast<const QRgb *>(b.constScanLine(y));
+        QRgb *ld = diff ? reinterpret_cast<QRgb *>(diff->scanLine(y)) : nullptr;
+
+        for (int x = 0; x < a.width(); ++x)
+        {
+            int d = qMax(qMax(qAbs(qRed(la[x]) - qRed(lb[x])), qAbs(qGreen(la[x]) - qGreen(lb[x]))),
+                         qMax(qAbs(qBlue(la[x]) - qBlue(lb[x])), qAbs(qAlpha(la[x]) - qAlpha(lb[x]))));
+
+            if (d > tolerance)
+                count++;
+
+            if (ld)
+            {
+                if (d > tolerance)
+                    ld[x] = qRgba(255, 0, 0, 255);
+                else
+                {
+                    int g = qGray(lb[x]);
+                    ld[x] = qRgba(g, g, g, qAlpha(lb[x]) / 4);
+                }
+            }
+        }
+    }
+
+    return count;
+}
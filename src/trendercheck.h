@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TRENDERCHECK_H
+#define TRENDERCHECK_H
+
+#include <QString>
+#include <QImage>
+
+/**
+ * @brief The TRenderCheck class
+ * Checks the drawing code against reference images. Every state of every
+ * object of the current project is drawn offscreen by TDrawObject and
+ * compared with a reference PNG file ("golden" image). A pixel differs if
+ * any of its channels differs by more than the tolerance. For every image
+ * which differs, a diff image is written, showing the differing pixels in
+ * red over a faded copy of the reference.
+ *
+ * Each render is timed as well. The results are written into the file
+ * "report.csv" in the output directory, so changes in speed and in
+ * correctness can be seen together. The diff images are written into the
+ * directory "diff" there. The directory of the reference images is only
+ * written if the references are updated.
+ *
+ * A state without a reference image fails the check. Only if the
+ * references should be updated, the drawn image becomes the new
+ * reference.
+ */
+class TRenderCheck
+{
+    public:
+        TRenderCheck(const QString& references, const QString& output, int tolerance=0);
+
+        bool run(bool update=false);
+        int getFailed() const { return mFailed; }
+
+        static qsizetype compare(const QImage& image, const QImage& golden, int tolerance, QImage *diff=nullptr);
+
+    private:
+        QString mReferences;            // The directory with the reference images
+        QString mOutput;                // The directory for the report and the diff images
+        int mTolerance{0};              // The maximum difference of a channel
+        int mPassed{0};                 // The number of images equal to their reference
+        int mFailed{0};                 // The number of images which differ, have no reference or couldn't be drawn
+        int mCreated{0};                // The number of references written
+};
+
+#endif // TRENDERCHECK_H
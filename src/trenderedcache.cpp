@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include "trenderedcache.h"
+#include "tconfig.h"
+#include "terror.h"
+
+TRenderedCache::TRenderedCache()
+    : TCostCache("Rendered cache", "images", TConfig::Current().getRenderedCacheSize())
+{
+    DECL_TRACER("TRenderedCache::TRenderedCache()");
+}
+
+TRenderedCache& TRenderedCache::Current()
+{
+//    DECL_TRACER("TRenderedCache::Current()");
+
+    // The images are pixmaps, which must not be destroyed after the
+    // application. Therefore the cache is never deleted.
+    static TRenderedCache *cache = new TRenderedCache;
+    return *cache;
+}
+
+void TRenderedCache::insert(const QString& key, const QPixmap& pm)
+{
+    DECL_TRACER("TRenderedCache::insert(const QString& key, const QPixmap& pm)");
+
+    if (pm.isNull())
+        return;
+
+    TCostCache::insert(key, pm, static_cast<qint64>(pm.width()) * pm.height() * pm.depth() / 8);
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TRENDEREDCACHE_H
+#define TRENDEREDCACHE_H
+
+#include <QPixmap>
+#include <QString>
+
+#include "tcostcache.h"
+
+/**
+ * @brief The TRenderedCache class
+ * Keeps the finished images of the object instances. The key is made by
+ * TObjectHandler and contains the version of the object and a stamp of
+ * the image files it uses. A changed object or image file therefore
+ * results in a new key and the outdated image is removed as soon as the
+ * budget is exhausted.
+ *
+ * The images are stored as QPixmap. Therefore the cache must only be used
+ * from the GUI thread.
+ */
+class TRenderedCache : public TCostCache<QPixmap>
+{
+    public:
+        static TRenderedCache& Current();
+
+        void insert(const QString& key, const QPixmap& pm);
+
+    private:
+        TRenderedCache();
+};
+
+#endif // TRENDEREDCACHE_H
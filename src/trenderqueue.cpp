@@ -0,0 +1,391 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <QThreadPool>
+#include <QRunnable>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QPainter>
+
+#include "trenderqueue.h"
+#include "timagecache.h"
+#include "tconfmain.h"
+#include "terror.h"
+
+using namespace ObjHandler;
+
+#define TIME_SLICE      15      // Milliseconds the GUI thread draws in one go
+
+TRenderQueue *TRenderQueue::mCurrent{nullptr};
+
+TRenderQueue::TRenderQueue()
+{
+    DECL_TRACER("TRenderQueue::TRenderQueue()");
+}
+
+TRenderQueue& TRenderQueue::Current()
+{
+//    DECL_TRACER("TRenderQueue::Current()");
+
+    if (!mCurrent)
+        mCurrent = new TRenderQueue;
+
+    return *mCurrent;
+}
+
+/**
+ * @brief TRenderQueue::enqueue
+ * Adds an object to the queue. The images of the object are loaded on a
+ * worker thread. If the object is already in the queue, its job is
+ * replaced, because the object or the instance may have changed. The
+ * images of the new job are loaded and pinned again.
+ *
+ * @param pageID    The ID of the page the object belongs to.
+ * @param object    The object to draw.
+ * @param instance  The instance to draw.
+ */
+void TRenderQueue::enqueue(int pageID, const TOBJECT_t& object, int instance)
+{
+    DECL_TRACER("TRenderQueue::enqueue(int pageID, const TOBJECT_t& object, int instance)");
+
+    qsizetype idx = findJob(pageID, object.bi);
+
+    // If the old job is still loading its images, onPrefetched() doesn't
+    // find it any more and releases them.
+    if (idx >= 0)
+        releaseJob(mJobs.takeAt(idx));
+
+    RENDER_JOB_t job;
+    job.id = mNextId++;
+    job.pageID = pageID;
+    job.bi = object.bi;
+    job.instance = instance;
+
+    job.files = getImageFiles(object, instance, &job.sizes, &job.modes);
+
+    if (job.files.isEmpty())
+        job.ready = true;
+
+    mJobs.append(job);
+
+    if (job.ready)
+    {
+        scheduleProcessing();
+        return;
+    }
+
+    quint64 id = job.id;
+    QStringList files = job.files;
+    QList<QSize> sizes = job.sizes;
+    QList<int> modes = job.modes;
+
+    // The images are pinned in the cache until the object is drawn.
+    // Otherwise on a large page they may be removed from the cache before
+    // the GUI thread draws the object and would be decoded again.
+    // Only the images which were really pinned are released later.
+    QThreadPool::globalInstance()->start(QRunnable::create([this, id, files, sizes, modes]()
+    {
+        QStringList pinnedFiles;
+        QList<QSize> pinnedSizes;
+        QList<int> pinnedModes;
+
+        for (qsizetype i = 0; i < files.size(); ++i)
+        {
+            if (!TImageCache::Current().pin(files[i], sizes[i], static_cast<Qt::AspectRatioMode>(modes[i])))
+                continue;
+
+            pinnedFiles.append(files[i]);
+            pinnedSizes.append(sizes[i]);
+            pinnedModes.append(modes[i]);
+        }
+
+        QMetaObject::invokeMethod(this, [this, id, pinnedFiles, pinnedSizes, pinnedModes]() { onPrefetched(id, pinnedFiles, pinnedSizes, pinnedModes); }, Qt::QueuedConnection);
+    }));
+}
+
+void TRenderQueue::remove(int pageID, int bi)
+{
+    DECL_TRACER("TRenderQueue::remove(int pageID, int bi)");
+
+    qsizetype idx = findJob(pageID, bi);
+
+    if (idx >= 0)
+        releaseJob(mJobs.takeAt(idx));
+}
+
+void TRenderQueue::removePage(int pageID)
+{
+    DECL_TRACER("TRenderQueue::removePage(int pageID)");
+
+    mJobs.removeIf([this, pageID](const RENDER_JOB_t& job)
+    {
+        if (job.pageID != pageID)
+            return false;
+
+        releaseJob(job);
+        return true;
+    });
+}
+
+void TRenderQueue::removeAll()
+{
+    DECL_TRACER("TRenderQueue::removeAll()");
+
+    for (const RENDER_JOB_t& job : mJobs)
+        releaseJob(job);
+
+    mJobs.clear();
+}
+
+/**
+ * @brief TRenderQueue::flush
+ * Draws all objects in the queue immediately, no matter whether their
+ * images were already loaded or not. This is used whenever the final
+ * state of the objects is needed at once.
+ */
+void TRenderQueue::flush()
+{
+    DECL_TRACER("TRenderQueue::flush()");
+
+    while (!mJobs.isEmpty())
+    {
+        RENDER_JOB_t job = mJobs.takeFirst();
+
+        if (_drawObject)
+            _drawObject(job.pageID, job.bi, job.instance);
+
+        releaseJob(job);
+    }
+}
+
+bool TRenderQueue::isPending(int pageID, int bi)
+{
+    DECL_TRACER("TRenderQueue::isPending(int pageID, int bi)");
+
+    return findJob(pageID, bi) >= 0;
+}
+
+/**
+ * @brief TRenderQueue::getPlaceholder
+ * Creates the pixmap shown in an object until it is drawn.
+ *
+ * @param size  The size of the object.
+ * @return The placeholder.
+ */
+QPixmap TRenderQueue::getPlaceholder(const QSize& size)
+{
+    DECL_TRACER("TRenderQueue::getPlaceholder(const QSize& size)");
+
+    if (size.width() <= 0 || size.height() <= 0)
+        return QPixmap();
+
+    QPixmap pm(size);
+    pm.fill(QColor(128, 128, 128, 64));
+    QPainter p(&pm);
+    p.setPen(QPen(QColor(128, 128, 128, 160), 1, Qt::DotLine));
+    p.drawRect(0, 0, size.width() - 1, size.height() - 1);
+    p.end();
+    return pm;
+}
+
+void TRenderQueue::onPrefetched(quint64 id, const QStringList& files, const QList<QSize>& sizes, const QList<int>& modes)
+{
+    DECL_TRACER("TRenderQueue::onPrefetched(quint64 id, const QStringList& files, const QList<QSize>& sizes, const QList<int>& modes)");
+
+    for (RENDER_JOB_t& job : mJobs)
+    {
+        if (job.id == id)
+        {
+            job.ready = true;
+            job.pinned = true;
+            job.files = files;
+            job.sizes = sizes;
+            job.modes = modes;
+            scheduleProcessing();
+            return;
+        }
+    }
+
+    // The job was removed or drawn in the meantime. Nobody else will
+    // release the images.
+    for (qsizetype i = 0; i < files.size(); ++i)
+        TImageCache::Current().unpin(files[i], sizes[i], static_cast<Qt::AspectRatioMode>(modes[i]));
+}
+
+/**
+ * @brief TRenderQueue::releaseJob
+ * Releases the images pinned for a job. This must be called for every job
+ * leaving the queue. If the images are still loaded, onPrefetched()
+ * releases them.
+ *
+ * @param job   The job.
+ */
+void TRenderQueue::releaseJob(const RENDER_JOB_t& job)
+{
+    DECL_TRACER("TRenderQueue::releaseJob(const RENDER_JOB_t& job)");
+
+    if (!job.pinned)
+        return;
+
+    for (qsizetype i = 0; i < job.files.size(); ++i)
+        TImageCache::Current().unpin(job.files[i], job.sizes[i], static_cast<Qt::AspectRatioMode>(job.modes[i]));
+}
+
+/**
+ * @brief TRenderQueue::processJobs
+ * Draws the objects whose images are loaded. After the time slice is
+ * used up, the method returns to the event loop and continues later.
+ */
+void TRenderQueue::processJobs()
+{
+    DECL_TRACER("TRenderQueue::processJobs()");
+
+    mScheduled = false;
+    QElapsedTimer timer;
+    timer.start();
+
+    while (timer.elapsed() < TIME_SLICE)
+    {
+        qsizetype idx = -1;
+
+        for (qsizetype i = 0; i < mJobs.size(); ++i)
+        {
+            if (mJobs[i].ready)
+            {
+                idx = i;
+                break;
+            }
+        }
+
+        if (idx < 0)
+            return;
+
+        // The job is removed before it is drawn, because the callback may
+        // change the queue.
+        RENDER_JOB_t job = mJobs.takeAt(idx);
+
+        if (_drawObject)
+            _drawObject(job.pageID, job.bi, job.instance);
+
+        releaseJob(job);
+    }
+
+    for (const RENDER_JOB_t& job : mJobs)
+    {
+        if (job.ready)
+        {
+            scheduleProcessing();
+            break;
+        }
+    }
+}
+
+qsizetype TRenderQueue::findJob(int pageID, int bi)
+{
+    DECL_TRACER("TRenderQueue::findJob(int pageID, int bi)");
+
+    for (qsizetype i = 0; i < mJobs.size(); ++i)
+    {
+        if (mJobs[i].pageID == pageID && mJobs[i].bi == bi)
+            return i;
+    }
+
+    return -1;
+}
+
+void TRenderQueue::scheduleProcessing()
+{
+    DECL_TRACER("TRenderQueue::scheduleProcessing()");
+
+    if (mScheduled)
+        return;
+
+    mScheduled = true;
+    QTimer::singleShot(0, this, &TRenderQueue::processJobs);
+}
+
+/**
+ * @brief TRenderQueue::getImageFiles
+ * Collects the image files TDrawImage will load to draw an instance of an
+ * object. The size and scale mode are the same as TDrawImage uses, so the
+ * images in the cache are exactly the ones needed later.
+ *
+ * @param object    The object.
+ * @param instance  The instance to draw.
+ * @param sizes     Receives the size for each file.
+ * @param modes     Receives the scale mode for each file.
+ * @return The list of files with their full path.
+ */
+QStringList TRenderQueue::getImageFiles(const TOBJECT_t& object, int instance, QList<QSize> *sizes, QList<int> *modes)
+{
+    DECL_TRACER("TRenderQueue::getImageFiles(const TOBJECT_t& object, int instance, QList<QSize> *sizes, QList<int> *modes)");
+
+    QStringList files;
+
+    if (instance < 0 || instance >= object.sr.size())
+        return files;
+
+    QString path = TConfMain::Current().getPathTemporary() + "/images/";
+
+    auto add = [&files, sizes, modes, &path](const QString& file, const QSize& size, Qt::AspectRatioMode mode)
+    {
+        if (file.isEmpty())
+            return;
+
+        files.append(path + file);
+        sizes->append(size);
+        modes->append(mode);
+    };
+
+    if (object.type == BARGRAPH)
+    {
+        if (object.sr.size() != 2)
+            return files;
+
+        add(object.sr[0].mi, QSize(), Qt::IgnoreAspectRatio);
+
+        if (!object.sr[0].bitmaps.empty())
+            add(object.sr[0].bitmaps[0].fileName, QSize(), Qt::IgnoreAspectRatio);
+
+        if (!object.sr[1].bitmaps.empty())
+            add(object.sr[1].bitmaps[0].fileName, QSize(), Qt::IgnoreAspectRatio);
+
+        return files;
+    }
+
+    const SR_T& sr = object.sr[instance];
+
+    if (sr.bs.isEmpty() && !sr.mi.isEmpty())
+    {
+        add(sr.mi, QSize(), Qt::IgnoreAspectRatio);
+
+        if (!sr.bitmaps.empty())
+            add(sr.bitmaps[0].fileName, QSize(), Qt::IgnoreAspectRatio);
+    }
+
+    for (const BITMAPS_t& bm : sr.bitmaps)
+    {
+        if (bm.justification == ORI_SCALE_FIT)
+            add(bm.fileName, QSize(object.wt, object.ht), Qt::IgnoreAspectRatio);
+        else if (bm.justification == ORI_SCALE_ASPECT)
+            add(bm.fileName, QSize(object.wt, object.ht), Qt::KeepAspectRatio);
+        else
+            add(bm.fileName, QSize(), Qt::IgnoreAspectRatio);
+    }
+
+    return files;
+}
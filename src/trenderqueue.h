@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TRENDERQUEUE_H
+#define TRENDERQUEUE_H
+
+#include <QObject>
+#include <QList>
+#include <QPixmap>
+#include <QSize>
+#include <QStringList>
+
+#include <functional>
+
+#include "tobjecthandler.h"
+
+/**
+ * @brief The TRenderQueue class
+ * Draws the objects of a page without blocking the GUI.
+ *
+ * Drawing an object consists of two parts: Loading and decoding the
+ * images from disk, which is the expensive part, and composing the
+ * button. The first part is done on worker threads of the global thread
+ * pool. The images are decoded into the TImageCache, which is thread
+ * safe. As soon as all images of an object are in the cache, the object
+ * is drawn on the GUI thread by the same code as the synchronous path.
+ * Therefore the result is identical. The GUI thread draws only as many
+ * objects as fit into a short time slice and then returns to the event
+ * loop, so the window keeps responding.
+ *
+ * Until an object is drawn its widget shows a placeholder.
+ */
+class TRenderQueue : public QObject
+{
+    Q_OBJECT
+
+    public:
+        static TRenderQueue& Current();
+
+        void enqueue(int pageID, const ObjHandler::TOBJECT_t& object, int instance=0);
+        void remove(int pageID, int bi);
+        void removePage(int pageID);
+        void removeAll();
+        void flush();
+        bool isPending(int pageID, int bi);
+        qsizetype size() const { return mJobs.size(); }
+
+        static QPixmap getPlaceholder(const QSize& size);
+
+        // Callback to draw an object on the GUI thread
+        void regDrawObject(std::function<void (int pageID, int bi, int instance)> func) { _drawObject = func; }
+
+    private slots:
+        void onPrefetched(quint64 id, const QStringList& files, const QList<QSize>& sizes, const QList<int>& modes);
+        void processJobs();
+
+    private:
+        TRenderQueue();
+
+        typedef struct RENDER_JOB_t
+        {
+            quint64 id{0};              // Unique ID of the job
+            int pageID{0};              // The page the object belongs to
+            int bi{0};                  // The button index of the object
+            int instance{0};            // The instance to draw
+            bool ready{false};          // TRUE = All images are in the cache
+            bool pinned{false};         // TRUE = The images are pinned in the cache
+            QStringList files;          // The images of the object, once loaded the pinned ones
+            QList<QSize> sizes;         // The size of each image
+            QList<int> modes;           // The scale mode of each image
+        }RENDER_JOB_t;
+
+        qsizetype findJob(int pageID, int bi);
+        void releaseJob(const RENDER_JOB_t& job);
+        void scheduleProcessing();
+        static QStringList getImageFiles(const ObjHandler::TOBJECT_t& object, int instance, QList<QSize> *sizes, QList<int> *modes);
+
+        std::function<void (int pageID, int bi, int instance)> _drawObject{nullptr};
+
+        static TRenderQueue *mCurrent;
+        QList<RENDER_JOB_t> mJobs;      // The jobs in the order they were added
+        quint64 mNextId{1};             // The ID of the next job
+        bool mScheduled{false};         // TRUE = processJobs() is already queued
+};
+
+#endif // TRENDERQUEUE_H
@@ -17,6 +17,8 @@
  */
 #include <QPainter>
 #include <QMouseEvent>
+#include <QResizeEvent>
+#include <QMoveEvent>
 #include <QEvent>
 #include <QLabel>
 
@@ -229,6 +231,19 @@ void TResizableWidget::setPixmap(const QPixmap& bm)
     if (!mContent)
         return;
 
+    // In retained mode the canvas paints the image. The widget is only
+    // used for the selection frame and the grips.
+    TCanvasWidget *canvas = qobject_cast<TCanvasWidget*>(parentWidget());
+
+    if (canvas && canvas->retained())
+    {
+        if (mBackground)
+            mBackground->hide();
+
+        canvas->setObjectPixmap(this, bm);
+        return;
+    }
+
     if (!mBackground)
     {
         mBackground = new QLabel(mContent);
@@ -267,8 +282,11 @@ void TResizableWidget::paintEvent(QPaintEvent*)
     p.drawRect(frameRect);
 }
 
-void TResizableWidget::resizeEvent(QResizeEvent*)
+void TResizableWidget::resizeEvent(QResizeEvent* e)
 {
+    if (TCanvasWidget *canvas = qobject_cast<TCanvasWidget*>(parentWidget()))
+        canvas->objectGeometryChanged(this, QRect(pos(), e->oldSize()), geometry());
+
     if (mContent)
     {
         const int m = 0;
@@ -285,6 +303,14 @@ void TResizableWidget::resizeEvent(QResizeEvent*)
     layoutGrips();
 }
 
+void TResizableWidget::moveEvent(QMoveEvent* e)
+{
+    if (TCanvasWidget *canvas = qobject_cast<TCanvasWidget*>(parentWidget()))
+        canvas->objectGeometryChanged(this, QRect(e->oldPos(), size()), geometry());
+
+    QWidget::moveEvent(e);
+}
+
 void TResizableWidget::layoutGrips()
 {
     DECL_TRACER("TResizableWidget::layoutGrips()");
@@ -60,6 +60,7 @@ class TResizableWidget : public QWidget
     protected:
         void paintEvent(QPaintEvent*) override;
         void resizeEvent(QResizeEvent*) override;
+        void moveEvent(QMoveEvent*) override;
 
         // Drag-to-move support (delegates group move to CanvasWidget)
         void mousePressEvent(QMouseEvent*) override;
@@ -25,6 +25,7 @@
 #include <QMessageBox>
 #include <QProgressDialog>
 #include <QClipboard>
+#include <QSet>
 
 #include "tresourcedialog.h"
 #include "ui_tresourcedialog.h"
@@ -34,6 +35,8 @@
 #include "tdynamicimagedialog.h"
 #include "tdynamicdatadialog.h"
 #include "tdatamapdialog.h"
+#include "timagecache.h"
+#include "timagelistmodel.h"
 #include "terror.h"
 #include "tmisc.h"
 
@@ -67,29 +70,16 @@ TResourceDialog::TResourceDialog(QWidget *parent)
     ui->listViewImages->setSpacing(10);
     ui->listViewImages->setDragEnabled(false);
 
-    mImages = TMaps::Current().getAllImageFiles();
-    QStandardItemModel *model = new QStandardItemModel(this);
-    QStringList::Iterator iter;
-    int row = 0;
-
-    for (iter = mImages.begin(); iter != mImages.end(); ++iter)
-    {
-        QString file = mPathTemporary + "/images/" + *iter;
-        MSG_DEBUG("Loading image: " << file.toStdString());
-        QStandardItem *item = new QStandardItem(*iter);
-        QSize oriSize;
-        item->setData(sizeImage(iconSize, file, &oriSize), Qt::DecorationRole);
-        item->setSizeHint(gridSize);
-        item->setTextAlignment(Qt::AlignHCenter | Qt::AlignBottom);
-        item->setToolTip(QString("%1 (%2x%3)").arg(*iter).arg(oriSize.width()).arg(oriSize.height()));
-        model->appendRow(item);
-        row++;
-    }
+    ui->listViewImages->setUniformItemSizes(true);
 
-    model->sort(0);
-    ui->listViewImages->setModel(model);
+    // The model reports all images at once. The icons are loaded in the
+    // background only for the visible items.
+    mImages = TMaps::Current().getAllImageFiles();
+    mImageModel = new TImageListModel(mPathTemporary + "/images", iconSize, gridSize, this);
+    mImageModel->setImages(mImages);
+    ui->listViewImages->setModel(mImageModel);
 
-    setLabel(LABEL_LISTVIEW, row, "");
+    setLabel(LABEL_LISTVIEW, mImageModel->rowCount(), "");
     // Dynamic resources
     QStandardItemModel *dynModel = new QStandardItemModel(this);
     dynModel->setColumnCount(3);
@@ -220,14 +210,9 @@ void TResourceDialog::on_pushButtonPaste_clicked()
         QString fname(QString("Unknown_%1.png").arg(getClipboardImageNumber()));
         mClipboardPixmapNumber++;
         mClipboardPixmap.save(mPathTemporary + "/images/" + fname);
-        QStandardItemModel *model = static_cast<QStandardItemModel *>(ui->listViewImages->model());
-        QStandardItem *item = new QStandardItem(fname);
-        item->setData(mClipboardPixmap.scaled(iconSize, Qt::KeepAspectRatio), Qt::DecorationRole);
-        item->setSizeHint(gridSize);
-        item->setTextAlignment(Qt::AlignHCenter | Qt::AlignBottom);
-        model->appendRow(item);
-        model->sort(0);
-        setLabel(LABEL_LISTVIEW, model->rowCount(), "");
+        TImageCache::Current().invalidate(mPathTemporary + "/images/" + fname);
+        mImageModel->addImage(fname, mClipboardPixmap.scaled(iconSize, Qt::KeepAspectRatio), mClipboardPixmap.size());
+        setLabel(LABEL_LISTVIEW, mImageModel->rowCount(), "");
         mChanged = true;
     }
     else if (mTabSelected == SEL_DYNIMAGES)
@@ -397,11 +382,7 @@ void TResourceDialog::on_pushButtonRename_clicked()
                 setLabel(LABEL_LISTVIEW, ui->listViewImages->model()->rowCount(), "");
             }
 
-            QStandardItem *item = getItemFromListView(srcFile);
-
-            if (item)
-                item->setData(newFile, Qt::DisplayRole);
-
+            mImageModel->renameImage(srcFile, newFile);
             renameImageFile(srcFile, newFile);
             TMaps::Current().renameBitmap(srcFile, newFile);
             mChanged = true;
@@ -894,6 +875,15 @@ int TResourceDialog::getClipboardImageNumber()
     return mClipboardPixmapNumber;
 }
 
+/**
+ * @brief TResourceDialog::importImagesToListView
+ * Imports the images in the background. The files are copied, validated
+ * and scaled to icons by TImageImporter on worker threads. The list view
+ * and the maps are updated in batches as the results arrive. The dialog
+ * stays responsive and the import can be canceled at any time.
+ *
+ * @param images    The files to import with their full path.
+ */
 void TResourceDialog::importImagesToListView(const QStringList& images)
 {
     DECL_TRACER("TResourceDialog::importImagesToListView(const QStringList& images)");
@@ -901,64 +891,109 @@ void TResourceDialog::importImagesToListView(const QStringList& images)
     if (images.empty())
         return;
 
-    MSG_DEBUG("Selected " << images.count() << " images.");
-    QProgressDialog progress(tr("Copying images"), tr("Abort copy"), 0, images.count(), this);
-    progress.setWindowModality(Qt::WindowModal);
+    if (mImporter && mImporter->isRunning())
+    {
+        MSG_WARNING("An import of images is already running!");
+        return;
+    }
 
+    MSG_DEBUG("Selected " << images.count() << " images.");
     TMaps::Current().setPathTemporary(mPathTemporary);
-    QStandardItemModel *model = static_cast<QStandardItemModel *>(ui->listViewImages->model());
-    QStringList::ConstIterator iter;
-    int pos = 0;
+    // Images already in the list are not imported again.
+    QSet<QString> names(mImages.begin(), mImages.end());
+    QStringList files;
 
-    for (iter = images.cbegin(); iter != images.cend(); ++iter)
+    for (const QString& image : images)
     {
-        MSG_DEBUG("Working on file " << iter->toStdString());
-        pos++;
+        QString bn = basename(image);
 
-        progress.setValue(pos);
+        if (names.contains(bn))
+        {
+            MSG_DEBUG("Image " << bn.toStdString() << " exists");
+            continue;
+        }
 
-        if (progress.wasCanceled())
-            break;
+        names.insert(bn);
+        files.append(image);
+    }
 
-        mLastOpenPath = *iter;
+    mLastOpenPath = images.last();
 
-        if (!mImages.isEmpty())
-        {
-            QStringList::Iterator imIter;
-            bool haveImage = false;
+    if (files.isEmpty())
+        return;
 
-            for (imIter = mImages.begin(); imIter != mImages.end(); ++imIter)
-            {
-                if (*imIter == *iter)
-                {
-                    MSG_DEBUG("Image exists");
-                    haveImage = true;
-                    QList<QStandardItem *> items = model->findItems(*iter);
-                    QList<QStandardItem *>::Iterator itItem;
+    if (!mImporter)
+    {
+        mImporter = new TImageImporter(mPathTemporary + "/images", iconSize, this);
+        connect(mImporter, &TImageImporter::imported, this, &TResourceDialog::onImagesImported);
+        connect(mImporter, &TImageImporter::finished, this, &TResourceDialog::onImagesImportFinished);
+    }
 
-                    for (itItem = items.begin(); itItem != items.end(); ++itItem)
-                        model->itemChanged(*itItem);
-                }
-            }
+    mImportErrors.clear();
+    mImportProgress = new QProgressDialog(tr("Importing images"), tr("Abort import"), 0, static_cast<int>(files.size()), this);
+    mImportProgress->setWindowModality(Qt::WindowModal);
+    mImportProgress->setMinimumDuration(500);
+    connect(mImporter, &TImageImporter::progress, mImportProgress, &QProgressDialog::setValue);
+    connect(mImportProgress, &QProgressDialog::canceled, mImporter, &TImageImporter::cancel);
+    mImportProgress->setValue(0);
+    mImporter->start(files);
+}
 
-            if (haveImage)
-                continue;
+/**
+ * @brief TResourceDialog::onImagesImported
+ * Adds a batch of imported images to the list view and to the maps.
+ *
+ * @param results   The results of the imported files.
+ */
+void TResourceDialog::onImagesImported(const QList<TImageImporter::IMPORT_RESULT_t>& results)
+{
+    DECL_TRACER("TResourceDialog::onImagesImported(const QList<TImageImporter::IMPORT_RESULT_t>& results)");
+
+    QStringList names;
+
+    for (const TImageImporter::IMPORT_RESULT_t& result : results)
+    {
+        if (!result.error.isEmpty())
+        {
+            mImportErrors.append(QString("%1: %2").arg(result.file, result.error));
+            continue;
         }
 
-        QString bn = basename(*iter);
-        QStandardItem *item = new QStandardItem(bn);
-        item->setData(sizeImage(iconSize, *iter), Qt::DecorationRole);
-        item->setSizeHint(gridSize);
-        item->setTextAlignment(Qt::AlignHCenter | Qt::AlignBottom);
-        model->appendRow(item);
-        mImages.append(bn);
-        TMaps::Current().addBitmap(*iter, 0, 0, 0, 0);
-        mChanged = true;
+        mImageModel->addImage(result.name, QPixmap::fromImage(result.icon), result.original);
+        TImageCache::Current().invalidate(mPathTemporary + "/images/" + result.name);
+        names.append(result.name);
     }
 
-    model->sort(0);
+    if (names.isEmpty())
+        return;
+
+    TMaps::Current().addBitmaps(names);
+    mImages.append(names);
+    mChanged = true;
     setLabel(LABEL_LISTVIEW, mImages.size(), "");
+}
+
+void TResourceDialog::onImagesImportFinished()
+{
+    DECL_TRACER("TResourceDialog::onImagesImportFinished()");
 
+    if (mImportProgress)
+    {
+        mImportProgress->close();
+        mImportProgress->deleteLater();
+        mImportProgress = nullptr;
+    }
+
+    if (mImportErrors.isEmpty())
+        return;
+
+    QStringList errors = mImportErrors.mid(0, 10);
+
+    if (mImportErrors.size() > errors.size())
+        errors.append(tr("... and %1 more").arg(mImportErrors.size() - errors.size()));
+
+    QMessageBox::warning(this, tr("Import images"), tr("The following files couldn't be imported:<br>%1").arg(errors.join("<br>")));
+    mImportErrors.clear();
 }
 
 void TResourceDialog::removeItemFromListView(const QString& file, int row)
@@ -968,6 +1003,7 @@ void TResourceDialog::removeItemFromListView(const QString& file, int row)
     MSG_DEBUG("Removing file and item " << file.toStdString() << " in row " << row);
     ui->listViewImages->model()->removeRow(row);
     TMaps::Current().removeBitmap(file);
+    TImageCache::Current().invalidate(mPathTemporary + "/images/" + file);
     // Remove from interbal list
     QStringList::Iterator inIter;
 
@@ -986,29 +1022,7 @@ int TResourceDialog::getRowFromListView(const QString& file)
     DECL_TRACER("TResourceDialog::getRowFromListView(const QString& file)");
 
     MSG_DEBUG("Searching for item in row with name " << file.toStdString());
-    QStandardItemModel *model = static_cast<QStandardItemModel *>(ui->listViewImages->model());
-    QList<QStandardItem *> list = model->findItems(file);
-
-    if (list.isEmpty())
-        return -1;
-
-    MSG_DEBUG("Found item in row " << list[0]->row());
-    return list[0]->row();
-}
-
-QStandardItem *TResourceDialog::getItemFromListView(const QString& file)
-{
-    DECL_TRACER("TResourceDialog::getItemromListView(const QString& file)");
-
-    MSG_DEBUG("Searching for item with name " << file.toStdString());
-    QStandardItemModel *model = static_cast<QStandardItemModel *>(ui->listViewImages->model());
-    QList<QStandardItem *> list = model->findItems(file);
-
-    if (list.isEmpty())
-        return nullptr;
-
-    MSG_DEBUG("Found item in row " << list[0]->row());
-    return list[0];
+    return mImageModel->findRow(file);
 }
 
 void TResourceDialog::renameImageFile(const QString& ori, const QString& tgt)
@@ -1016,6 +1030,9 @@ void TResourceDialog::renameImageFile(const QString& ori, const QString& tgt)
     DECL_TRACER("TResourceDialog::renameImageFile(const QString& ori, const QString& tgt)");
 
     MSG_DEBUG("Renaming file " << ori.toStdString() << " to " << tgt.toStdString());
+    // The decoded images of both names are no longer valid
+    TImageCache::Current().invalidate(mPathTemporary + "/images/" + ori);
+    TImageCache::Current().invalidate(mPathTemporary + "/images/" + tgt);
     QStringList::Iterator iter;
 
     for (iter = mImages.begin(); iter != mImages.end(); ++iter)
@@ -22,6 +22,7 @@
 #include <QClipboard>
 
 #include "tconfmain.h"
+#include "timageimporter.h"
 
 namespace Ui {
 class TResourceDialog;
@@ -32,6 +33,8 @@ class QItemSelection;
 class QFileDialog;
 class QStandardItem;
 class QStandardItemModel;
+class QProgressDialog;
+class TImageListModel;
 class QItemSelectionModel;
 
 class TResourceDialog : public QDialog
@@ -75,7 +78,6 @@ class TResourceDialog : public QDialog
         void importImagesToListView(const QStringList& files);
         void removeItemFromListView(const QString& file, int row);
         int getRowFromListView(const QString& file);
-        QStandardItem *getItemFromListView(const QString& file);
         void renameImageFile(const QString& ori, const QString& tgt);
         void setLabel(LABEL_t lb, int number, const QString& text);
         void disableClipboardButtons();
@@ -88,6 +90,8 @@ class TResourceDialog : public QDialog
         void copyDynamicImageToClipboard();
 
         void onImageImportFinished(int result);
+        void onImagesImported(const QList<TImageImporter::IMPORT_RESULT_t>& results);
+        void onImagesImportFinished();
         void onClipboardChanged(QClipboard::Mode mode);
         void onClipboardDataChanged();
         bool parseDynamicImageFromClipboard(ConfigMain::RESOURCE_t *res, const QString& txt);
@@ -142,8 +146,12 @@ class TResourceDialog : public QDialog
         int mClipboardPixmapNumber{0};              // A number appended to the name of a pixmap received from the clipboard
         // Images
         QStringList mImages;                        // A list of images
+        TImageListModel *mImageModel{nullptr};      // The model of the list of images
         bool mChanged{false};                       // TRUE = Some data have changed e.g. the document has changed.
         QFileDialog *mImportImagesDialog{nullptr};  // The file dialog to import images. This is for an asynchronous dialog!
+        TImageImporter *mImporter{nullptr};         // Imports the images in the background
+        QProgressDialog *mImportProgress{nullptr};  // Shows the progress of the import
+        QStringList mImportErrors;                  // The files which couldn't be imported
         // Dynamic resources
         QList<ConfigMain::RESOURCE_t> mDynamicResources;    // List of dynamic resources
         int mDynamicRowSelected{-1};                // The row selected in the dynamic image list.
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+#include "tspatialindex.h"
+#include "terror.h"
+
+TSpatialIndex::TSpatialIndex(int cellSize)
+    : mCellSize(cellSize > 0 ? cellSize : 64)
+{
+    DECL_TRACER("TSpatialIndex::TSpatialIndex(int cellSize)");
+}
+
+void TSpatialIndex::clear()
+{
+    DECL_TRACER("TSpatialIndex::clear()");
+
+    mRects.clear();
+    mCells.clear();
+}
+
+/**
+ * @brief TSpatialIndex::insert
+ * Inserts a rectangle into the index. If the ID exists already, the
+ * rectangle is moved to the new position.
+ *
+ * @param id    A unique ID of the rectangle (the button index).
+ * @param rect  The rectangle.
+ */
+void TSpatialIndex::insert(int id, const QRect& rect)
+{
+    DECL_TRACER("TSpatialIndex::insert(int id, const QRect& rect)");
+
+    if (mRects.contains(id))
+    {
+        move(id, rect);
+        return;
+    }
+
+    mRects.insert(id, rect);
+
+    if (rect.isEmpty())
+        return;
+
+    int x1, y1, x2, y2;
+    getCells(rect, &x1, &y1, &x2, &y2);
+
+    for (int y = y1; y <= y2; ++y)
+    {
+        for (int x = x1; x <= x2; ++x)
+            mCells[cellKey(x, y)].append(id);
+    }
+}
+
+/**
+ * @brief TSpatialIndex::remove
+ * Removes a rectangle from the index.
+ *
+ * @param id    The ID of the rectangle.
+ */
+void TSpatialIndex::remove(int id)
+{
+    DECL_TRACER("TSpatialIndex::remove(int id)");
+
+    QHash<int, QRect>::Iterator iter = mRects.find(id);
+
+    if (iter == mRects.end())
+        return;
+
+    QRect rect = iter.value();
+    mRects.erase(iter);
+
+    if (rect.isEmpty())
+        return;
+
+    int x1, y1, x2, y2;
+    getCells(rect, &x1, &y1, &x2, &y2);
+
+    for (int y = y1; y <= y2; ++y)
+    {
+        for (int x = x1; x <= x2; ++x)
+        {
+            QHash<quint64, QList<int>>::Iterator cell = mCells.find(cellKey(x, y));
+
+            if (cell == mCells.end())
+                continue;
+
+            cell->removeOne(id);
+
+            if (cell->isEmpty())
+                mCells.erase(cell);
+        }
+    }
+}
+
+/**
+ * @brief TSpatialIndex::move
+ * Changes the rectangle of an ID. If the rectangle still covers the same
+ * cells, only the stored rectangle is changed.
+ *
+ * @param id    The ID of the rectangle.
+ * @param rect  The new rectangle.
+ */
+void TSpatialIndex::move(int id, const QRect& rect)
+{
+    DECL_TRACER("TSpatialIndex::move(int id, const QRect& rect)");
+
+    QHash<int, QRect>::Iterator iter = mRects.find(id);
+
+    if (iter == mRects.end())
+    {
+        insert(id, rect);
+        return;
+    }
+
+    if (iter.value() == rect)
+        return;
+
+    if (!iter.value().isEmpty() && !rect.isEmpty())
+    {
+        int ox1, oy1, ox2, oy2, nx1, ny1, nx2, ny2;
+        getCells(iter.value(), &ox1, &oy1, &ox2, &oy2);
+        getCells(rect, &nx1, &ny1, &nx2, &ny2);
+
+        if (ox1 == nx1 && oy1 == ny1 && ox2 == nx2 && oy2 == ny2)
+        {
+            iter.value() = rect;
+            return;
+        }
+    }
+
+    remove(id);
+    insert(id, rect);
+}
+
+/**
+ * @brief TSpatialIndex::query
+ * Returns the IDs of all rectangles in the cell of the point \b pt.
+ *
+ * @param pt    A point on the page.
+ * @return A list of candidates.
+ */
+QList<int> TSpatialIndex::query(const QPoint& pt) const
+{
+    DECL_TRACER("TSpatialIndex::query(const QPoint& pt) const");
+
+    int x1, y1, x2, y2;
+    getCells(QRect(pt, QSize(1, 1)), &x1, &y1, &x2, &y2);
+    return mCells.value(cellKey(x1, y1));
+}
+
+/**
+ * @brief TSpatialIndex::query
+ * Returns the IDs of all rectangles in the cells covered by \b rect.
+ * Every ID is returned only once, even if it touches several cells.
+ *
+ * @param rect  An area of the page.
+ * @return A list of candidates.
+ */
+QList<int> TSpatialIndex::query(const QRect& rect) const
+{
+    DECL_TRACER("TSpatialIndex::query(const QRect& rect) const");
+
+    QList<int> list;
+
+    if (rect.isEmpty())
+        return list;
+
+    int x1, y1, x2, y2;
+    getCells(rect, &x1, &y1, &x2, &y2);
+    QSet<int> seen;
+
+    for (int y = y1; y <= y2; ++y)
+    {
+        for (int x = x1; x <= x2; ++x)
+        {
+            QHash<quint64, QList<int>>::ConstIterator cell = mCells.constFind(cellKey(x, y));
+
+            if (cell == mCells.constEnd())
+                continue;
+
+            for (int id : cell.value())
+            {
+                if (!seen.contains(id))
+                {
+                    seen.insert(id);
+                    list.append(id);
+                }
+            }
+        }
+    }
+
+    return list;
+}
+
+void TSpatialIndex::getCells(const QRect& rect, int *x1, int *y1, int *x2, int *y2) const
+{
+    // Floor division to handle objects partly outside of the page.
+    auto cell = [this](int v) { return v >= 0 ? v / mCellSize : -((-v + mCellSize - 1) / mCellSize); };
+
+    *x1 = cell(rect.left());
+    *y1 = cell(rect.top());
+    *x2 = cell(rect.left() + rect.width() - 1);
+    *y2 = cell(rect.top() + rect.height() - 1);
+}
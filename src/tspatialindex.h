@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TSPATIALINDEX_H
+#define TSPATIALINDEX_H
+
+#include <QHash>
+#include <QSet>
+#include <QList>
+#include <QRect>
+#include <QPoint>
+
+/**
+ * @brief The TSpatialIndex class
+ * A uniform grid dividing a page into square cells. Every cell knows the
+ * IDs of the rectangles touching it. A point query has only to look at
+ * the cell containing the point instead of all rectangles of a page.
+ *
+ * The results of a query are candidates. They are unique, but the
+ * caller must still check the exact geometry.
+ */
+class TSpatialIndex
+{
+    public:
+        TSpatialIndex(int cellSize=64);
+
+        void clear();
+        void insert(int id, const QRect& rect);
+        void remove(int id);
+        void move(int id, const QRect& rect);
+        bool contains(int id) const { return mRects.contains(id); }
+        QRect getRect(int id) const { return mRects.value(id); }
+
+        QList<int> query(const QPoint& pt) const;
+        QList<int> query(const QRect& rect) const;
+
+    private:
+        void getCells(const QRect& rect, int *x1, int *y1, int *x2, int *y2) const;
+        static quint64 cellKey(int x, int y) { return (static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y); }
+
+        int mCellSize{64};                      // Width and height of a cell in pixels
+        QHash<int, QRect> mRects;               // The rectangle of every ID
+        QHash<quint64, QList<int>> mCells;      // The IDs touching a cell
+};
+
+#endif // TSPATIALINDEX_H
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include "tstringpool.h"
+#include "terror.h"
+
+TStringPool *TStringPool::mCurrent{nullptr};
+
+TStringPool& TStringPool::Current()
+{
+//    DECL_TRACER("TStringPool::Current()");
+
+    if (!mCurrent)
+        mCurrent = new TStringPool;
+
+    return *mCurrent;
+}
+
+/**
+ * @brief TStringPool::intern
+ * Searches the pool for a string with the same content. If there is one,
+ * the pooled string is returned. Otherwise the string is added to the
+ * pool. Empty strings are returned unchanged.
+ *
+ * @param str   The string to intern.
+ * @return A string sharing the data with the pooled one.
+ */
+QString TStringPool::intern(const QString& str)
+{
+    DECL_TRACER("TStringPool::intern(const QString& str)");
+
+    if (str.isEmpty())
+        return str;
+
+    QMutexLocker locker(&mMutex);
+    mReferences++;
+    QSet<QString>::ConstIterator iter = mPool.constFind(str);
+
+    if (iter == mPool.constEnd())
+        return *mPool.insert(str);
+
+    // The duplicate is released as soon as the caller drops it
+    if (!isSame(*iter, str))
+        mSavedBytes += static_cast<qsizetype>(str.size() * sizeof(QChar));
+
+    return *iter;
+}
+
+void TStringPool::clear()
+{
+    DECL_TRACER("TStringPool::clear()");
+
+    QMutexLocker locker(&mMutex);
+    mPool.clear();
+    mReferences = 0;
+    mSavedBytes = 0;
+}
+
+/**
+ * @brief TStringPool::logStatistics
+ * Writes the number of unique strings, the number of references and the
+ * memory saved so far into the log.
+ */
+void TStringPool::logStatistics()
+{
+    DECL_TRACER("TStringPool::logStatistics()");
+
+    QMutexLocker locker(&mMutex);
+    MSG_INFO("String pool: " << mPool.size() << " unique values for " << mReferences << " references, " << mSavedBytes << " bytes saved.");
+}
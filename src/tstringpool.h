@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TSTRINGPOOL_H
+#define TSTRINGPOOL_H
+
+#include <QString>
+#include <QSet>
+#include <QMutex>
+
+/**
+ * @brief The TStringPool class
+ * A project wide table of interned strings. Many properties of the button
+ * states (border names, fonts, gradient types, bitmap and sound file
+ * names) repeat the same few values thousands of times. Each value is
+ * stored only once in the pool. Every string returned by \b intern()
+ * shares the data of the pooled string because QString is implicitly
+ * shared.
+ * Two interned strings with the same content share the same data, so
+ * they can be compared with \b isSame() by a pointer comparison.
+ * The pool is protected by a mutex, so it can be used from any thread.
+ */
+class TStringPool
+{
+    public:
+        static TStringPool& Current();
+
+        QString intern(const QString& str);
+        void clear();
+        void logStatistics();
+
+        static bool isSame(const QString& s1, const QString& s2) { return s1.constData() == s2.constData() && s1.size() == s2.size(); }
+        qsizetype size() const { QMutexLocker locker(&mMutex); return mPool.size(); }
+        qsizetype getSavedBytes() const { QMutexLocker locker(&mMutex); return mSavedBytes; }
+
+    private:
+        TStringPool() {}
+
+        static TStringPool *mCurrent;
+        mutable QMutex mMutex;              // Protects all members below
+        QSet<QString> mPool;                // The unique strings
+        qsizetype mReferences{0};           // Number of calls to intern()
+        qsizetype mSavedBytes{0};           // Sum of the sizes of all duplicate strings
+};
+
+#endif // TSTRINGPOOL_H
@@ -167,6 +167,7 @@ void TSubPageSetDialog::on_pushButtonAdd_clicked()
         return;
 
     Page::PAGE_t *page = TPageHandler::Current().getSubPage(pageName);
+    TPageHandler::Current().ensureLoaded(page);
 
     if (!page || page->pageID <= 0)
     {
@@ -17,8 +17,10 @@
  */
 #include <QPainter>
 #include <QPixmap>
+#include <QtMath>
 
 #include "tsubviewarea.h"
+#include "tmockcache.h"
 #include "terror.h"
 
 /**
@@ -148,14 +150,9 @@ QPixmap *TSubViewArea::drawSubViewMock(int width, int height, int numItems)
         }
     }
 
-    QBrush brush(Qt::Dense6Pattern);
-    brush.setColor(mLayoutColor);
-    QPen pen(mLayoutColor);
-    pen.setStyle(Qt::SolidLine);
-
-    p.setPen(pen);
-    p.setBrush(brush);
-    p.setBackground(Qt::transparent);
+    // All items look the same. Therefore only one item is drawn and then
+    // blitted at each position.
+    QPixmap item = getItemLayer();
     int spacePixel = static_cast<int>(static_cast<double>(mVertical ? mItemSize.height() : mItemSize.width()) / 100.0 * static_cast<double>(mSpace));
 
     for (int i = 0; i < numItems; ++i)
@@ -165,8 +162,7 @@ QPixmap *TSubViewArea::drawSubViewMock(int width, int height, int numItems)
         else if (!mVertical && startX >= width)
             break;
 
-        p.drawRect(startX, startY, mItemSize.width(), mItemSize.height());
-        p.fillRect(startX + 1, startY + 1, mItemSize.width() - 2, mItemSize.height() - 2, brush);
+        p.drawPixmap(startX, startY, item);
 
         if (mVertical)
             startY += mItemSize.height() + spacePixel;
@@ -178,6 +174,48 @@ QPixmap *TSubViewArea::drawSubViewMock(int width, int height, int numItems)
     return mPixmap;
 }
 
+/**
+ * @brief TSubViewArea::getItemLayer
+ * Returns the placeholder of one item. It depends only on the item size and
+ * the layout color. It is taken from the TMockCache and drawn only if it is
+ * not there.
+ *
+ * @return The item including its frame.
+ */
+QPixmap TSubViewArea::getItemLayer()
+{
+    DECL_TRACER("TSubViewArea::getItemLayer()");
+
+    qreal dpr = mPixmap ? mPixmap->devicePixelRatio() : 1.0;
+    QString key = QString("subview|%1x%2|%3|%4").arg(mItemSize.width()).arg(mItemSize.height())
+                                                .arg(mLayoutColor.rgba(), 8, 16, QChar('0')).arg(dpr);
+    QPixmap layer;
+
+    if (TMockCache::Current().get(key, &layer))
+        return layer;
+
+    // The frame is drawn 1 pixel right and below of the item size.
+    layer = QPixmap(qMax(1, qCeil((mItemSize.width() + 1) * dpr)), qMax(1, qCeil((mItemSize.height() + 1) * dpr)));
+    layer.setDevicePixelRatio(dpr);
+    layer.fill(Qt::transparent);
+
+    QBrush brush(Qt::Dense6Pattern);
+    brush.setColor(mLayoutColor);
+    QPen pen(mLayoutColor);
+    pen.setStyle(Qt::SolidLine);
+
+    QPainter p(&layer);
+    p.setPen(pen);
+    p.setBrush(brush);
+    p.setBackground(Qt::transparent);
+    p.drawRect(0, 0, mItemSize.width(), mItemSize.height());
+    p.fillRect(1, 1, mItemSize.width() - 2, mItemSize.height() - 2, brush);
+    p.end();
+
+    TMockCache::Current().insert(key, layer);
+    return layer;
+}
+
 /**
  * @brief TSubViewArea::setAnchor
  * This defines the anchor. The anchor defines the start of the first item.
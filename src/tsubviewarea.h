@@ -128,6 +128,8 @@ class TSubViewArea
         void setPixmap(QPixmap *pm);
 
     private:
+        QPixmap getItemLayer();
+
         QPixmap *mPixmap{nullptr};
         bool mScrollbarVisible{false};
         int mScrollbarOffset{0};
@@ -21,6 +21,7 @@
 #include <QFileDialog>
 #include <QResizeEvent>
 #include <QMessageBox>
+#include <QProgressDialog>
 #include <QMdiSubWindow>
 #include <QtEnvironmentVariables>
 
@@ -36,6 +37,13 @@
 #include "tprojectproperties.h"
 #include "tpaneltypes.h"
 #include "tpagehandler.h"
+#include "tobjecttable.h"
+#include "trenderqueue.h"
+#include "tpagerenderer.h"
+#include "tthumbnailcache.h"
+#include "timagecache.h"
+#include "tpageexporter.h"
+#include "trendercheck.h"
 #include "taddpagedialog.h"
 #include "taddpopupdialog.h"
 #include "tresourcedialog.h"
@@ -98,6 +106,7 @@ bool winCloseEater::eventFilter(QObject *obj, QEvent *event)
 
             if (id > 0)
             {
+                TRenderQueue::Current().removePage(id);
                 TPageHandler::Current().setVisible(id, false);
                 TWorkSpaceHandler::Current().clear();
             }
@@ -154,6 +163,7 @@ TSurface::TSurface(QWidget *parent)
     TWorkSpaceHandler::Current().regMarkDirty(bind(&TSurface::onMarkDirty, this));
     TWorkSpaceHandler::Current().regRequestDraw(bind(&TSurface::onRedrawRequest, this, std::placeholders::_1));
     TWorkSpaceHandler::Current().regRequestDrawObject(bind(&TSurface::onRedrawObject, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+    TRenderQueue::Current().regDrawObject(bind(&TSurface::onDrawQueuedObject, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
 
     connect(m_ui->splitter, &QSplitter::splitterMoved, this, &TSurface::onSplitterMoved);
     connect(m_ui->mdiArea, &QMdiArea::subWindowActivated, this, &TSurface::onSubWindowActivated);
@@ -240,104 +250,18 @@ void TSurface::drawBackgroundColor(const Page::PAGE_t& page)
         return;
     }
 
-    QList<QColor> gradients = page.srPage.gradientColors;
+    TCanvasWidget *widget = page.baseObject.widget;
+    QBrush brush = TPageRenderer::getBackground(page, widget->rect());
 
-    if (gradients.empty() || gradients.size() < 2)
+    switch(brush.style())
     {
-        MSG_WARNING("No gradient colors! Will use default colors!");
-        gradients = { Qt::gray, Qt::white };
-    }
-
-    if (page.srPage.ft == "solid")
-    {
-        page.baseObject.widget->setSolidColor(page.srPage.cf);
-        return;
-    }
-
-    int entity = qMax(page.width, page.height);
-    qreal stop = static_cast<qreal>(entity) / static_cast<qreal>(gradients.size()) / static_cast<qreal>(entity);
-    QGradientStops gstops;
-    qreal point = 0.0;
+        case Qt::LinearGradientPattern:     widget->setLinearGradient(*static_cast<const QLinearGradient *>(brush.gradient())); break;
+        case Qt::RadialGradientPattern:     widget->setRadialGradient(*static_cast<const QRadialGradient *>(brush.gradient())); break;
+        case Qt::ConicalGradientPattern:    widget->setConicGradient(*static_cast<const QConicalGradient *>(brush.gradient())); break;
 
-    if (gradients.size() == 2)
-        stop = 1.0;
-
-    for (QColor col : gradients)
-    {
-        gstops.append(std::pair<qreal, QColor>(point, col));
-        point += stop;
-    }
-
-    gstops.last() = std::pair<qreal, QColor>(1.0, gradients.last());
-
-    if (page.srPage.ft == "radial")    // Colors in circles
-    {
-        QRadialGradient radial;
-        // Calculate center point;
-        qreal rx = static_cast<qreal>(page.width) / 100.0 * static_cast<qreal>(page.srPage.gx);
-        qreal ry = static_cast<qreal>(page.height) / 100.0 * static_cast<qreal>(page.srPage.gy);
-        radial.setCenter(rx, ry);
-        radial.setFocalPoint(rx, ry);
-        radial.setRadius(static_cast<qreal>(page.srPage.gr));
-        radial.setStops(gstops);
-        page.baseObject.widget->setRadialGradient(radial);
-        return;
-    }
-    else if (page.srPage.ft == "sweep")
-    {
-        QConicalGradient grad;
-        grad.setAngle(0.0);
-        grad.setCenter(page.baseObject.widget->rect().toRectF().center());
-        grad.setStops(gstops);
-        page.baseObject.widget->setConicGradient(grad);
-        return;
-    }
-
-    QLinearGradient linear;
-    linear.setStops(gstops);
-
-    if (page.srPage.ft == "linearCLCR")
-    {
-        linear.setStart(0.0, static_cast<qreal>(page.height / 2));
-        linear.setFinalStop(static_cast<qreal>(page.width), static_cast<qreal>(page.height / 2));
-    }
-    else if (page.srPage.ft == "linearTLBR")
-    {
-        linear.setStart(0.0, 0.0);
-        linear.setFinalStop(static_cast<qreal>(page.width), static_cast<qreal>(page.height));
-    }
-    else if (page.srPage.ft == "linearCTCB")
-    {
-        linear.setStart(static_cast<qreal>(page.width / 2), 0.0);
-        linear.setFinalStop(static_cast<qreal>(page.width / 2), static_cast<qreal>(page.height));
-    }
-    else if (page.srPage.ft == "linearTRBL")
-    {
-        linear.setStart(static_cast<qreal>(page.width), 0.0);
-        linear.setFinalStop(0.0, static_cast<qreal>(page.height));
-    }
-    else if (page.srPage.ft == "linearCRCL")
-    {
-        linear.setStart(static_cast<qreal>(page.width), static_cast<qreal>(page.height / 2));
-        linear.setFinalStop(0.0, static_cast<qreal>(page.height / 2));
-    }
-    else if (page.srPage.ft == "linearBRTL")
-    {
-        linear.setStart(static_cast<qreal>(page.width), static_cast<qreal>(page.height));
-        linear.setFinalStop(0.0, 0.0);
-    }
-    else if (page.srPage.ft == "linearCBCT")
-    {
-        linear.setStart(static_cast<qreal>(page.width / 2), static_cast<qreal>(page.height));
-        linear.setFinalStop(static_cast<qreal>(page.width / 2), 0.0);
-    }
-    else if (page.srPage.ft == "linearBLTR")
-    {
-        linear.setStart(0.0, static_cast<qreal>(page.height));
-        linear.setFinalStop(static_cast<qreal>(page.width), 0.0);
+        default:
+            widget->setSolidColor(brush.color());
     }
-
-    page.baseObject.widget->setLinearGradient(linear);
 }
 
 void TSurface::setWindowSize(const QSize& size, QWidget *widget)
@@ -432,12 +356,12 @@ void TSurface::addObject(int id, QPoint pt)
     DECL_TRACER("TSurface::addObject(int id, QPoint pt)");
 
     Page::PAGE_t *page = TPageHandler::Current().getPage(id);
+    TPageHandler::Current().ensureLoaded(page);
 
     if (!page || page->pageID <= 0 || !page->baseObject.widget || !page->visible)
         return;
 
-    QList<ObjHandler::TOBJECT_t> olist = TPageHandler::Current().getObjectList(*page);
-    int btNumber = getNextObjectNumber(olist);
+    int btNumber = getNextObjectNumber(page->pageID);
     ObjHandler::TOBJECT_t object = TPageHandler::Current().initNewObject(btNumber, QString("Button %1").arg(btNumber));
     QWidget* content = new QWidget(page->baseObject.widget);
     QString objName = QString("Object_%1").arg(btNumber);
@@ -546,7 +470,7 @@ void TSurface::drawObject(Page::PAGE_t *page, int objIndex, int instance)
         return;
 
     TObjectHandler *pobject = page->objects[objIndex];
-    ObjHandler::TOBJECT_t& object = pobject->getObject();
+    const ObjHandler::TOBJECT_t& object = pobject->getObject();
     int inst = instance < 0 || instance >= object.sr.size() ? 0 : instance;
 
     if (object.sr.empty())
@@ -556,6 +480,8 @@ void TSurface::drawObject(Page::PAGE_t *page, int objIndex, int instance)
     }
 
     MSG_DEBUG("Drawing object " << object.bi << ", " << object.na.toStdString() << " on page " << page->pageID << " and using instance " << instance);
+    // A pending job of the render queue would overwrite this drawing later.
+    TRenderQueue::Current().remove(page->pageID, object.bi);
     TResizableWidget *rwidget = page->baseObject.widget->getWidget(object.bi);
 
     if (!rwidget)
@@ -565,23 +491,59 @@ void TSurface::drawObject(Page::PAGE_t *page, int objIndex, int instance)
     pobject->drawObject(rwidget, inst);
 }
 
-int TSurface::getNextObjectNumber(QList<ObjHandler::TOBJECT_t>& objects)
+/**
+ * @brief TSurface::queueObject
+ * This method does the same as drawObject() but leaves the drawing to the
+ * render queue. The images of the object are loaded in the background and
+ * the object is drawn as soon as they are ready. If the object has no
+ * widget yet, a widget showing a placeholder is created.
+ *
+ * @param page      A pointer to a page or popup
+ * @param objIndex  The index to the object to draw
+ * @param instance  The index into the array SR_T of an object.
+ */
+void TSurface::queueObject(Page::PAGE_t *page, int objIndex, int instance)
 {
-    DECL_TRACER("TSurface::getNextObjectNumber(QList<ObjHandler::TOBJECT_t>& objects)");
+    DECL_TRACER("TSurface::queueObject(Page::PAGE_t *page, int objIndex, int instance)");
 
-    if (objects.empty())
-        return 1;
+    if (!page || page->pageID <= 0 || objIndex < 0 || objIndex >= page->objects.size() || !page->baseObject.widget)
+        return;
 
-    int btNumber = 0;
-    QList<ObjHandler::TOBJECT_t>::Iterator iter;
+    const ObjHandler::TOBJECT_t& object = page->objects[objIndex]->getObject();
+    int inst = instance < 0 || instance >= object.sr.size() ? 0 : instance;
 
-    for (iter = objects.begin(); iter != objects.end(); ++iter)
+    if (object.sr.empty())
     {
-        if (iter->bi > btNumber)
-            btNumber = iter->bi;
+        MSG_ERROR("The object " << object.bi << " on page " << page->pageID << " has no SR section!");
+        return;
+    }
+
+    TResizableWidget *rwidget = page->baseObject.widget->getWidget(object.bi);
+
+    if (!rwidget)
+    {
+        rwidget = initObject(page, objIndex);
+
+        if (!rwidget)
+            return;
+
+        rwidget->setStyleSheet("background: transparent");
+        rwidget->setPixmap(TRenderQueue::getPlaceholder(QSize(object.wt, object.ht)));
     }
 
-    return btNumber + 1;
+    TRenderQueue::Current().enqueue(page->pageID, object, inst);
+}
+
+int TSurface::getNextObjectNumber(int pageID)
+{
+    DECL_TRACER("TSurface::getNextObjectNumber(int pageID)");
+
+    TObjectTable *table = TPageHandler::Current().getObjectTable(pageID);
+
+    if (!table)
+        return 1;
+
+    return table->getMaxButtonIndex() + 1;
 }
 
 //
@@ -625,6 +587,7 @@ void TSurface::on_actionOpen_triggered()
             m_ui->mdiArea->closeAllSubWindows();                                    // Close all subwindows
             TWorkSpaceHandler::Current().clear();                                   // Reset the properties
             TPageHandler::Current().reset();                                        // Remove the pages from memory
+            TFonts::reset();                                                        // Remove the fonts of the project
             std::error_code ec;                                                     // Used to get the error code. This avoids the need of an exception.
             fs::remove_all(mPathTemporary.toStdString(), ec);                       // Delete all temporary files and directories.
             TConfMain::Current().reset();                                           // Reset the configuration settings
@@ -643,6 +606,21 @@ void TSurface::on_actionOpen_triggered()
     if (file.isEmpty())
         return;
 
+    openProject(file);
+}
+
+/**
+ * @brief TSurface::openProject
+ * Opens a project file and fills the structures. If the file is one of
+ * the supported formats, the page tree is created.
+ *
+ * @param file  The path and name of the file.
+ * @return TRUE on success.
+ */
+bool TSurface::openProject(const QString& file)
+{
+    DECL_TRACER("TSurface::openProject(const QString& file)");
+
     bool doCommon = false;
 
     if (file.endsWith(".tp4", Qt::CaseInsensitive) || file.endsWith(".tp5", Qt::CaseInsensitive))
@@ -654,8 +632,8 @@ void TSurface::on_actionOpen_triggered()
 
         if (!reader.unpack(file.toStdString(), mPathTemporary.toStdString()))
         {
-            QMessageBox::critical(this, tr("File read error"), tr("Error reading file %1!").arg(file));
-            return;
+            showError(tr("File read error"), tr("Error reading file %1!").arg(file));
+            return false;
         }
 
         bool g5 = reader.isG5();
@@ -686,19 +664,31 @@ void TSurface::on_actionOpen_triggered()
         mPathTemporary = createTemporaryPath(basename(file));               // The path of the temporary directory with all files
         TSurfaceReader sreader(file, mPathTemporary);                       // Unzip file and write the contents into temporary direcory
         TConfMain::Current().setPathTemporary(mPathTemporary);              // Initialize class with path to temporary directory
-        TConfMain::Current().readProject(mPathTemporary + "/prj_.json");    // Read the main project file
+
+        if (!TConfMain::Current().readProject(mPathTemporary + "/prj_.json"))   // Read the main project file
+        {
+            showError(tr("File read error"), tr("Error reading the project of file %1!").arg(file));
+            return false;
+        }
+
         TConfMain::Current().setFileName(file);                             // Initialize the class with the filename of the opened file
         TPageHandler::Current().setPathTemporary(mPathTemporary);           // Initialize class with path to temporary directory
         QStringList pages = TConfMain::Current().getAllPages();             // Get names of all pages
         QStringList popups = TConfMain::Current().getAllPopups();           // Get names of all popups
         pages.append(popups);                                               // Merge the lists
-        TPageHandler::Current().readPages(pages);                           // Read all pages fron their files
+
+        if (!TPageHandler::Current().readPages(pages))                      // Read all pages fron their files
+        {
+            showError(tr("File read error"), tr("Error reading the pages of file %1!").arg(file));
+            return false;
+        }
+
         doCommon = true;
     }
     else
     {
-        QMessageBox::critical(this, tr("File open error"), tr("The file %1 can't be opened!\nMake sure the file exists and is in the formats <i>.tsf</i>, <i>.TP4</i> or <i>.TP5</i>!"));
-        return;
+        showError(tr("File open error"), tr("The file %1 can't be opened!\nMake sure the file exists and is in the formats <i>.tsf</i>, <i>.TP4</i> or <i>.TP5</i>!").arg(file));
+        return false;
     }
 
     if (doCommon)
@@ -711,7 +701,7 @@ void TSurface::on_actionOpen_triggered()
 
         for (iter = pageNumbers.begin(); iter != pageNumbers.end(); ++iter) // Iterate through the page numbers
         {
-            Page::PAGE_t *pg = TPageHandler::Current().getPage(*iter);      // Get the page
+            Page::PAGE_t *pg = TPageHandler::Current().getPageHeader(*iter);    // Get the header of the page
 
             if (!pg || pg->pageID <= 0)                                     // Should never be true, but who knows ...
             {
@@ -733,6 +723,30 @@ void TSurface::on_actionOpen_triggered()
         mIsSaved = true;                                                    // Set mark that there exists already a file.
         initMenu();                                                         // Initialize the menu points
     }
+
+    return doCommon;
+}
+
+/**
+ * @brief TSurface::showError
+ * Shows an error in a message box. If the application runs from the
+ * command line, no window may be opened. Then the error is only logged
+ * and the caller returns an exit code.
+ *
+ * @param title The title of the message box.
+ * @param text  The error message.
+ */
+void TSurface::showError(const QString& title, const QString& text)
+{
+    DECL_TRACER("TSurface::showError(const QString& title, const QString& text)");
+
+    if (mBatch)
+    {
+        MSG_ERROR(title.toStdString() << ": " << text.toStdString());
+        return;
+    }
+
+    QMessageBox::critical(this, title, text);
 }
 
 /**
@@ -830,6 +844,7 @@ void TSurface::on_actionNew_triggered()
     int id = TPageHandler::Current().createPage(widget, Page::PT_PAGE, npd.getPageName(), npd.getResolution().width(), npd.getResolution().height());
     QString objName(QString("Canvas_%1").arg(id));                              // Create a name for the object
     widget->setObjectName(objName);
+    widget->setPageID(id);
     TPageHandler::Current().setPageBgColor(id, npd.getColorBackground());       // Set the background color
     TPageHandler::Current().setPageTextColor(id, npd.getColorText());           // Set the text color
     QMdiSubWindow *page = new QMdiSubWindow;
@@ -940,9 +955,12 @@ void TSurface::on_actionClose_triggered()
         return;
 
     m_ui->mdiArea->closeAllSubWindows();
+    TRenderQueue::Current().removeAll();
     TWorkSpaceHandler::Current().resetTree();
     TConfMain::Current().reset();
     TPageHandler::Current().reset();
+    TFonts::reset();
+    TImageCache::Current().clear();
     mPathTemporary.clear();
     mProjectChanged = false;
     mHaveProject = false;
@@ -1260,9 +1278,129 @@ void TSurface::on_actionEdit_Palettes_triggered()
 
 }
 
+/**
+ * @brief TSurface::on_actionExport_Page_Images_triggered
+ * Asks for a directory and writes all pages, popups and subpages of the
+ * project as PNG files into it.
+ */
 void TSurface::on_actionExport_Page_Images_triggered()
 {
+    DECL_TRACER("TSurface::on_actionExport_Page_Images_triggered()");
+
+    if (!mHaveProject)
+        return;
+
+    QString dir = QFileDialog::getExistingDirectory(this, tr("Export page images"), mLastOpenPath);
+
+    if (dir.isEmpty())
+        return;
+
+    // Take over the changes of the page currently edited
+    if (TWorkSpaceHandler::Current().isChanged())
+    {
+        Page::PAGE_t *pg = TWorkSpaceHandler::Current().getActualPage();
+
+        if (pg)
+            TPageHandler::Current().setPage(*pg);
+    }
+
+    QList<int> pages = TPageHandler::Current().getPageNumbers();
+    QProgressDialog progress(tr("Exporting page images ..."), tr("Cancel"), 0, static_cast<int>(pages.size()), this);
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setMinimumDuration(500);
+
+    TPageExporter exporter(dir);
+    exporter.regProgress([&progress](int done, int total)
+    {
+        progress.setMaximum(total);
+        progress.setValue(done);
+        return !progress.wasCanceled();
+    });
+
+    if (!exporter.exportPages(pages) && !progress.wasCanceled())
+        QMessageBox::warning(this, tr("Export page images"), tr("%1 page(s) couldn't be exported!").arg(exporter.getErrors()));
+}
+
+/**
+ * @brief TSurface::exportPageImages
+ * Opens a project and exports all its pages as PNG files without showing
+ * any window. This is used for unattended runs from the command line.
+ * The temporary files of the project are removed afterwards.
+ *
+ * @param file  The project file.
+ * @param dir   The directory the images are written to.
+ * @return TRUE if all pages were exported.
+ */
+bool TSurface::exportPageImages(const QString& file, const QString& dir)
+{
+    DECL_TRACER("TSurface::exportPageImages(const QString& file, const QString& dir)");
+
+    mBatch = true;
+
+    if (!openProject(file))
+    {
+        discardProject();           // Removes the files already extracted
+        return false;
+    }
+
+    TPageExporter exporter(dir);
+    bool ret = exporter.exportAll();
+    discardProject();
+    return ret;
+}
+
+/**
+ * @brief TSurface::checkRendering
+ * Opens a project and compares the drawn states of all its objects with
+ * the reference images in @b dir. This is used from the command line to
+ * find changes in the drawing code.
+ *
+ * @param file      The project file.
+ * @param dir       The directory containing the reference images.
+ * @param output    The directory the report and the diff images are
+ * written to.
+ * @param tolerance The maximum difference of a color channel.
+ * @param update    TRUE = The references are written new.
+ * @return TRUE if all images are equal to their references.
+ */
+bool TSurface::checkRendering(const QString& file, const QString& dir, const QString& output, int tolerance, bool update)
+{
+    DECL_TRACER("TSurface::checkRendering(const QString& file, const QString& dir, const QString& output, int tolerance, bool update)");
+
+    mBatch = true;
+
+    if (!openProject(file))
+    {
+        discardProject();           // Removes the files already extracted
+        return false;
+    }
+
+    TRenderCheck check(dir, output, tolerance);
+    bool ret = check.run(update);
+    discardProject();
+    return ret;
+}
+
+/**
+ * @brief TSurface::discardProject
+ * Removes the open project from memory and deletes its temporary files
+ * without saving anything.
+ */
+void TSurface::discardProject()
+{
+    DECL_TRACER("TSurface::discardProject()");
+
+    TPageHandler::Current().reset();
+    TFonts::reset();
+    std::error_code ec;
+    fs::remove_all(mPathTemporary.toStdString(), ec);
 
+    if (ec)
+        MSG_ERROR("Error removing the temporary files: " << ec.message());
+
+    TConfMain::Current().reset();
+    mHaveProject = false;
+    mIsSaved = false;
 }
 void TSurface::on_actionVerify_Function_Maps_triggered()
 {
@@ -1867,6 +2005,7 @@ void TSurface::onClickedPageTree(const TPageTree::WINTYPE_t wt, int num, const Q
     {
         MSG_DEBUG("Window is not visible. Generating it ...")
         Page::PAGE_t *pg = TPageHandler::Current().getPage(num);                // Get the whole page (structure)
+        TPageHandler::Current().ensureLoaded(pg);
 
         if (!pg)
             return;
@@ -1880,6 +2019,7 @@ void TSurface::onClickedPageTree(const TPageTree::WINTYPE_t wt, int num, const Q
         widget->setStyleSheet("background-color: " + pg->srPage.cf.name() + ";color: " + pg->srPage.ct.name()+ ";");  // Set the background color
         QString objName(QString("Canvas_%1").arg(pg->pageID));                  // Create a name for the object
         widget->setObjectName(objName);                                         // set the object name
+        widget->setPageID(pg->pageID);                                          // The page the canvas belongs to
         widget->installEventFilter(mCloseEater);                                // Set an event filter to cache the click on the close button
         MSG_DEBUG("Object name: " << objName.toStdString());
         pg->baseObject.widget = widget;                                         // Add the widget to our local copy of the page structure
@@ -2218,6 +2358,7 @@ void TSurface::onSubWindowActivated(QMdiSubWindow *window)
         return;
 
     Page::PAGE_t *page = TPageHandler::Current().getPage(id);
+    TPageHandler::Current().ensureLoaded(page);
 
     if (!page || page->pageID <= 0)
         return;
@@ -2314,8 +2455,17 @@ void TSurface::onRedrawRequest(Page::PAGE_t *page)
 
     // Draw all the objects on the page
     // --------------------------------
+    // If deferred rendering is enabled, the objects are drawn by the render
+    // queue and the window stays responsive while the images are loaded.
+    bool deferred = TConfig::Current().getDeferredRendering();
+
     for (int idx = 0; idx < page->objects.size(); ++idx)
-        drawObject(page, idx);
+    {
+        if (deferred)
+            queueObject(page, idx);
+        else
+            drawObject(page, idx);
+    }
     // Restore selection
     if (objId > 0)
     {
@@ -2326,11 +2476,42 @@ void TSurface::onRedrawRequest(Page::PAGE_t *page)
     }
 }
 
+/**
+ * @brief TSurface::onDrawQueuedObject
+ * Callback of the render queue. It draws the object as soon as its images
+ * are loaded. The page may be closed in the meantime, so everything is
+ * looked up again.
+ *
+ * @param pageID    The ID of the page or popup.
+ * @param bi        The button index of the object.
+ * @param instance  The instance to draw.
+ */
+void TSurface::onDrawQueuedObject(int pageID, int bi, int instance)
+{
+    DECL_TRACER("TSurface::onDrawQueuedObject(int pageID, int bi, int instance)");
+
+    Page::PAGE_t *page = TPageHandler::Current().getPage(pageID);
+    TPageHandler::Current().ensureLoaded(page);
+
+    if (!page || !page->baseObject.widget)
+        return;
+
+    for (int idx = 0; idx < page->objects.size(); ++idx)
+    {
+        if (page->objects[idx]->getButtonIndex() == bi)
+        {
+            drawObject(page, idx, instance);
+            break;
+        }
+    }
+}
+
 void TSurface::onRedrawObject(const ObjHandler::TOBJECT_t& object, int pageID, int instance)
 {
     DECL_TRACER("TSurface::onRedrawObject(const ObjHandler::TOBJECT_t& object, int pageID, int instance)");
 
     Page::PAGE_t *page = TPageHandler::Current().getPage(pageID);
+    TPageHandler::Current().ensureLoaded(page);
 
     if (!page)
     {
@@ -2587,6 +2768,7 @@ void TSurface::initMenuHaveProject()
     m_ui->actionEdit_Sub_Page_Sets->setEnabled(true);
     // m_ui->actionEdit_Drop_Target_Groups->setEnabled(true);
     m_ui->actionResource_Manager->setEnabled(true);
+    m_ui->actionExport_Page_Images->setEnabled(true);
     // Menu: Page
     m_ui->actionShow_Popup_Page->setEnabled(true);
     m_ui->actionHide_Popup_Page->setEnabled(true);
@@ -2653,7 +2835,9 @@ QString TSurface::createTemporaryPath(const QString& name)
         temp.append(".tsf");
 
     MSG_PROTOCOL("Using temporary path: " << temp.toStdString());
-
+    // The images are cached by their path, which is the same if a project
+    // is opened again.
+    TImageCache::Current().clear();
     return temp;
 }
 
@@ -2746,10 +2930,12 @@ bool TSurface::saveAs()
 
     TConfig::Current().setLastDirectory(mLastOpenPath);
     TConfMain::Current().setPathTemporary(mPathTemporary);
-    TConfMain::Current().saveProject();
+    // The pages are written first, so the project names their files.
     TPageHandler::Current().setPathTemporary(mPathTemporary);
     TPageHandler::Current().saveAllPages();
+    TConfMain::Current().saveProject();
     TFonts::writeFontFile(mPathTemporary, "fonts_.json");
+    TThumbnailCache::Current().flush();                 // The thumbnails are part of the project
     TSurfaceWriter prjSave(mPathTemporary, file);
 
     if (prjSave.haveError())
@@ -2771,10 +2957,12 @@ bool TSurface::saveNormal()
         return true;
 
     QString file = TConfMain::Current().getFileName();
-    TConfMain::Current().saveProject();
+    // The pages are written first, so the project names their files.
     TPageHandler::Current().setPathTemporary(mPathTemporary);
     TPageHandler::Current().saveAllPages();
+    TConfMain::Current().saveProject();
     TFonts::writeFontFile(mPathTemporary, "fonts_.json");
+    TThumbnailCache::Current().flush();                 // The thumbnails are part of the project
     TSurfaceWriter prjSave(mPathTemporary, file);
 
     if (prjSave.haveError())
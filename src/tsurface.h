@@ -51,6 +51,9 @@ class TSurface : public QMainWindow
         explicit TSurface(QWidget *parent = nullptr);
         ~TSurface() override;
 
+        bool exportPageImages(const QString& file, const QString& dir);
+        bool checkRendering(const QString& file, const QString& dir, const QString& output, int tolerance=0, bool update=false);
+
     protected:
         void resizeEvent(QResizeEvent *event) override;
         void closeEvent(QCloseEvent *event) override;
@@ -60,8 +63,9 @@ class TSurface : public QMainWindow
         void applyGridToChildren(TCanvasWidget *widget);
         void addObject(int id, QPoint pt);
         void drawObject(Page::PAGE_t *page, int objIndex, int instance=0);
+        void queueObject(Page::PAGE_t *page, int objIndex, int instance=0);
         TResizableWidget *initObject(Page::PAGE_t *page, int objIndex, int instance=0);
-        int getNextObjectNumber(QList<ObjHandler::TOBJECT_t>& objects);
+        int getNextObjectNumber(int pageID);
 
         void onClickedPageTree(const TPageTree::WINTYPE_t wt, int num, const QString& name);
         void onAddNewPage();
@@ -79,6 +83,7 @@ class TSurface : public QMainWindow
         TOOL onGetCurrentTool() { return mSelectedTool; };
         void onRedrawRequest(Page::PAGE_t *page);
         void onRedrawObject(const ObjHandler::TOBJECT_t& object, int pageID, int instance=0);
+        void onDrawQueuedObject(int pageID, int bi, int instance);
         // Splitter
         void onSplitterMoved(int pos, int index);
 
@@ -255,6 +260,9 @@ class TSurface : public QMainWindow
     private:
         void initMenu();
         void initMenuHaveProject();
+        bool openProject(const QString& file);
+        void showError(const QString& title, const QString& text);
+        void discardProject();
         QString createTemporaryPath(const QString& name);
         bool createNewFileStructure();
         bool saveAs();
@@ -273,6 +281,7 @@ class TSurface : public QMainWindow
         bool mHaveProject{false};
         bool mIsSaved{false};
         bool mFromExtern{false};
+        bool mBatch{false};                         // TRUE = Running from the command line without a window
         winCloseEater *mCloseEater{nullptr};
         QAction *mActionStateManager{nullptr};
         QAction *mActionPlay{nullptr};
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <QPainter>
+
+#include "ttextrenderer.h"
+#include "tpixelkernels.h"
+#include "tgraphics.h"
+#include "tconfig.h"
+#include "terror.h"
+
+TTextRenderer::TTextRenderer()
+    : mCache("Text cache", "texts", TConfig::Current().getTextCacheSize())
+{
+    DECL_TRACER("TTextRenderer::TTextRenderer()");
+}
+
+TTextRenderer& TTextRenderer::Current()
+{
+//    DECL_TRACER("TTextRenderer::Current()");
+
+    static TTextRenderer *renderer = new TTextRenderer;
+    return *renderer;
+}
+
+/**
+ * @brief TTextRenderer::render
+ * Returns an image with the text and its effect. If the same text was
+ * drawn before with the same parameters, the image is taken from the
+ * cache.
+ *
+ * @param text          The text to draw.
+ * @param font          The font to use.
+ * @param size          The size of the image. The text is aligned inside.
+ * @param align         The alignment of the text (Qt::Alignment).
+ * @param color         The color of the text.
+ * @param effectColor   The color of the effect.
+ * @param effect        The text effect (TEXT_EFFECT). 0 is no effect.
+ * @return The image in the format QImage::Format_ARGB32_Premultiplied.
+ */
+QImage TTextRenderer::render(const QString& text, const QFont& font, const QSize& size, int align, const QColor& color, const QColor& effectColor, int effect)
+{
+    DECL_TRACER("TTextRenderer::render(const QString& text, const QFont& font, const QSize& size, int align, const QColor& color, const QColor& effectColor, int effect)");
+
+    if (text.isEmpty() || size.width() <= 0 || size.height() <= 0)
+        return QImage();
+
+    QString key = QString("%1|%2|%3x%4|%5|%6|%7|%8").arg(text).arg(font.key()).arg(size.width()).arg(size.height()).arg(align)
+                                                    .arg(color.rgba(), 8, 16, QChar('0')).arg(effectColor.rgba(), 8, 16, QChar('0')).arg(effect);
+
+    QImage image;
+
+    if (mCache.get(key, &image))
+        return image;
+
+    image = draw(text, font, size, align, color, effectColor, effect);
+    mCache.insert(key, image, image.sizeInBytes());
+    return image;
+}
+
+/**
+ * @brief TTextRenderer::draw
+ * Draws the text with its effect. The meaning of the effect numbers is:
+ *      Outline: 1 - 4
+ *      Glow: 5 - 8
+ *      Soft Drop Shadow: 9 - 16
+ *      Medium Drop Shadow: 17 - 24
+ *      Hard Drop Shadow: 25 - 32
+ *      Soft Drop Shadow with outline: 33 - 40
+ *      Medium Drop Shadow with Outline: 41 - 48
+ *      Hard Drop Shadow with Outline: 49 - 56
+ *
+ * The outline is the text drawn several times with a small offset in the
+ * effect color. A glow or a shadow is the alpha channel of the text,
+ * blurred, colored with the effect color and drawn under the text.
+ */
+QImage TTextRenderer::draw(const QString& text, const QFont& font, const QSize& size, int align, const QColor& color, const QColor& effectColor, int effect)
+{
+    DECL_TRACER("TTextRenderer::draw(const QString& text, const QFont& font, const QSize& size, int align, const QColor& color, const QColor& effectColor, int effect)");
+
+    QImage layer(size, QImage::Format_ARGB32_Premultiplied);
+    layer.fill(Qt::transparent);
+    QPainter p(&layer);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setRenderHint(QPainter::TextAntialiasing);
+    p.setFont(font);
+
+    if ((effect >= 1 && effect <= 4) || (effect >= 33 && effect <= 56))     // Outline
+    {
+        Graphics::EFFECT_STYLE_t style = TGraphics::Current().getEffectDetails(effect);
+        p.setPen(effectColor);
+
+        for (int dx = ((style.width / 2) * -1); dx <= (style.width / 2); ++dx)
+        {
+            for (int dy = ((style.height / 2) * -1); dy <= (style.height / 2); ++dy)
+            {
+                if (dx == 0 && dy == 0)
+                    continue;
+
+                p.drawText(layer.rect().translated(dx, dy), align, text);
+            }
+        }
+    }
+
+    p.setPen(color);
+    p.drawText(layer.rect(), align, text);
+    p.end();
+
+    if (effect < 5 || effect > 56)
+        return layer;
+
+    // Glow and shadow
+    QImage alpha = layer.convertToFormat(QImage::Format_Alpha8);
+    int radius = TPixelKernels::boxRadius(getBlurRadius(effect));
+
+    if (radius > 0)
+        TPixelKernels::blurAlpha(&alpha, radius);
+
+    QImage shadow(size, QImage::Format_ARGB32_Premultiplied);
+    shadow.fill(effectColor);
+    QPainter ps(&shadow);
+    ps.setCompositionMode(QPainter::CompositionMode_DestinationIn);
+    ps.drawImage(0, 0, alpha);
+    ps.end();
+
+    int offset = getShadowOffset(effect);
+    QImage result(size, QImage::Format_ARGB32_Premultiplied);
+    result.fill(Qt::transparent);
+    QPainter pr(&result);
+    pr.drawImage(offset, offset, shadow);
+    pr.drawImage(0, 0, layer);
+    pr.end();
+    return result;
+}
+
+/**
+ * @brief TTextRenderer::getShadowOffset
+ * Returns the offset of a drop shadow in pixels. Every kind of shadow has
+ * 8 steps where the step is the offset. A glow has no offset.
+ */
+int TTextRenderer::getShadowOffset(int effect)
+{
+    DECL_TRACER("TTextRenderer::getShadowOffset(int effect)");
+
+    if (effect < 9 || effect > 56)
+        return 0;
+
+    return ((effect - 1) % 8) + 1;
+}
+
+/**
+ * @brief TTextRenderer::getBlurRadius
+ * Returns the blur radius a QGraphicsDropShadowEffect was used with
+ * before. TPixelKernels::boxRadius() converts it to the radius of the box
+ * blur.
+ */
+int TTextRenderer::getBlurRadius(int effect)
+{
+    DECL_TRACER("TTextRenderer::getBlurRadius(int effect)");
+
+    int blur = 0;
+
+    switch(effect)
+    {
+        case 5: blur = 4; break;     // Glow-S
+        case 6: blur = 8; break;     // Glow-M
+        case 7: blur = 12; break;    // Glow-L
+        case 8: blur = 16; break;    // Glow-X
+
+        default:
+            if ((effect >= 9 && effect <= 16) || (effect >= 33 && effect <= 40))         // Soft
+                blur = 15;
+            else if ((effect >= 17 && effect <= 24) || (effect >= 41 && effect <= 48))   // Medium
+                blur = 8;
+    }
+
+    return blur;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TTEXTRENDERER_H
+#define TTEXTRENDERER_H
+
+#include <QImage>
+#include <QString>
+#include <QColor>
+#include <QFont>
+#include <QSize>
+
+#include "tcostcache.h"
+
+/**
+ * @brief The TTextRenderer class
+ * Draws a text together with its text effect (outline, glow or drop
+ * shadow) into an image. The effects are rasterized here instead of using
+ * a QGraphicsDropShadowEffect, which blurs the text again on every paint.
+ * The blur is a separable box blur from TPixelKernels, applied three
+ * times to approximate the blur of QGraphicsDropShadowEffect. The test
+ * tst_textshadow compares both.
+ *
+ * The finished images are kept in a cache. The key consists of the text,
+ * the font, the size, the alignment, both colors and the effect. As long
+ * as none of them changes, drawing the text is only a blit.
+ */
+class TTextRenderer
+{
+    public:
+        static TTextRenderer& Current();
+
+        QImage render(const QString& text, const QFont& font, const QSize& size, int align, const QColor& color, const QColor& effectColor, int effect);
+        void setBudget(qsizetype mib) { mCache.setBudget(mib); }
+        void clear() { mCache.clear(); }
+
+        qsizetype getHits() const { return mCache.getHits(); }
+        qsizetype getMisses() const { return mCache.getMisses(); }
+        void logStatistics() { mCache.logStatistics(); }
+
+    private:
+        TTextRenderer();
+
+        QImage draw(const QString& text, const QFont& font, const QSize& size, int align, const QColor& color, const QColor& effectColor, int effect);
+        static int getShadowOffset(int effect);
+        static int getBlurRadius(int effect);
+
+        TCostCache<QImage> mCache;
+};
+
+#endif // TTEXTRENDERER_H
@@ -0,0 +1,288 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <QDir>
+#include <QFile>
+#include <QImageReader>
+#include <QRunnable>
+#include <QTimer>
+
+#include "tthumbnailcache.h"
+#include "tpagerenderer.h"
+#include "tconfmain.h"
+#include "terror.h"
+
+#define THUMB_SIZE      256     // The maximum width or height of a thumbnail
+
+TThumbnailCache *TThumbnailCache::mCurrent{nullptr};
+
+TThumbnailCache::TThumbnailCache()
+{
+    DECL_TRACER("TThumbnailCache::TThumbnailCache()");
+
+    // Writing PNG files is mostly I/O; two threads are enough and leave the
+    // global pool to the render queue.
+    mPool.setMaxThreadCount(2);
+}
+
+TThumbnailCache& TThumbnailCache::Current()
+{
+//    DECL_TRACER("TThumbnailCache::Current()");
+
+    if (!mCurrent)
+        mCurrent = new TThumbnailCache;
+
+    return *mCurrent;
+}
+
+/**
+ * @brief TThumbnailCache::getThumbnail
+ * Returns the thumbnail of a page. If it is not in memory, it is loaded
+ * from the project directory. The method never draws a page.
+ *
+ * @param pageID    The ID of the page or popup.
+ * @return The thumbnail or a null image if there is none yet.
+ */
+QImage TThumbnailCache::getThumbnail(int pageID)
+{
+    DECL_TRACER("TThumbnailCache::getThumbnail(int pageID)");
+
+    QHash<int, QImage>::ConstIterator iter = mThumbnails.constFind(pageID);
+
+    if (iter != mThumbnails.constEnd())
+        return iter.value();
+
+    QString file = getFileName(pageID);
+
+    if (!QFile::exists(file))
+        return QImage();
+
+    QImage img;
+
+    if (!img.load(file))
+    {
+        MSG_WARNING("Couldn't load thumbnail " << file.toStdString());
+        return QImage();
+    }
+
+    mThumbnails.insert(pageID, img);
+    return img;
+}
+
+/**
+ * @brief TThumbnailCache::request
+ * Queues a page for a new thumbnail. The signal thumbnailChanged() is
+ * emitted as soon as the thumbnail is available.
+ *
+ * @param pageID    The ID of the page or popup.
+ */
+void TThumbnailCache::request(int pageID)
+{
+    DECL_TRACER("TThumbnailCache::request(int pageID)");
+
+    if (!mQueue.contains(pageID))
+        mQueue.append(pageID);
+
+    scheduleProcessing();
+}
+
+/**
+ * @brief TThumbnailCache::update
+ * Called whenever a page was saved. The thumbnail is created again only
+ * if the content of the page changed since the thumbnail was made or if
+ * there is no thumbnail at all.
+ *
+ * @param pageID    The ID of the page or popup.
+ * @param signature The MD5 hash of the saved content of the page in hex.
+ */
+void TThumbnailCache::update(int pageID, const QByteArray& signature)
+{
+    DECL_TRACER("TThumbnailCache::update(int pageID, const QByteArray& signature)");
+
+    if (!mSignatures.contains(pageID))
+        mSignatures.insert(pageID, readSignature(pageID));
+
+    if (mSignatures.value(pageID) == signature && QFile::exists(getFileName(pageID)))
+        return;
+
+    mSignatures.insert(pageID, signature);
+    request(pageID);
+}
+
+/**
+ * @brief TThumbnailCache::remove
+ * Removes the thumbnail of a deleted page or popup from memory and from
+ * the project. A thumbnail of this page still in work is dropped.
+ *
+ * @param pageID    The ID of the page or popup.
+ */
+void TThumbnailCache::remove(int pageID)
+{
+    DECL_TRACER("TThumbnailCache::remove(int pageID)");
+
+    mQueue.removeAll(pageID);
+    mThumbnails.remove(pageID);
+    mSignatures.remove(pageID);
+    // A thumbnail still being written would create the file again.
+    mPool.waitForDone();
+    QFile::remove(getFileName(pageID));
+    mPageGeneration[pageID]++;
+}
+
+/**
+ * @brief TThumbnailCache::flush
+ * Creates all pending thumbnails immediately and waits until they are
+ * written. This must be called before the project is archived.
+ */
+void TThumbnailCache::flush()
+{
+    DECL_TRACER("TThumbnailCache::flush()");
+
+    while (!mQueue.isEmpty())
+        renderThumbnail(mQueue.takeFirst());
+
+    mPool.waitForDone();
+}
+
+void TThumbnailCache::clear()
+{
+    DECL_TRACER("TThumbnailCache::clear()");
+
+    mPool.waitForDone();
+    // The results of the threads are already queued. They belong to the
+    // previous project and must not be inserted.
+    mGeneration++;
+    mQueue.clear();
+    mThumbnails.clear();
+    mSignatures.clear();
+    mPageGeneration.clear();
+}
+
+/**
+ * @brief TThumbnailCache::processQueue
+ * Creates the thumbnail of one page and returns to the event loop, so the
+ * GUI keeps responding while many pages are waiting.
+ */
+void TThumbnailCache::processQueue()
+{
+    DECL_TRACER("TThumbnailCache::processQueue()");
+
+    mScheduled = false;
+
+    if (mQueue.isEmpty())
+        return;
+
+    renderThumbnail(mQueue.takeFirst());
+
+    if (!mQueue.isEmpty())
+        scheduleProcessing();
+}
+
+QString TThumbnailCache::getFileName(int pageID)
+{
+    DECL_TRACER("TThumbnailCache::getFileName(int pageID)");
+
+    return TConfMain::Current().getPathTemporary() + QString("/thumbnails/%1.png").arg(pageID);
+}
+
+/**
+ * @brief TThumbnailCache::readSignature
+ * Reads the signature of the content a thumbnail was made of. Only the
+ * header of the PNG file is read.
+ *
+ * @param pageID    The ID of the page or popup.
+ * @return The signature or an empty array if there is no thumbnail.
+ */
+QByteArray TThumbnailCache::readSignature(int pageID)
+{
+    DECL_TRACER("TThumbnailCache::readSignature(int pageID)");
+
+    QImageReader reader(getFileName(pageID));
+
+    if (!reader.canRead())
+        return QByteArray();
+
+    return reader.text("Signature").toLatin1();
+}
+
+/**
+ * @brief TThumbnailCache::renderThumbnail
+ * Composes the page on the GUI thread. Scaling the image and writing the
+ * file is done by the thread pool. When the file is written, the new
+ * thumbnail is put into memory and thumbnailChanged() is emitted.
+ *
+ * @param pageID    The ID of the page or popup.
+ */
+void TThumbnailCache::renderThumbnail(int pageID)
+{
+    DECL_TRACER("TThumbnailCache::renderThumbnail(int pageID)");
+
+    QImage img = TPageRenderer::renderPage(pageID);
+
+    if (img.isNull())
+    {
+        MSG_WARNING("Couldn't render page " << pageID << " for a thumbnail!");
+        return;
+    }
+
+    QString file = getFileName(pageID);
+    QDir dir(TConfMain::Current().getPathTemporary());
+
+    if (!dir.exists("thumbnails") && !dir.mkpath("thumbnails"))
+    {
+        MSG_ERROR("Couldn't create the directory for thumbnails in " << dir.path().toStdString());
+        return;
+    }
+
+    QByteArray signature = mSignatures.value(pageID);
+    quint64 generation = mGeneration;
+    quint64 pageGeneration = mPageGeneration.value(pageID, 0);
+
+    mPool.start(QRunnable::create([this, pageID, img, file, signature, generation, pageGeneration]()
+    {
+        QImage thumb = img.scaled(THUMB_SIZE, THUMB_SIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        thumb.setText("Signature", QString::fromLatin1(signature));
+
+        if (!thumb.save(file, "PNG"))
+        {
+            MSG_ERROR("Couldn't write thumbnail " << file.toStdString());
+            return;
+        }
+
+        QMetaObject::invokeMethod(this, [this, pageID, thumb, generation, pageGeneration]()
+        {
+            // Dropped if the cache was cleared or the page was removed
+            // after the thumbnail was started.
+            if (generation != mGeneration || pageGeneration != mPageGeneration.value(pageID, 0))
+                return;
+
+            mThumbnails.insert(pageID, thumb);
+            emit thumbnailChanged(pageID);
+        }, Qt::QueuedConnection);
+    }));
+}
+
+void TThumbnailCache::scheduleProcessing()
+{
+    DECL_TRACER("TThumbnailCache::scheduleProcessing()");
+
+    if (mScheduled)
+        return;
+
+    mScheduled = true;
+    QTimer::singleShot(0, this, &TThumbnailCache::processQueue);
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TTHUMBNAILCACHE_H
+#define TTHUMBNAILCACHE_H
+
+#include <QObject>
+#include <QHash>
+#include <QByteArray>
+#include <QList>
+#include <QImage>
+#include <QThreadPool>
+
+/**
+ * @brief The TThumbnailCache class
+ * Keeps a small image of every page and popup. The thumbnails are stored
+ * as PNG files in the directory "thumbnails" of the project. Therefore
+ * they are saved together with the project and are available as soon as
+ * a project is opened, without drawing any page.
+ *
+ * A thumbnail is created again only if its page was saved with a changed
+ * content. The signature of the content is an MD5 hash stored in the PNG
+ * file. It doesn't depend on the process, so an unchanged page keeps its
+ * thumbnail when the project is opened again. The page is composed by
+ * TPageRenderer on the GUI thread, one page per pass of the event loop.
+ * Scaling and writing the PNG file is done on a worker thread.
+ */
+class TThumbnailCache : public QObject
+{
+    Q_OBJECT
+
+    public:
+        static TThumbnailCache& Current();
+
+        QImage getThumbnail(int pageID);
+        void request(int pageID);
+        void update(int pageID, const QByteArray& signature);
+        void remove(int pageID);
+        void flush();
+        void clear();
+
+    signals:
+        void thumbnailChanged(int pageID);
+
+    private slots:
+        void processQueue();
+
+    private:
+        TThumbnailCache();
+
+        QString getFileName(int pageID);
+        QByteArray readSignature(int pageID);
+        void renderThumbnail(int pageID);
+        void scheduleProcessing();
+
+        static TThumbnailCache *mCurrent;
+        QHash<int, QImage> mThumbnails;     // The thumbnails already loaded; Key is the page ID
+        QHash<int, QByteArray> mSignatures; // The signature of the content of each page the thumbnail was made of
+        QList<int> mQueue;                  // The pages waiting for a new thumbnail
+        QThreadPool mPool;                  // Scales and writes the thumbnails
+        bool mScheduled{false};             // TRUE = processQueue() is already queued
+        quint64 mGeneration{0};             // Incremented by clear(); results of an older generation are dropped
+        QHash<int, quint64> mPageGeneration; // Incremented by remove() for a single page
+};
+
+#endif // TTHUMBNAILCACHE_H
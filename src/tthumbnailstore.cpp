@@ -0,0 +1,689 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QBuffer>
+#include <QDataStream>
+#include <QImageReader>
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QMutexLocker>
+#include <QtEndian>
+
+#include <cstring>
+
+#include "tthumbnailstore.h"
+#include "terror.h"
+
+#define STORE_MAGIC         "TSTHUMBS"
+#define STORE_VERSION       2
+#define STORE_MAX_SIZE      (256 * 1024 * 1024)     // Maximum size of the container file in bytes
+#define RECORD_MAGIC        0x5453544eu             // Start of each record of a thumbnail
+#define FILE_MAGIC          0x54534846u             // Start of each record of a file hash
+#define RECORD_HEADER       34                      // Magic, key, width, height and length of a thumbnail
+#define MAX_BUCKET          256                     // Larger sizes are not stored
+#define COMPACT_RATIO       10                      // Compacted if at least 1/10 of the records are dead
+
+TThumbnailStore::TThumbnailStore()
+    : mFileName(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/thumbnails.store"),
+      mLock(mFileName + ".lock")
+{
+    DECL_TRACER("TThumbnailStore::TThumbnailStore()");
+
+    // The lock is held as long as the program runs. Only a lock of a
+    // process which doesn't exist any more is stale.
+    mLock.setStaleLockTime(0);
+}
+
+TThumbnailStore::~TThumbnailStore()
+{
+    DECL_TRACER("TThumbnailStore::~TThumbnailStore()");
+
+    if (mFile.isOpen())
+        mFile.close();
+
+    if (mLock.isLocked())
+        mLock.unlock();
+}
+
+TThumbnailStore& TThumbnailStore::Current()
+{
+//    DECL_TRACER("TThumbnailStore::Current()");
+
+    // The store is used by worker threads too. The initialization of a
+    // static local variable is thread safe.
+    static TThumbnailStore store;
+    return store;
+}
+
+/**
+ * @brief TThumbnailStore::getImage
+ * Returns an image file scaled to fit into @b size. If the thumbnail is in
+ * the store, the file is not decoded. Otherwise the file is decoded once
+ * and the thumbnail is added to the store.
+ *
+ * @param file  The path and name of the image file.
+ * @param size  The size the image must fit in.
+ * @param ori   Optional: A pointer receiving the original size of the
+ * image.
+ * @return The image. If the file is not a valid image, a null image is
+ * returned.
+ */
+QImage TThumbnailStore::getImage(const QString& file, const QSize& size, QSize *ori)
+{
+    DECL_TRACER("TThumbnailStore::getImage(const QString& file, const QSize& size, QSize *ori)");
+
+    if (ori)
+        *ori = QSize(0, 0);
+
+    QFileInfo info(file);
+
+    if (!info.exists() || size.isEmpty())
+        return QImage();
+
+    int bucket = getBucket(size);
+    // The hash of a file is calculated only once, as long as the file
+    // doesn't change. The hashes are kept in the store.
+    QString fileKey = QString("%1|%2|%3").arg(info.absoluteFilePath()).arg(info.size()).arg(info.lastModified().toMSecsSinceEpoch());
+    QByteArray data;
+    QByteArray hash;
+    QSize original;
+    bool knownFile = false;
+
+    {
+        QMutexLocker locker(&mMutex);
+        open();
+        QHash<QString, HASH_t>::ConstIterator iter = mHashes.constFind(fileKey);
+
+        if (iter != mHashes.constEnd())
+        {
+            hash = iter->hash;
+            original = iter->original;
+            knownFile = true;
+        }
+    }
+
+    if (hash.isEmpty())
+    {
+        QFile f(file);
+
+        if (!f.open(QIODevice::ReadOnly))
+        {
+            MSG_ERROR("Couldn't open image " << file.toStdString() << ": " << f.errorString().toStdString());
+            return QImage();
+        }
+
+        data = f.readAll();
+        f.close();
+        hash = QCryptographicHash::hash(data, QCryptographicHash::Md5);
+    }
+
+    QByteArray key = hash;
+    key.append(static_cast<char>(bucket >> 8));
+    key.append(static_cast<char>(bucket & 0xff));
+    QImage image;
+
+    if (bucket <= MAX_BUCKET)
+    {
+        QByteArray png;
+
+        {
+            QMutexLocker locker(&mMutex);
+
+            if (readRecord(key, &png, &original))
+                mHits++;
+            else
+                mMisses++;
+        }
+
+        if (!png.isEmpty() && !image.loadFromData(png, "PNG"))
+            MSG_WARNING("Couldn't decode a thumbnail of the store.");
+    }
+
+    if (image.isNull())
+    {
+        if (data.isEmpty())
+        {
+            QFile f(file);
+
+            if (!f.open(QIODevice::ReadOnly))
+                return QImage();
+
+            data = f.readAll();
+            f.close();
+        }
+
+        // Decoding is done without the lock, so other threads are not blocked.
+        QBuffer buffer(&data);
+        QImageReader reader(&buffer);
+        image = reader.read();
+
+        if (image.isNull())
+        {
+            MSG_WARNING("Couldn't decode image " << file.toStdString() << ": " << reader.errorString().toStdString());
+            return QImage();
+        }
+
+        original = image.size();
+
+        if (bucket <= MAX_BUCKET)
+        {
+            if (image.width() > bucket || image.height() > bucket)
+                image = image.scaled(bucket, bucket, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+            QMutexLocker locker(&mMutex);
+            writeRecord(key, image, original);
+        }
+    }
+
+    if (!knownFile)
+    {
+        QMutexLocker locker(&mMutex);
+        HASH_t entry{ hash, original };
+        // Writing may start the store anew, which empties the list.
+        writeFileRecord(fileKey, entry);
+        mHashes.insert(fileKey, entry);
+    }
+
+    if (ori)
+        *ori = original;
+
+    if (image.size() != image.size().scaled(size, Qt::KeepAspectRatio))
+        image = image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    return image;
+}
+
+/**
+ * @brief TThumbnailStore::clear
+ * Removes all thumbnails and starts with an empty container file.
+ */
+void TThumbnailStore::clear()
+{
+    DECL_TRACER("TThumbnailStore::clear()");
+
+    QMutexLocker locker(&mMutex);
+    mHashes.clear();
+    mHits = 0;
+    mMisses = 0;
+
+    if (mOpened && mFile.isOpen() && !mReadOnly)
+        reset();
+}
+
+void TThumbnailStore::logStatistics()
+{
+    DECL_TRACER("TThumbnailStore::logStatistics()");
+
+    QMutexLocker locker(&mMutex);
+    MSG_INFO("Thumbnail store: " << mIndex.size() << " thumbnails, " << mHashes.size() << " files, " << (mFile.isOpen() ? mFile.size() / 1024 : 0) << " KiB, " << mHits << " hits, " << mMisses << " misses" << (mReadOnly ? " (read only)" : ""));
+}
+
+/**
+ * @brief TThumbnailStore::open
+ * Opens the container file and reads the index. This is done at the first
+ * access. If the file can't be opened, the thumbnails are not stored. If
+ * another instance of the program has locked the file, it is opened read
+ * only. The mutex must be locked.
+ *
+ * @return TRUE if the container file is open.
+ */
+bool TThumbnailStore::open()
+{
+    DECL_TRACER("TThumbnailStore::open()");
+
+    if (mOpened)
+        return mFile.isOpen();
+
+    mOpened = true;
+    QDir dir(QFileInfo(mFileName).absolutePath());
+
+    if (!dir.exists() && !dir.mkpath("."))
+    {
+        MSG_WARNING("Couldn't create the directory " << dir.absolutePath().toStdString() << ". Thumbnails are not stored.");
+        return false;
+    }
+
+    mFile.setFileName(mFileName);
+
+    if (!mLock.tryLock(0))
+    {
+        if (mLock.error() != QLockFile::LockFailedError || !mFile.exists())
+        {
+            MSG_WARNING("Couldn't lock " << mFileName.toStdString() << ". Thumbnails are not stored.");
+            return false;
+        }
+
+        MSG_INFO("The thumbnail store is used by another instance. It is opened read only.");
+        mReadOnly = true;
+    }
+
+    if (!mFile.open(mReadOnly ? QIODevice::ReadOnly : QIODevice::ReadWrite))
+    {
+        MSG_WARNING("Couldn't open " << mFileName.toStdString() << ": " << mFile.errorString().toStdString() << ". Thumbnails are not stored.");
+        return false;
+    }
+
+    if (mFile.size() > STORE_MAX_SIZE || !readIndex())
+    {
+        if (!mReadOnly)
+            return reset();
+
+        mIndex.clear();
+        mHashes.clear();
+        mFile.close();
+        return false;
+    }
+
+    if (!mReadOnly && !compact())
+        return false;
+
+    MSG_INFO("Opened thumbnail store " << mFileName.toStdString() << " with " << mIndex.size() << " thumbnails and " << mHashes.size() << " files.");
+    return true;
+}
+
+/**
+ * @brief TThumbnailStore::readIndex
+ * Reads the headers of all records. The image data is skipped. The hashes
+ * of the files are read completely. A record which is incomplete, e.g.
+ * because the program was killed while writing it, is cut off.
+ *
+ * @return FALSE if the file is not a valid container file.
+ */
+bool TThumbnailStore::readIndex()
+{
+    DECL_TRACER("TThumbnailStore::readIndex()");
+
+    mIndex.clear();
+    mHashes.clear();
+    mFileRecords = 0;
+    mFile.seek(0);
+    QDataStream in(&mFile);
+    char magic[8];
+
+    if (in.readRawData(magic, 8) != 8 || memcmp(magic, STORE_MAGIC, 8) != 0)
+        return false;
+
+    quint32 version = 0;
+    in >> version;
+
+    if (version != STORE_VERSION)
+    {
+        MSG_INFO("Thumbnail store has version " << version << ". It is created anew.");
+        return false;
+    }
+
+    qint64 end = mFile.pos();
+
+    while (!in.atEnd())
+    {
+        quint32 recMagic = 0;
+        QByteArray key(18, 0);
+        qint32 width = 0, height = 0;
+        quint32 length = 0;
+
+        in >> recMagic;
+
+        if (recMagic == FILE_MAGIC)
+        {
+            QString fileKey;
+            HASH_t hash;
+            hash.hash = QByteArray(16, 0);
+            in >> fileKey;
+
+            if (in.status() != QDataStream::Ok || in.readRawData(hash.hash.data(), 16) != 16)
+                break;
+
+            in >> width >> height;
+
+            if (in.status() != QDataStream::Ok)
+                break;
+
+            hash.original = QSize(width, height);
+            mHashes.insert(fileKey, hash);
+            mFileRecords++;
+            end = mFile.pos();
+            continue;
+        }
+
+        if (recMagic != RECORD_MAGIC || in.readRawData(key.data(), 18) != 18)
+            break;
+
+        in >> width >> height >> length;
+
+        if (in.status() != QDataStream::Ok || mFile.pos() + length > mFile.size())
+            break;
+
+        RECORD_t rec;
+        rec.offset = mFile.pos();
+        rec.length = length;
+        rec.original = QSize(width, height);
+        mIndex.insert(key, rec);
+
+        if (!mFile.seek(rec.offset + length))
+            break;
+
+        end = mFile.pos();
+    }
+
+    if (end < mFile.size())
+    {
+        if (mReadOnly)
+            MSG_WARNING("Thumbnail store is damaged at position " << end << ". The rest is ignored.");
+        else
+        {
+            MSG_WARNING("Thumbnail store is damaged at position " << end << ". The rest is removed.");
+            mFile.resize(end);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief TThumbnailStore::compact
+ * Removes the hashes of files which were changed or deleted. Every change
+ * of a file appends a new hash and the files of closed projects are
+ * deleted with their temporary directory. Without this the dead hashes
+ * would fill the container file until it is started anew.
+ * The thumbnails are kept, because the same content may come again with
+ * another file or project.
+ * The container file is only written new if enough records are dead. The
+ * mutex must be locked.
+ *
+ * @return FALSE if the container file couldn't be opened again.
+ */
+bool TThumbnailStore::compact()
+{
+    DECL_TRACER("TThumbnailStore::compact()");
+
+    QHash<QString, HASH_t> live;
+
+    for (QHash<QString, HASH_t>::ConstIterator iter = mHashes.constBegin(); iter != mHashes.constEnd(); ++iter)
+    {
+        if (isLive(iter.key()))
+            live.insert(iter.key(), iter.value());
+    }
+
+    qsizetype dead = mFileRecords - live.size();
+
+    if (dead <= 0 || dead * COMPACT_RATIO < mIndex.size() + mFileRecords)
+        return true;
+
+    MSG_INFO("Removing " << dead << " dead file records from the thumbnail store.");
+    QFile tmp(mFileName + ".new");
+
+    if (!tmp.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        MSG_WARNING("Couldn't compact the thumbnail store: " << tmp.errorString().toStdString());
+        return true;
+    }
+
+    QDataStream out(&tmp);
+    out.writeRawData(STORE_MAGIC, 8);
+    out << static_cast<quint32>(STORE_VERSION);
+
+    for (const RECORD_t& rec : std::as_const(mIndex))
+    {
+        if (!mFile.seek(rec.offset - RECORD_HEADER))
+            continue;
+
+        QByteArray record = mFile.read(RECORD_HEADER + rec.length);
+
+        if (record.size() == static_cast<qsizetype>(RECORD_HEADER + rec.length))
+            out.writeRawData(record.constData(), static_cast<int>(record.size()));
+    }
+
+    for (QHash<QString, HASH_t>::ConstIterator iter = live.constBegin(); iter != live.constEnd(); ++iter)
+    {
+        out << static_cast<quint32>(FILE_MAGIC) << iter.key();
+        out.writeRawData(iter->hash.constData(), 16);
+        out << static_cast<qint32>(iter->original.width()) << static_cast<qint32>(iter->original.height());
+    }
+
+    tmp.close();
+
+    if (out.status() != QDataStream::Ok || tmp.error() != QFileDevice::NoError)
+    {
+        MSG_WARNING("Couldn't compact the thumbnail store: " << tmp.errorString().toStdString());
+        tmp.remove();
+        return true;
+    }
+
+    // The lock is on its own file, so it is held while the file is replaced.
+    mFile.close();
+
+    if (!QFile::remove(mFileName) || !tmp.rename(mFileName))
+        MSG_ERROR("Couldn't replace " << mFileName.toStdString() << " with the compacted thumbnail store!");
+
+    if (!mFile.open(QIODevice::ReadWrite))
+    {
+        MSG_WARNING("Couldn't open " << mFileName.toStdString() << ": " << mFile.errorString().toStdString() << ". Thumbnails are not stored.");
+        mIndex.clear();
+        mHashes.clear();
+        return false;
+    }
+
+    if (!readIndex())
+        return reset();
+
+    return true;
+}
+
+/**
+ * @brief TThumbnailStore::isLive
+ * Tests whether the file of a hash still exists unchanged.
+ *
+ * @param fileKey   The path, size and time of the last change of the file.
+ * @return TRUE if the file exists with this size and time.
+ */
+bool TThumbnailStore::isLive(const QString& fileKey)
+{
+    DECL_TRACER("TThumbnailStore::isLive(const QString& fileKey)");
+
+    qsizetype posTime = fileKey.lastIndexOf('|');
+    qsizetype posSize = posTime > 0 ? fileKey.lastIndexOf('|', posTime - 1) : -1;
+
+    if (posSize <= 0)
+        return false;
+
+    QFileInfo info(fileKey.left(posSize));
+
+    return info.exists() &&
+           info.size() == fileKey.mid(posSize + 1, posTime - posSize - 1).toLongLong() &&
+           info.lastModified().toMSecsSinceEpoch() == fileKey.mid(posTime + 1).toLongLong();
+}
+
+/**
+ * @brief TThumbnailStore::reset
+ * Truncates the container file and writes the header. The mutex must be
+ * locked.
+ *
+ * @return TRUE on success.
+ */
+bool TThumbnailStore::reset()
+{
+    DECL_TRACER("TThumbnailStore::reset()");
+
+    mIndex.clear();
+    mHashes.clear();
+
+    if (mReadOnly)
+        return false;
+
+    if (!mFile.resize(0) || !mFile.seek(0))
+    {
+        MSG_ERROR("Couldn't reset the thumbnail store: " << mFile.errorString().toStdString());
+        mFile.close();
+        return false;
+    }
+
+    QDataStream out(&mFile);
+    out.writeRawData(STORE_MAGIC, 8);
+    out << static_cast<quint32>(STORE_VERSION);
+    mFile.flush();
+    return out.status() == QDataStream::Ok;
+}
+
+/**
+ * @brief TThumbnailStore::readRecord
+ * Reads the PNG data of a thumbnail. The header of the record is read
+ * too and compared with the key. This way a record is not taken if
+ * another instance has started the file anew after the index was read.
+ * The mutex must be locked.
+ *
+ * @param key   The hash and bucket.
+ * @param data  Receives the PNG data of the thumbnail.
+ * @param ori   Receives the size of the original image.
+ * @return TRUE if the thumbnail was found.
+ */
+bool TThumbnailStore::readRecord(const QByteArray& key, QByteArray *data, QSize *ori)
+{
+    DECL_TRACER("TThumbnailStore::readRecord(const QByteArray& key, QByteArray *data, QSize *ori)");
+
+    if (!open())
+        return false;
+
+    QHash<QByteArray, RECORD_t>::ConstIterator iter = mIndex.constFind(key);
+
+    if (iter == mIndex.constEnd() || !mFile.seek(iter->offset - RECORD_HEADER))
+        return false;
+
+    QByteArray record = mFile.read(RECORD_HEADER + iter->length);
+
+    if (record.size() != static_cast<qsizetype>(RECORD_HEADER + iter->length) ||
+        qFromBigEndian<quint32>(record.constData()) != RECORD_MAGIC ||
+        record.mid(4, 18) != key)
+    {
+        MSG_WARNING("Couldn't read a thumbnail from the store.");
+        mIndex.remove(key);
+        return false;
+    }
+
+    *data = record.mid(RECORD_HEADER);
+    *ori = iter->original;
+    return true;
+}
+
+/**
+ * @brief TThumbnailStore::writeRecord
+ * Appends a thumbnail to the container file. The mutex must be locked.
+ *
+ * @param key   The hash and bucket.
+ * @param image The thumbnail.
+ * @param ori   The size of the original image.
+ */
+void TThumbnailStore::writeRecord(const QByteArray& key, const QImage& image, const QSize& ori)
+{
+    DECL_TRACER("TThumbnailStore::writeRecord(const QByteArray& key, const QImage& image, const QSize& ori)");
+
+    if (!open() || mReadOnly || mIndex.contains(key))
+        return;
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+
+    if (!image.save(&buffer, "PNG"))
+        return;
+
+    if (mFile.size() + data.size() > STORE_MAX_SIZE)
+    {
+        MSG_INFO("Thumbnail store is full. It is created anew.");
+
+        if (!reset())
+            return;
+    }
+
+    qint64 start = mFile.size();
+    mFile.seek(start);
+    QDataStream out(&mFile);
+    out << static_cast<quint32>(RECORD_MAGIC);
+    out.writeRawData(key.constData(), 18);
+    out << static_cast<qint32>(ori.width()) << static_cast<qint32>(ori.height()) << static_cast<quint32>(data.size());
+    out.writeRawData(data.constData(), static_cast<int>(data.size()));
+
+    if (out.status() != QDataStream::Ok)
+    {
+        MSG_ERROR("Couldn't write a thumbnail to the store: " << mFile.errorString().toStdString());
+        mFile.resize(start);
+        return;
+    }
+
+    RECORD_t rec;
+    rec.offset = mFile.pos() - data.size();
+    rec.length = static_cast<quint32>(data.size());
+    rec.original = ori;
+    mIndex.insert(key, rec);
+}
+
+/**
+ * @brief TThumbnailStore::writeFileRecord
+ * Appends the hash of a file to the container file. The mutex must be
+ * locked.
+ *
+ * @param fileKey   The path, size and time of the last change of the file.
+ * @param hash      The hash of the content and the size of the image.
+ */
+void TThumbnailStore::writeFileRecord(const QString& fileKey, const HASH_t& hash)
+{
+    DECL_TRACER("TThumbnailStore::writeFileRecord(const QString& fileKey, const HASH_t& hash)");
+
+    if (!open() || mReadOnly || hash.hash.size() != 16)
+        return;
+
+    if (mFile.size() + fileKey.size() * 2 + 32 > STORE_MAX_SIZE)
+    {
+        MSG_INFO("Thumbnail store is full. It is created anew.");
+
+        if (!reset())
+            return;
+    }
+
+    qint64 start = mFile.size();
+    mFile.seek(start);
+    QDataStream out(&mFile);
+    out << static_cast<quint32>(FILE_MAGIC) << fileKey;
+    out.writeRawData(hash.hash.constData(), 16);
+    out << static_cast<qint32>(hash.original.width()) << static_cast<qint32>(hash.original.height());
+
+    if (out.status() != QDataStream::Ok)
+    {
+        MSG_ERROR("Couldn't write a file hash to the store: " << mFile.errorString().toStdString());
+        mFile.resize(start);
+    }
+}
+
+/**
+ * @brief TThumbnailStore::getBucket
+ * Returns the smallest bucket @b size fits into. The buckets are powers
+ * of 2 starting with 32 pixels.
+ */
+int TThumbnailStore::getBucket(const QSize& size)
+{
+    DECL_TRACER("TThumbnailStore::getBucket(const QSize& size)");
+
+    int max = qMax(size.width(), size.height());
+    int bucket = 32;
+
+    while (bucket < max)
+        bucket *= 2;
+
+    return bucket;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#ifndef TTHUMBNAILSTORE_H
+#define TTHUMBNAILSTORE_H
+
+#include <QHash>
+#include <QByteArray>
+#include <QString>
+#include <QImage>
+#include <QSize>
+#include <QFile>
+#include <QLockFile>
+#include <QMutex>
+
+/**
+ * @brief The TThumbnailStore class
+ * A persistent store of small images, used for the icons in the lists of
+ * images. The thumbnails survive the session and are shared between all
+ * projects.
+ *
+ * A thumbnail is found by the hash of the content of the image file and a
+ * size bucket. Therefore a renamed or copied file, or the same image in
+ * another project, finds its thumbnail again. The thumbnail is stored in
+ * the smallest bucket the requested size fits into and scaled down to the
+ * requested size when it is read.
+ *
+ * All thumbnails are stored in one container file in the cache directory
+ * of the user. New thumbnails are appended. The index is built once by
+ * reading only the headers of the records. If the file becomes larger
+ * than the limit, it is started anew.
+ *
+ * The hash of a file is stored too, together with the path, the size and
+ * the time of the last change of the file. As long as none of them
+ * changes, the file is not read again to find its thumbnail. The hashes
+ * of files which were changed or deleted are removed when the container
+ * file is opened.
+ *
+ * Only one instance of the program can write to the container file. This
+ * is ensured by a lock file. Another instance opens the container file
+ * read only and doesn't store new thumbnails.
+ *
+ * All methods are protected by a mutex and can be used from any thread.
+ */
+class TThumbnailStore
+{
+    public:
+        static TThumbnailStore& Current();
+
+        QImage getImage(const QString& file, const QSize& size, QSize *ori=nullptr);
+        void clear();
+        void logStatistics();
+
+    private:
+        TThumbnailStore();
+        ~TThumbnailStore();
+
+        typedef struct RECORD_t
+        {
+            qint64 offset{0};       // The position of the image data in the file
+            quint32 length{0};      // The length of the image data
+            QSize original;         // The size of the original image
+        }RECORD_t;
+
+        typedef struct HASH_t
+        {
+            QByteArray hash;        // The hash of the content of the file
+            QSize original;         // The size of the original image
+        }HASH_t;
+
+        bool open();
+        bool readIndex();
+        bool compact();
+        bool reset();
+        bool readRecord(const QByteArray& key, QByteArray *data, QSize *ori);
+        void writeRecord(const QByteArray& key, const QImage& image, const QSize& ori);
+        void writeFileRecord(const QString& fileKey, const HASH_t& hash);
+        static bool isLive(const QString& fileKey);
+        static int getBucket(const QSize& size);
+
+        QString mFileName;                          // The container file
+        QFile mFile;                                // The opened container file
+        QLockFile mLock;                            // Lock of the container file
+        bool mOpened{false};                        // TRUE = open() was called
+        bool mReadOnly{false};                      // TRUE = Another instance has the lock
+        QHash<QByteArray, RECORD_t> mIndex;         // Hash and bucket -> record
+        QHash<QString, HASH_t> mHashes;             // File, size and time -> hash
+        qsizetype mFileRecords{0};                  // The records of file hashes read by readIndex()
+        QMutex mMutex;
+        qsizetype mHits{0};
+        qsizetype mMisses{0};
+};
+
+#endif // TTHUMBNAILSTORE_H
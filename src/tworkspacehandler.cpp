@@ -162,6 +162,7 @@ void TWorkSpaceHandler::setPage(const QString& name)
     DECL_TRACER("TWorkSpaceHandler::setPage(const QString& name)");
 
     Page::PAGE_t *page = TPageHandler::Current().getPage(name);
+    TPageHandler::Current().ensureLoaded(page);
     setPage(page->pageID, false, page);
 }
 
@@ -174,6 +175,8 @@ void TWorkSpaceHandler::setPage(int id, bool load, Page::PAGE_t *rpage)
     if (load)
         page = TPageHandler::Current().getPage(id);
 
+    TPageHandler::Current().ensureLoaded(page);
+
     if (!page)
         return;
 
@@ -214,6 +217,7 @@ void TWorkSpaceHandler::setPopup(const QString& name)
     DECL_TRACER("TWorkSpaceHandler::setPopup(const QString& name)");
 
     Page::PAGE_t *page = TPageHandler::Current().getPage(name);
+    TPageHandler::Current().ensureLoaded(page);
 
     if (!page)
         return;
@@ -230,6 +234,8 @@ void TWorkSpaceHandler::setPopup(int id, bool load, Page::PAGE_t *rpage)
     if (load)
         page = TPageHandler::Current().getPage(id);
 
+    TPageHandler::Current().ensureLoaded(page);
+
     if (!page)
         return;
 
@@ -337,6 +343,7 @@ void TWorkSpaceHandler::saveChangedData(Page::PAGE_t *page, PROPERTIES_t prop)
         return;
 
     Page::PAGE_t *pg = TPageHandler::Current().getPage(page->pageID);
+    TPageHandler::Current().ensureLoaded(pg);
 
     switch(prop)
     {
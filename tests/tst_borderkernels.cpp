@@ -0,0 +1,687 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <QTest>
+#include <QImage>
+#include <QPainter>
+#include <QFile>
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <vector>
+
+#include "tpixelkernels.h"
+
+/**
+ * @brief borderFamilies
+ * The base names of all border families defined in
+ * TGraphics::initBorderData(). A new family must be added here too.
+ */
+static const char *const borderFamilies[] = {
+    "sbSquaredLarge", "sbSquaredMed", "sbSquaredSmall", "newsHeader", "newsHeaderRight",
+    "newsHeaderLeft", "aqua", "aquaSmall", "aquaMed", "aquaLarge", "MenuVerticalRounded",
+    "MenuHorizontalRounded", "Line1", "Line2", "Line4", "PF", "circle15", "circle25", "circle35",
+    "circle45", "circle55", "circle65", "circle75", "circle85", "circle95", "circle105",
+    "circle115", "circle125", "circle135", "circle145", "circle155", "circle165", "circle175",
+    "circle185", "circle195", "HOval60x30", "HOval100x50", "HOval150x75", "HOval200x100",
+    "VOval30x60", "VOval50x100", "VOval75x150", "VOval100x200", "diamond15", "diamond25",
+    "diamond35", "diamond45", "diamond55", "diamond65", "diamond75", "diamond85", "diamond95",
+    "diamond105", "diamond115", "diamond125", "diamond135", "diamond145", "diamond155",
+    "diamond165", "diamond175", "diamond185", "diamond195", "AMXeliteL-off", "AMXeliteL-on",
+    "AMXeliteM-off", "AMXeliteM-on", "AMXeliteS-off", "AMXeliteS-on", "bevelL-off", "bevelL-on",
+    "bevelM-off", "bevelM-on", "bevel-off", "bevel-on", "dbevelL-off", "dbevelL-on", "dbevelM-off",
+    "dbevelM-on", "dbevelS-off", "dbevelS-on", "pipe100", "pipe50", "neon150-f", "neon150-n",
+    "neon75-f", "neon75-n", "Glow50", "Glow25", "fuzzyBorder", "top_cursor", "bottom_cursor",
+    "left_cursor", "right_cursor", "CustomFrame", "cursorHoleDown", "cursorHoleUp",
+    "cursorHoleRight", "cursorHoleLeft", "WindowsPopupStatus", "WindowsPopup", "HelpDown",
+    "HelpDown2", "leftMenuRounded15", "leftMenuRounded25", "leftMenuRounded35", "leftMenuRounded45",
+    "leftMenuRounded55", "leftMenuRounded65", "leftMenuRounded75", "leftMenuRounded85",
+    "leftMenuRounded95", "leftMenuRounded105", "leftMenuRounded115", "leftMenuRounded125",
+    "leftMenuRounded135", "leftMenuRounded145", "leftMenuRounded155", "leftMenuRounded165",
+    "leftMenuRounded175", "leftMenuRounded185", "leftMenuRounded195", "rightMenuRounded15",
+    "rightMenuRounded25", "rightMenuRounded35", "rightMenuRounded45", "rightMenuRounded55",
+    "rightMenuRounded65", "rightMenuRounded75", "rightMenuRounded85", "rightMenuRounded95",
+    "rightMenuRounded105", "rightMenuRounded115", "rightMenuRounded125", "rightMenuRounded135",
+    "rightMenuRounded145", "rightMenuRounded155", "rightMenuRounded165", "rightMenuRounded175",
+    "rightMenuRounded185", "rightMenuRounded195", "topMenuRounded15", "topMenuRounded25",
+    "topMenuRounded35", "topMenuRounded45", "topMenuRounded55", "topMenuRounded65",
+    "topMenuRounded75", "topMenuRounded85", "topMenuRounded95", "topMenuRounded105",
+    "topMenuRounded115", "topMenuRounded125", "topMenuRounded135", "topMenuRounded145",
+    "topMenuRounded155", "topMenuRounded165", "topMenuRounded175", "topMenuRounded185",
+    "topMenuRounded195", "bottomMenuRounded15", "bottomMenuRounded25", "bottomMenuRounded35",
+    "bottomMenuRounded45", "bottomMenuRounded55", "bottomMenuRounded65", "bottomMenuRounded75",
+    "bottomMenuRounded85", "bottomMenuRounded95", "bottomMenuRounded105", "bottomMenuRounded115",
+    "bottomMenuRounded125", "bottomMenuRounded135", "bottomMenuRounded145", "bottomMenuRounded155",
+    "bottomMenuRounded165", "bottomMenuRounded175", "bottomMenuRounded185", "bottomMenuRounded195"
+};
+
+/**
+ * @brief The TestBorderKernels class
+ * Runs the kernels used to draw borders over the images of every border
+ * family. The images are taken from the directory the resource file
+ * borders.qrc is made of.
+ *
+ * The fragments and the erase masks are compared with the way they were
+ * calculated pixel by pixel with QImage::pixelColor() and
+ * QImage::setPixelColor() before. The benchmarks measure complete borders
+ * at typical button sizes, drawn the new and the old way.
+ *
+ * TDrawBorder can't be linked without most of the application. Therefore
+ * the steps of TDrawBorder::drawBorder() around the kernels are repeated
+ * here with images instead of pixmaps.
+ */
+class TestBorderKernels : public QObject
+{
+    Q_OBJECT
+
+    private slots:
+        void initTestCase();
+        void kernels_data() { families(); }
+        void kernels();
+        void fragments_data() { families(); }
+        void fragments();
+        void eraseMask_data() { sizes(); }
+        void eraseMask();
+        void benchmarkColorize_data() { families(); }
+        void benchmarkColorize();
+        void benchmarkUnderlay_data() { families(); }
+        void benchmarkUnderlay();
+        void benchmarkOpaque_data() { families(); }
+        void benchmarkOpaque();
+        void benchmarkBorder_data() { sizes(); }
+        void benchmarkBorder();
+        void benchmarkBorderPerPixel_data() { sizes(); }
+        void benchmarkBorderPerPixel();
+
+    private:
+        void families();
+        void sizes();
+        QList<QImage> loadFamily(const QString& base, bool alpha);
+        QString fileName(const QString& base, const QString& part, bool alpha);
+        QImage getFragment(const QString& base, const QString& part, const QColor& color, bool perPixel);
+        bool drawFrame(const QString& base, const QSize& size, const QColor& color, bool perPixel, QImage *frame, QRect *clip);
+        QImage drawBorder(const QString& base, const QSize& size, bool perPixel);
+        static QImage fragmentPerPixel(const QString& path, const QString& pathAlpha, QColor color);
+        static void erasePerPixel(QImage *img, const QImage& mask, const QRect& clip);
+        static void erase(QImage *img, const QImage& frame, const QRect& clip);
+        static int maxDifference(const QImage& img1, const QImage& img2);
+
+        const QString mDir{BORDER_DIR};
+        QStringList mFamilies;
+        const QStringList mParts{ "t", "b", "l", "r", "tl", "tr", "bl", "br" };
+        const QRgb mColor{qRgba(0x20, 0x80, 0xc0, 0xff)};
+        const QRgb mFill{qRgba(0x97, 0xbe, 0x0d, 0xff)};
+};
+
+void TestBorderKernels::initTestCase()
+{
+    for (const char *base : borderFamilies)
+    {
+        mFamilies.append(QString::fromLatin1(base));
+
+        for (const QString& part : mParts)
+        {
+            if (fileName(base, part, false).isEmpty() && fileName(base, part, true).isEmpty())
+                QFAIL(qPrintable(QString("Fragment %1 of border %2 is missing!").arg(part, base)));
+        }
+    }
+}
+
+void TestBorderKernels::families()
+{
+    QTest::addColumn<QString>("base");
+
+    for (const QString& base : std::as_const(mFamilies))
+        QTest::newRow(qPrintable(base)) << base;
+}
+
+void TestBorderKernels::sizes()
+{
+    QTest::addColumn<QString>("base");
+    QTest::addColumn<QSize>("size");
+
+    // The sizes of typical buttons
+    const QList<QSize> sizes{ QSize(80, 40), QSize(150, 75), QSize(300, 150) };
+
+    for (const QString& base : std::as_const(mFamilies))
+    {
+        for (const QSize& size : sizes)
+            QTest::addRow("%s %dx%d", qPrintable(base), size.width(), size.height()) << base << size;
+    }
+}
+
+QList<QImage> TestBorderKernels::loadFamily(const QString& base, bool alpha)
+{
+    QList<QImage> images;
+
+    for (const QString& part : mParts)
+    {
+        QImage img(QString("%1/%2_%3%4.png").arg(mDir, base, part, alpha ? QString("_alpha") : QString()));
+
+        if (!img.isNull())
+            images.append(img.convertToFormat(QImage::Format_ARGB32));
+    }
+
+    return images;
+}
+
+/**
+ * @brief TestBorderKernels::fileName
+ * Returns the path of a fragment image like TGraphics::getBorder() does.
+ * If there is only one image, it is the base image or the alpha mask.
+ *
+ * @param base  The base name of the family.
+ * @param part  The part of the border.
+ * @param alpha TRUE = the alpha mask is wanted.
+ * @return The path or an empty string if there is no such image.
+ */
+QString TestBorderKernels::fileName(const QString& base, const QString& part, bool alpha)
+{
+    QString file = QString("%1/%2_%3%4.png").arg(mDir, base, part, alpha ? QString("_alpha") : QString());
+    return QFile::exists(file) ? file : QString();
+}
+
+QImage TestBorderKernels::getFragment(const QString& base, const QString& part, const QColor& color, bool perPixel)
+{
+    const QString path = fileName(base, part, false);
+    const QString pathAlpha = fileName(base, part, true);
+
+    if (perPixel)
+        return fragmentPerPixel(path, pathAlpha, color);
+
+    // The same steps as TDrawBorder::getBorderFragment()
+    QImage image;
+    bool haveBaseImage = false;
+
+    if (!path.isEmpty() && image.load(path))
+    {
+        haveBaseImage = true;
+        image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+        if (pathAlpha.isEmpty())
+        {
+            QPainter painter(&image);
+            painter.drawImage(QPoint(0, 0), TPixelKernels::underlay(image, color.rgba()));
+            painter.end();
+        }
+    }
+
+    QImage bm;
+
+    if (pathAlpha.isEmpty() || !bm.load(pathAlpha))
+        return haveBaseImage ? image : QImage();
+
+    bm = bm.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    if (!haveBaseImage)
+    {
+        image = QImage(bm.size(), QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+    }
+
+    QPainter painter(&image);
+    painter.drawImage(0, 0, image.size() == bm.size() ? TPixelKernels::colorize(bm, color.rgba()) : bm);
+    painter.end();
+    return image;
+}
+
+/**
+ * @brief TestBorderKernels::fragmentPerPixel
+ * This is TDrawBorder::getBorderFragment() as it was before the kernels
+ * were used.
+ */
+QImage TestBorderKernels::fragmentPerPixel(const QString& path, const QString& pathAlpha, QColor color)
+{
+    QImage image;
+    QImage img;
+    bool haveBaseImage = false;
+    QColor swCol = color;
+
+    if (!path.isEmpty() && image.load(path))
+    {
+        haveBaseImage = true;
+        image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        img = image;
+
+        if (pathAlpha.isEmpty())
+        {
+            QImage b(image.width(), image.height(), QImage::Format_ARGB32);
+            b.fill(Qt::transparent);
+
+            for (int x = 0; x < image.width(); ++x)
+            {
+                for (int y = 0; y < image.height(); ++y)
+                {
+                    int alpha = img.pixelColor(x, y).alpha();
+                    QColor pix(Qt::transparent);
+
+                    if (alpha == 0)
+                        pix = swCol;
+
+                    b.setPixelColor(x, y, pix);
+                }
+            }
+
+            QPainter painter(&image);
+            painter.drawImage(QPoint(0, 0), b);
+            painter.end();
+        }
+    }
+
+    QImage bm;
+
+    if (pathAlpha.isEmpty() || !bm.load(pathAlpha))
+        return haveBaseImage ? image : QImage();
+
+    bm = bm.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    if (!haveBaseImage)
+    {
+        image = QImage(bm.size(), QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+    }
+
+    img = bm;
+
+    if (image.size() == bm.size())
+    {
+        for (int y = 0; y < image.height(); ++y)
+        {
+            for (int x = 0; x < image.width(); ++x)
+            {
+                uint alpha = img.pixelColor(x, y).alpha();
+                QColor pix;
+
+                if (alpha == 0)
+                    pix = Qt::transparent;
+                else
+                {
+                    swCol.setAlpha(alpha);
+                    pix = swCol;
+                }
+
+                img.setPixelColor(x, y, pix);
+            }
+        }
+    }
+
+    QPainter painter(&image);
+    painter.drawImage(0, 0, img);
+    painter.end();
+    return image;
+}
+
+/**
+ * @brief TestBorderKernels::erasePerPixel
+ * This is TDrawBorder::erasePart() as it was before the kernels were
+ * used.
+ */
+void TestBorderKernels::erasePerPixel(QImage *img, const QImage& mask, const QRect& clip)
+{
+    const int width = img->width();
+    const int height = img->height();
+
+    auto setPixel = [img](const QColor& col, int x, int y)
+    {
+        if (col.alpha() <= 0)
+        {
+            img->setPixelColor(x, y, Qt::transparent);
+            return false;
+        }
+
+        return true;
+    };
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)         // from left
+        {
+            if (clip.contains(x, y) || setPixel(mask.pixelColor(x, y), x, y))
+                break;
+        }
+
+        for (int x = width - 1; x > 0; --x)     // from right
+        {
+            if (clip.contains(x, y) || setPixel(mask.pixelColor(x, y), x, y))
+                break;
+        }
+    }
+
+    for (int x = 0; x < width; ++x)
+    {
+        for (int y = 0; y < height; ++y)        // from top
+        {
+            if (clip.contains(x, y) || setPixel(mask.pixelColor(x, y), x, y))
+                break;
+        }
+
+        for (int y = height - 1; y > 0; --y)    // from bottom
+        {
+            if (clip.contains(x, y) || setPixel(mask.pixelColor(x, y), x, y))
+                break;
+        }
+    }
+}
+
+/**
+ * @brief TestBorderKernels::erase
+ * The same as TDrawBorder::getEraseMask() followed by
+ * TDrawBorder::erasePart().
+ */
+void TestBorderKernels::erase(QImage *img, const QImage& frame, const QRect& clip)
+{
+    QPainter painter(img);
+    painter.setCompositionMode(QPainter::CompositionMode_DestinationOut);
+    painter.drawImage(0, 0, TPixelKernels::eraseMask(frame, clip));
+    painter.end();
+}
+
+/**
+ * @brief TestBorderKernels::drawFrame
+ * Draws the frame of a border like TDrawBorder::drawBorder() does.
+ *
+ * @return FALSE if a fragment is missing or the border doesn't fit into
+ * the size.
+ */
+bool TestBorderKernels::drawFrame(const QString& base, const QSize& size, const QColor& color, bool perPixel, QImage *frame, QRect *clip)
+{
+    QImage imgB = getFragment(base, "b", color, perPixel);
+    QImage imgBR = getFragment(base, "br", color, perPixel);
+    QImage imgR = getFragment(base, "r", color, perPixel);
+    QImage imgTR = getFragment(base, "tr", color, perPixel);
+    QImage imgT = getFragment(base, "t", color, perPixel);
+    QImage imgTL = getFragment(base, "tl", color, perPixel);
+    QImage imgL = getFragment(base, "l", color, perPixel);
+    QImage imgBL = getFragment(base, "bl", color, perPixel);
+
+    if (imgB.isNull() || imgBR.isNull() || imgR.isNull() || imgTR.isNull() ||
+        imgT.isNull() || imgTL.isNull() || imgL.isNull() || imgBL.isNull())
+        return false;
+
+    const int wt = size.width();
+    const int ht = size.height();
+
+    if (wt - imgBL.width() - imgBR.width() <= 0 || wt - imgTL.width() - imgTR.width() <= 0 ||
+        ht - imgTL.height() - imgBL.height() <= 0 || ht - imgTR.height() - imgBR.height() <= 0)
+        return false;
+
+    imgB = imgB.scaled(wt - imgBL.width() - imgBR.width(), imgB.height());
+    imgT = imgT.scaled(wt - imgTL.width() - imgTR.width(), imgT.height());
+    imgL = imgL.scaled(imgL.width(), ht - imgTL.height() - imgBL.height());
+    imgR = imgR.scaled(imgR.width(), ht - imgTR.height() - imgBR.height());
+
+    *frame = QImage(size, QImage::Format_ARGB32_Premultiplied);
+    frame->fill(Qt::transparent);
+    QPainter canvas(frame);
+    canvas.drawImage(imgBL.width(), ht - imgB.height(), imgB);
+    canvas.drawImage(imgTL.width(), 0, imgT);
+    canvas.drawImage(wt - imgBR.width(), ht - imgBR.height(), imgBR);
+    canvas.drawImage(wt - imgTR.width(), 0, imgTR);
+    canvas.drawImage(0, 0, imgTL);
+    canvas.drawImage(0, ht - imgBL.height(), imgBL);
+    canvas.drawImage(0, imgTL.height(), imgL);
+    canvas.drawImage(wt - imgR.width(), imgTR.height(), imgR);
+    canvas.end();
+
+    *clip = QRect(imgL.width() > 0 ? imgTL.width() : 0, imgT.height() > 0 ? imgTL.height() : 0,
+                  wt - imgTL.width() - imgTR.width(), ht - imgTL.height() - imgTR.height());
+    return true;
+}
+
+/**
+ * @brief TestBorderKernels::drawBorder
+ * Draws a complete border over a filled button.
+ *
+ * @return The button or a null image if the border doesn't fit.
+ */
+QImage TestBorderKernels::drawBorder(const QString& base, const QSize& size, bool perPixel)
+{
+    QImage frame;
+    QRect clip;
+
+    if (!drawFrame(base, size, QColor::fromRgba(mColor), perPixel, &frame, &clip))
+        return QImage();
+
+    QImage button(size, QImage::Format_ARGB32_Premultiplied);
+    button.fill(mFill);
+
+    if (perPixel)
+        erasePerPixel(&button, frame, clip);
+    else
+        erase(&button, frame, clip);
+
+    QPainter painter(&button);
+    painter.drawImage(0, 0, frame);
+    painter.end();
+    return button;
+}
+
+int TestBorderKernels::maxDifference(const QImage& img1, const QImage& img2)
+{
+    if (img1.size() != img2.size())
+        return INT_MAX;
+
+    // Compared premultiplied, so the color of invisible pixels doesn't matter
+    QImage a = img1.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    QImage b = img2.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    int diff = 0;
+
+    for (int y = 0; y < a.height(); ++y)
+    {
+        const QRgb *la = reinterpret_cast<const QRgb *>(a.constScanLine(y));
+        const QRgb *lb = reinterpret_cast<const QRgb *>(b.constScanLine(y));
+
+        for (int x = 0; x < a.width(); ++x)
+        {
+            diff = std::max(diff, std::abs(qAlpha(la[x]) - qAlpha(lb[x])));
+            diff = std::max(diff, std::abs(qRed(la[x]) - qRed(lb[x])));
+            diff = std::max(diff, std::abs(qGreen(la[x]) - qGreen(lb[x])));
+            diff = std::max(diff, std::abs(qBlue(la[x]) - qBlue(lb[x])));
+        }
+    }
+
+    return diff;
+}
+
+void TestBorderKernels::kernels()
+{
+    QFETCH(QString, base);
+
+    const QRgb rgb = mColor & 0x00ffffff;
+    QList<QImage> images = loadFamily(base, false) + loadFamily(base, true);
+
+    for (const QImage& img : images)
+    {
+        QImage colorized = img.copy();
+        QImage underlay(img.size(), QImage::Format_ARGB32);
+
+        for (int y = 0; y < img.height(); ++y)
+        {
+            const QRgb *src = reinterpret_cast<const QRgb *>(img.constScanLine(y));
+            const int width = img.width();
+            TPixelKernels::colorizeRow(reinterpret_cast<QRgb *>(colorized.scanLine(y)), width, mColor);
+            TPixelKernels::underlayRow(src, reinterpret_cast<QRgb *>(underlay.scanLine(y)), width, mColor);
+            int first = width;
+            int last = -1;
+
+            for (int x = 0; x < width; ++x)
+            {
+                const QRgb a = src[x] & 0xff000000;
+                QCOMPARE(colorized.pixel(x, y), a ? (a | rgb) : 0);
+                QCOMPARE(underlay.pixel(x, y), a ? 0 : mColor);
+
+                if (a)
+                {
+                    first = std::min(first, x);
+                    last = x;
+                }
+            }
+
+            QCOMPARE(TPixelKernels::firstOpaque(src, width), first);
+            QCOMPARE(TPixelKernels::lastOpaque(src, width), last);
+        }
+    }
+}
+
+void TestBorderKernels::fragments()
+{
+    QFETCH(QString, base);
+
+    // A color with less than full alpha shows differences in the alpha
+    // handling too.
+    for (const QColor& color : { QColor::fromRgba(mColor), QColor(0xff, 0x40, 0x10, 0x80) })
+    {
+        for (const QString& part : mParts)
+        {
+            QImage kernel = getFragment(base, part, color, false);
+            QImage perPixel = getFragment(base, part, color, true);
+            QVERIFY(!kernel.isNull());
+            // QImage::setPixelColor() and QPainter premultiply a color
+            // with a different rounding.
+            QVERIFY2(maxDifference(kernel, perPixel) <= 1, qPrintable(QString("Fragment %1 differs!").arg(part)));
+        }
+    }
+}
+
+void TestBorderKernels::eraseMask()
+{
+    QFETCH(QString, base);
+    QFETCH(QSize, size);
+
+    QImage frame;
+    QRect clip;
+
+    if (!drawFrame(base, size, QColor::fromRgba(mColor), false, &frame, &clip))
+        QSKIP("The border doesn't fit into the button.");
+
+    QImage mask = TPixelKernels::eraseMask(frame, clip);
+    QCOMPARE(mask.size(), size);
+
+    // Nothing inside of the clip region or under the frame is erased
+    for (int y = 0; y < size.height(); ++y)
+    {
+        for (int x = 0; x < size.width(); ++x)
+        {
+            if (clip.contains(x, y) || qAlpha(frame.pixel(x, y)) > 0)
+                QCOMPARE(qAlpha(mask.pixel(x, y)), 0);
+        }
+    }
+
+    QImage kernel(size, QImage::Format_ARGB32_Premultiplied);
+    kernel.fill(mFill);
+    QImage perPixel = kernel.copy();
+    erase(&kernel, frame, clip);
+    erasePerPixel(&perPixel, frame, clip);
+    QCOMPARE(kernel, perPixel);
+}
+
+void TestBorderKernels::benchmarkColorize()
+{
+    QFETCH(QString, base);
+
+    QList<QImage> images = loadFamily(base, true);
+
+    if (images.isEmpty())
+        images = loadFamily(base, false);
+
+    QBENCHMARK {
+        for (QImage& img : images)
+        {
+            for (int y = 0; y < img.height(); ++y)
+                TPixelKernels::colorizeRow(reinterpret_cast<QRgb *>(img.scanLine(y)), img.width(), mColor);
+        }
+    }
+}
+
+void TestBorderKernels::benchmarkUnderlay()
+{
+    QFETCH(QString, base);
+
+    QList<QImage> images = loadFamily(base, false);
+    std::vector<QRgb> line;
+
+    QBENCHMARK {
+        for (const QImage& img : images)
+        {
+            line.resize(static_cast<size_t>(img.width()));
+
+            for (int y = 0; y < img.height(); ++y)
+                TPixelKernels::underlayRow(reinterpret_cast<const QRgb *>(img.constScanLine(y)), line.data(), img.width(), mColor);
+        }
+    }
+}
+
+void TestBorderKernels::benchmarkOpaque()
+{
+    QFETCH(QString, base);
+
+    QList<QImage> images = loadFamily(base, true) + loadFamily(base, false);
+    int sum = 0;
+
+    QBENCHMARK {
+        for (const QImage& img : images)
+        {
+            for (int y = 0; y < img.height(); ++y)
+            {
+                const QRgb *line = reinterpret_cast<const QRgb *>(img.constScanLine(y));
+                sum += TPixelKernels::firstOpaque(line, img.width());
+                sum += TPixelKernels::lastOpaque(line, img.width());
+            }
+        }
+    }
+
+    // Keeps the compiler from removing the calls
+    QVERIFY(sum != INT_MIN);
+}
+
+void TestBorderKernels::benchmarkBorder()
+{
+    QFETCH(QString, base);
+    QFETCH(QSize, size);
+
+    if (drawBorder(base, size, false).isNull())
+        QSKIP("The border doesn't fit into the button.");
+
+    QImage button;
+
+    QBENCHMARK {
+        button = drawBorder(base, size, false);
+    }
+
+    QCOMPARE(button.size(), size);
+}
+
+void TestBorderKernels::benchmarkBorderPerPixel()
+{
+    QFETCH(QString, base);
+    QFETCH(QSize, size);
+
+    if (drawBorder(base, size, true).isNull())
+        QSKIP("The border doesn't fit into the button.");
+
+    QImage button;
+
+    QBENCHMARK {
+        button = drawBorder(base, size, true);
+    }
+
+    QCOMPARE(button.size(), size);
+}
+
+QTEST_GUILESS_MAIN(TestBorderKernels)
+#include "tst_borderkernels.moc"
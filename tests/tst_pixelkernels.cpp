@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <QTest>
+#include <QImage>
+#include <QColor>
+#include <QRandomGenerator>
+
+#include <vector>
+
+#include "tpixelkernels.h"
+#include "tdrawimage.h"
+
+/**
+ * @brief The TestPixelKernels class
+ * Compares the chameleon kernels with TDrawImage::baseColor(), which is
+ * the way a chameleon image was calculated pixel by pixel before. The
+ * results must be exactly the same. The benchmarks measure the throughput
+ * of the kernels and of the old per pixel way.
+ */
+class TestPixelKernels : public QObject
+{
+    Q_OBJECT
+
+    private slots:
+        void chameleonRow_data();
+        void chameleonRow();
+        void chameleon_data();
+        void chameleon();
+        void benchmarkChameleon();
+        void benchmarkBaseColor();
+
+    private:
+        static QImage randomImage(int width, int height, quint32 seed);
+        static QRgb reference(QRgb red, QRgb mask, QRgb col1, QRgb col2);
+};
+
+QImage TestPixelKernels::randomImage(int width, int height, quint32 seed)
+{
+    QRandomGenerator gen(seed);
+    QImage img(width, height, QImage::Format_ARGB32);
+
+    for (int y = 0; y < height; ++y)
+    {
+        QRgb *line = reinterpret_cast<QRgb *>(img.scanLine(y));
+
+        for (int x = 0; x < width; ++x)
+        {
+            QRgb px = gen.generate();
+
+            // Make sure fully transparent pixels and pixels with red == 0
+            // or green == 0 are common enough.
+            switch (gen.bounded(4))
+            {
+                case 0: px &= 0x00ffffff; break;
+                case 1: px &= 0xff00ffff; break;
+                case 2: px &= 0xffff00ff; break;
+            }
+
+            line[x] = px;
+        }
+    }
+
+    return img;
+}
+
+QRgb TestPixelKernels::reference(QRgb red, QRgb mask, QRgb col1, QRgb col2)
+{
+    return TDrawImage::baseColor(QColor::fromRgba(red), QColor::fromRgba(mask), QColor::fromRgba(col1), QColor::fromRgba(col2)).rgba();
+}
+
+void TestPixelKernels::chameleonRow_data()
+{
+    QTest::addColumn<bool>("withMask");
+    QTest::addColumn<int>("alpha");
+
+    for (bool withMask : { false, true })
+    {
+        for (int alpha : { 0, 1, 128, 255 })
+            QTest::addRow("mask=%d alpha=%d", withMask, alpha) << withMask << alpha;
+    }
+}
+
+void TestPixelKernels::chameleonRow()
+{
+    QFETCH(bool, withMask);
+    QFETCH(int, alpha);
+
+    // Every combination of red and green with one alpha value. The line is
+    // one pixel longer than a multiple of 4 to run the scalar tail too.
+    const int count = 256 * 256 + 1;
+    const QRgb col1 = qRgba(0x12, 0x34, 0x56, 0xc8);
+    const QRgb col2 = qRgba(0xfe, 0xdc, 0xba, 0x40);
+    std::vector<QRgb> red(count), mask(count), dst(count);
+    QRandomGenerator gen(static_cast<quint32>(alpha));
+
+    for (int i = 0; i < count; ++i)
+    {
+        red[i] = qRgba((i >> 8) & 0xff, i & 0xff, gen.bounded(256), alpha);
+        mask[i] = gen.generate();
+    }
+
+    TPixelKernels::chameleonRow(red.data(), withMask ? mask.data() : nullptr, dst.data(), count, col1, col2);
+
+    for (int i = 0; i < count; ++i)
+    {
+        const QRgb expected = reference(red[i], withMask ? mask[i] : 0, col1, col2);
+
+        if (dst[i] != expected)
+            QFAIL(qPrintable(QString("Pixel %1 (0x%2): got 0x%3, expected 0x%4").arg(i).arg(red[i], 8, 16, QChar('0')).arg(dst[i], 8, 16, QChar('0')).arg(expected, 8, 16, QChar('0'))));
+    }
+}
+
+void TestPixelKernels::chameleon_data()
+{
+    QTest::addColumn<QSize>("redSize");
+    QTest::addColumn<QSize>("maskSize");
+    QTest::addColumn<QSize>("dstSize");
+
+    QTest::newRow("same size") << QSize(64, 32) << QSize(64, 32) << QSize(64, 32);
+    QTest::newRow("odd width") << QSize(37, 13) << QSize(37, 13) << QSize(37, 13);
+    QTest::newRow("no mask") << QSize(41, 11) << QSize() << QSize(41, 11);
+    QTest::newRow("mask wider") << QSize(23, 17) << QSize(45, 9) << QSize(50, 20);
+    QTest::newRow("mask narrower") << QSize(45, 9) << QSize(23, 17) << QSize(50, 20);
+    QTest::newRow("target smaller") << QSize(45, 30) << QSize(47, 31) << QSize(19, 7);
+}
+
+void TestPixelKernels::chameleon()
+{
+    QFETCH(QSize, redSize);
+    QFETCH(QSize, maskSize);
+    QFETCH(QSize, dstSize);
+
+    const QRgb col1 = qRgba(0xff, 0x00, 0x00, 0xff);
+    const QRgb col2 = qRgba(0x00, 0x80, 0xff, 0x7f);
+    QImage red = randomImage(redSize.width(), redSize.height(), 1);
+    QImage mask = maskSize.isValid() ? randomImage(maskSize.width(), maskSize.height(), 2) : QImage();
+    QImage dst(dstSize, QImage::Format_ARGB32);
+    dst.fill(0x5a5a5a5a);   // Must be overwritten completely
+
+    TPixelKernels::chameleon(red, mask, &dst, col1, col2);
+
+    for (int y = 0; y < dst.height(); ++y)
+    {
+        for (int x = 0; x < dst.width(); ++x)
+        {
+            const bool inRed = red.rect().contains(x, y);
+            const bool inMask = !mask.isNull() && mask.rect().contains(x, y);
+            const QRgb pixMask = inMask ? mask.pixel(x, y) : 0;
+            QRgb expected = 0;
+
+            if (inRed)
+                expected = reference(red.pixel(x, y), pixMask, col1, col2);
+            else if (inMask)
+                expected = pixMask;
+
+            if (dst.pixel(x, y) != expected)
+                QFAIL(qPrintable(QString("Pixel %1,%2: got 0x%3, expected 0x%4").arg(x).arg(y).arg(dst.pixel(x, y), 8, 16, QChar('0')).arg(expected, 8, 16, QChar('0'))));
+        }
+    }
+}
+
+void TestPixelKernels::benchmarkChameleon()
+{
+    QImage red = randomImage(1024, 768, 3);
+    QImage mask = randomImage(1024, 768, 4);
+    QImage dst(red.size(), QImage::Format_ARGB32);
+
+    QBENCHMARK {
+        TPixelKernels::chameleon(red, mask, &dst, 0xffff0000, 0xff0000ff);
+    }
+}
+
+void TestPixelKernels::benchmarkBaseColor()
+{
+    QImage red = randomImage(1024, 768, 3);
+    QImage mask = randomImage(1024, 768, 4);
+    QImage dst(red.size(), QImage::Format_ARGB32);
+    const QColor col1(Qt::red);
+    const QColor col2(Qt::blue);
+
+    QBENCHMARK {
+        for (int y = 0; y < red.height(); ++y)
+        {
+            for (int x = 0; x < red.width(); ++x)
+                dst.setPixelColor(x, y, TDrawImage::baseColor(red.pixelColor(x, y), mask.pixelColor(x, y), col1, col2));
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(TestPixelKernels)
+#include "tst_pixelkernels.moc"
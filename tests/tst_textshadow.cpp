@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026 by Andreas Theofilu <andreas@theosys.at>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+#include <QTest>
+#include <QImage>
+#include <QPixmap>
+#include <QPainter>
+#include <QGraphicsScene>
+#include <QGraphicsPixmapItem>
+#include <QGraphicsDropShadowEffect>
+
+#include <cstdlib>
+#include <algorithm>
+
+#include "tpixelkernels.h"
+
+/**
+ * @brief The TestTextShadow class
+ * Compares the glow and the drop shadow drawn by TTextRenderer with the
+ * QGraphicsDropShadowEffect used before. TTextRenderer blurs the alpha
+ * channel with TPixelKernels::blurAlpha() and a box radius calculated by
+ * TPixelKernels::boxRadius(). Both are tested here the same way.
+ *
+ * The source is a set of lines and a ring instead of a text. This way
+ * the result doesn't depend on the fonts installed. The shadow is opaque
+ * black, so the alpha channel contains all of the difference.
+ */
+class TestTextShadow : public QObject
+{
+    Q_OBJECT
+
+    private slots:
+        void compare_data();
+        void compare();
+
+    private:
+        static QImage source();
+        static QImage withEffect(const QImage& src, qreal blur, int offset);
+        static QImage withKernel(const QImage& src, qreal blur, int offset);
+};
+
+QImage TestTextShadow::source()
+{
+    QImage img(200, 100, QImage::Format_ARGB32_Premultiplied);
+    img.fill(Qt::transparent);
+    QPainter p(&img);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.fillRect(40, 25, 4, 50, Qt::white);
+    p.fillRect(50, 48, 40, 4, Qt::white);
+    p.fillRect(160, 30, 2, 40, Qt::white);
+    p.setPen(QPen(Qt::white, 4));
+    p.drawEllipse(QPoint(125, 50), 16, 16);
+    p.end();
+    return img;
+}
+
+QImage TestTextShadow::withEffect(const QImage& src, qreal blur, int offset)
+{
+    QGraphicsScene scene(QRectF(QPointF(0, 0), src.size()));
+    QGraphicsPixmapItem *item = scene.addPixmap(QPixmap::fromImage(src));
+    QGraphicsDropShadowEffect *shadow = new QGraphicsDropShadowEffect;
+    shadow->setColor(Qt::black);
+    shadow->setBlurRadius(blur);
+    shadow->setOffset(offset, offset);
+    item->setGraphicsEffect(shadow);
+
+    QImage result(src.size(), QImage::Format_ARGB32_Premultiplied);
+    result.fill(Qt::transparent);
+    QPainter p(&result);
+    scene.render(&p, QRectF(result.rect()), scene.sceneRect());
+    p.end();
+    return result;
+}
+
+QImage TestTextShadow::withKernel(const QImage& src, qreal blur, int offset)
+{
+    // The same steps as in TTextRenderer::draw()
+    QImage alpha = src.convertToFormat(QImage::Format_Alpha8);
+    int radius = TPixelKernels::boxRadius(blur);
+
+    if (radius > 0)
+        TPixelKernels::blurAlpha(&alpha, radius);
+
+    QImage shadow(src.size(), QImage::Format_ARGB32_Premultiplied);
+    shadow.fill(Qt::black);
+    QPainter ps(&shadow);
+    ps.setCompositionMode(QPainter::CompositionMode_DestinationIn);
+    ps.drawImage(0, 0, alpha);
+    ps.end();
+
+    QImage result(src.size(), QImage::Format_ARGB32_Premultiplied);
+    result.fill(Qt::transparent);
+    QPainter pr(&result);
+    pr.drawImage(offset, offset, shadow);
+    pr.drawImage(0, 0, src);
+    pr.end();
+    return result;
+}
+
+void TestTextShadow::compare_data()
+{
+    // The blur radius and offsets are those of TTextRenderer::getBlurRadius()
+    // and TTextRenderer::getShadowOffset().
+    QTest::addColumn<qreal>("blur");
+    QTest::addColumn<int>("offset");
+
+    QTest::newRow("Glow-S") << 4.0 << 0;
+    QTest::newRow("Glow-M") << 8.0 << 0;
+    QTest::newRow("Glow-L") << 12.0 << 0;
+    QTest::newRow("Glow-X") << 16.0 << 0;
+    QTest::newRow("Soft 3") << 15.0 << 3;
+    QTest::newRow("Medium 5") << 8.0 << 5;
+    QTest::newRow("Hard 2") << 0.0 << 2;
+}
+
+void TestTextShadow::compare()
+{
+    QFETCH(qreal, blur);
+    QFETCH(int, offset);
+
+    QImage src = source();
+    QImage expected = withEffect(src, blur, offset);
+    QImage actual = withKernel(src, blur, offset);
+    QCOMPARE(actual.size(), expected.size());
+
+    int maxDiff = 0;
+    qint64 sum = 0;
+
+    for (int y = 0; y < src.height(); ++y)
+    {
+        const QRgb *e = reinterpret_cast<const QRgb *>(expected.constScanLine(y));
+        const QRgb *a = reinterpret_cast<const QRgb *>(actual.constScanLine(y));
+
+        for (int x = 0; x < src.width(); ++x)
+        {
+            int diff = std::abs(qAlpha(e[x]) - qAlpha(a[x]));
+            maxDiff = std::max(maxDiff, diff);
+            sum += diff;
+        }
+    }
+
+    const double mean = static_cast<double>(sum) / (src.width() * src.height());
+    qInfo("Box radius %d: mean difference %.2f, maximum difference %d", TPixelKernels::boxRadius(blur), mean, maxDiff);
+
+    // A box blur can't match the exponential blur of Qt exactly. The
+    // shadow must have the same extent and about the same strength.
+    QVERIFY2(mean <= 5.0, qPrintable(QString("Mean difference %1 is too large").arg(mean)));
+    QVERIFY2(maxDiff <= 64, qPrintable(QString("Maximum difference %1 is too large").arg(maxDiff)));
+}
+
+QTEST_MAIN(TestTextShadow)
+#include "tst_textshadow.moc"